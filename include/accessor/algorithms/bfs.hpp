@@ -0,0 +1,177 @@
+#pragma once
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/frontier.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/iteration/frontier_vertices.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/frontier_traits.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Traversal direction selection for BFS
+enum class BFSDirection {
+    Auto,       ///< Switch between push and pull by frontier size
+    PushOnly,   ///< Top-down only
+    PullOnly    ///< Bottom-up only, including the first level
+};
+
+/// @brief Tuning knobs of direction-optimizing BFS (Beamer et al.)
+struct BFSOptions {
+    BFSDirection direction = BFSDirection::Auto;
+    double alpha = 15.0;    ///< Push->pull when frontier edges > unexplored edges / alpha
+    double beta = 18.0;     ///< Pull->push when frontier vertices < num_vertices / beta
+};
+
+struct BFSResult {
+    static constexpr size_t unreached = std::numeric_limits<size_t>::max();
+
+    std::vector<size_t> depth;  ///< Hop count from the source, or unreached
+    size_t num_levels = 0;
+    size_t push_steps = 0;
+    size_t pull_steps = 0;
+};
+
+namespace detail {
+
+inline size_t frontier_degree_sum(const CSRMatrix& graph, const Frontier& f) {
+    size_t sum = 0;
+    if (f.has_sparse()) {
+        const std::vector<size_t>& list = f.sparse().vertices;
+        const long long n = static_cast<long long>(list.size());
+        #pragma omp parallel for reduction(+:sum) schedule(static)
+        for (long long i = 0; i < n; ++i) {
+            size_t v = list[i];
+            sum += graph.row_ptr[v + 1] - graph.row_ptr[v];
+        }
+    } else {
+        const std::vector<uint64_t>& words = f.dense().words;
+        const long long num_words = static_cast<long long>(words.size());
+        #pragma omp parallel for reduction(+:sum) schedule(static)
+        for (long long w = 0; w < num_words; ++w) {
+            uint64_t bits = words[w];
+            while (bits != 0) {
+                size_t v = static_cast<size_t>(w) * DenseFrontier::bits_per_word + static_cast<size_t>(std::countr_zero(bits));
+                sum += graph.row_ptr[v + 1] - graph.row_ptr[v];
+                bits &= bits - 1;
+            }
+        }
+    }
+    return sum;
+}
+
+} // namespace detail
+
+/// @brief Direction-optimizing breadth-first search
+/// @param graph Adjacency of an undirected graph stored as a symmetric CSRMatrix
+/// @param source Start vertex
+/// @note Pull steps scan a vertex's row as its in-neighbours, which is only
+///       valid when the adjacency is symmetric.
+inline BFSResult direction_optimizing_bfs(const CSRMatrix& graph, size_t source, const BFSOptions& opts = {}) {
+    const size_t n = graph.num_rows();
+    BFSResult result;
+    result.depth.assign(n, BFSResult::unreached);
+    if (source >= n) {
+        return result;
+    }
+
+    DenseFrontier visited(n);
+    visited.insert(source);
+    result.depth[source] = 0;
+
+    Frontier current(n);
+    SparseFrontier seed(n);
+    seed.vertices.push_back(source);
+    current.assign(std::move(seed));
+
+    size_t edges_unexplored = graph.num_nonzeros();
+    size_t edges_frontier = graph.row_ptr[source + 1] - graph.row_ptr[source];
+    bool pulling = false;
+
+    using GraphAcc = Accessor<CSRMatrix, AccessMode::Read>;
+    using BitsRead = Accessor<DenseFrontier, AccessMode::Read>;
+    using BitsWrite = Accessor<DenseFrontier, AccessMode::Write>;
+    GraphAcc graph_acc(graph);
+
+    size_t level = 0;
+    while (!current.empty()) {
+        switch (opts.direction) {
+        case BFSDirection::PushOnly:
+            pulling = false;
+            break;
+        case BFSDirection::PullOnly:
+            pulling = true;
+            break;
+        case BFSDirection::Auto:
+            if (!pulling) {
+                pulling = static_cast<double>(edges_frontier) > static_cast<double>(edges_unexplored) / opts.alpha;
+            } else {
+                pulling = static_cast<double>(current.size()) >= static_cast<double>(n) / opts.beta;
+            }
+            break;
+        }
+
+        DenseFrontier next(n);
+        BitsRead visited_acc(visited);
+        BitsWrite next_acc(next);
+
+        if (pulling) {
+            current.ensure_dense();
+            BitsRead active_acc(current.dense());
+            custom_parallel_for(IterateOver::CSRRows(graph),
+                [](size_t v, const GraphAcc& g, const BitsRead& seen, const BitsRead& in_frontier, BitsWrite& out) {
+                    if (seen.get_value_by_id(v)) return;
+                    auto row = g.get_view(v, GetCSRRowViewTag{});
+                    for (size_t i = 0; i < row.num_non_zeros; ++i) {
+                        if (in_frontier.get_value_by_id(row.col_indices_ptr[i])) {
+                            out.set_value_by_id(v, true);
+                            return;
+                        }
+                    }
+                },
+                graph_acc, visited_acc, active_acc, next_acc);
+            ++result.pull_steps;
+        } else {
+            current.ensure_sparse();
+            custom_parallel_for(IterateOver::FrontierVertices(current.sparse()),
+                [](size_t v, const GraphAcc& g, const BitsRead& seen, BitsWrite& out) {
+                    auto row = g.get_view(v, GetCSRRowViewTag{});
+                    for (size_t i = 0; i < row.num_non_zeros; ++i) {
+                        size_t u = row.col_indices_ptr[i];
+                        if (!seen.get_value_by_id(u)) {
+                            out.set_value_by_id(u, true);
+                        }
+                    }
+                },
+                graph_acc, visited_acc, next_acc);
+            ++result.push_steps;
+        }
+
+        edges_unexplored -= std::min(edges_unexplored, edges_frontier);
+        current.assign(std::move(next));
+        ++level;
+
+        // Stamp depths and mark visited from whichever form adapt() chose
+        Accessor<std::vector<size_t>, AccessMode::Write> depth_acc(result.depth);
+        BitsWrite mark_acc(visited);
+        custom_parallel_for(IterateOver::FrontierVertices(current),
+            [level](size_t v, Accessor<std::vector<size_t>, AccessMode::Write>& depth, BitsWrite& mark) {
+                depth.set_value_by_id(v, level);
+                mark.set_value_by_id(v, true);
+            },
+            depth_acc, mark_acc);
+
+        edges_frontier = detail::frontier_degree_sum(graph, current);
+    }
+
+    result.num_levels = level;
+    return result;
+}
+
+} // namespace accessor
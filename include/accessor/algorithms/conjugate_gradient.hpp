@@ -0,0 +1,340 @@
+#pragma once
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/custom_parallel_reduce.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace accessor {
+
+enum class CGPreconditioner {
+    None,
+    Jacobi   ///< Inverse of the matrix diagonal
+};
+
+enum class CGVariant {
+    Standard,   ///< PCG: two sweeps and two reductions per iteration
+    Pipelined   ///< Ghysels-Vanroose pipelined PCG: two sweeps, one reduction
+                ///< (fused with the SpMV) per iteration, more vector traffic
+};
+
+struct CGOptions {
+    size_t max_iterations = 1000;
+    double tolerance = 1e-8;     ///< Stop once ||r|| <= tolerance * ||b||
+    CGPreconditioner preconditioner = CGPreconditioner::Jacobi;
+    CGVariant variant = CGVariant::Standard;
+    bool reproducible = false;   ///< Thread-count independent dot products (see reproducible_reduce)
+};
+
+struct CGResult {
+    size_t iterations = 0;
+    double relative_residual = 0;   ///< ||r|| / ||b|| of the recursively updated residual
+    bool converged = false;
+};
+
+namespace detail {
+
+/// Up to three dot products reduced in one sweep
+struct CGDots {
+    double a = 0, b = 0, c = 0;
+    CGDots operator+(const CGDots& o) const { return {a + o.a, b + o.b, c + o.c}; }
+};
+
+template<typename RowView, typename XAcc>
+auto row_dot(const RowView& row, const XAcc& x) {
+    typename XAcc::ValueType sum{};
+    for (size_t k = 0; k < row.num_non_zeros; ++k) {
+        sum += row.value(k) * x.get_value_by_id(row.col_indices_ptr[k]);
+    }
+    return sum;
+}
+
+} // namespace detail
+
+/// @brief Conjugate gradient solver for symmetric positive definite CSR matrices
+///
+/// All work vectors are allocated once, in the constructor, and reused by
+/// every solve(). Every iteration is two sweeps over the data:
+/// - Standard: the direction update p = u + beta p is folded into the SpMV
+///   (rows read the old p and write the new one into a second buffer, so no
+///   row sees a half-updated p), which also returns p.q; a second sweep
+///   updates x, r and the preconditioned residual u and returns r.u and r.r.
+/// - Pipelined: the recurrences of Ghysels and Vanroose (2014) let the only
+///   reduction of an iteration run in the same sweep as the SpMV, so the
+///   threads synchronize once per iteration instead of twice, at the price
+///   of reading and writing about twice as many vectors. This variant also
+///   accumulates more rounding error in the residual recurrence.
+/// The matrix must outlive the solver.
+/// @tparam StorageT Matrix storage type
+/// @tparam ComputeT Compute type of matrix and vectors
+template<typename StorageT, typename ComputeT>
+class ConjugateGradient {
+public:
+    using Matrix = CSRMatrixT<StorageT, ComputeT>;
+    using Vector = DenseArray1D<ComputeT>;
+
+    /// @throws std::invalid_argument with the Jacobi preconditioner if a
+    ///         diagonal entry is zero
+    explicit ConjugateGradient(const Matrix& a, const CGOptions& options = {})
+        : a_(a), options_(options), variant_(options.variant), n_(a.num_rows()),
+          inv_diag_(n_), r_(n_), u_(n_), p_(n_), p_next_(n_), q_(n_) {
+        if (variant_ == CGVariant::Pipelined) {
+            w_ = Vector(n_);
+            s_ = Vector(n_);
+            z_ = Vector(n_);
+            an_ = Vector(n_);
+        }
+        Accessor<Matrix, AccessMode::Read> mat(a_);
+        Accessor<Vector, AccessMode::Write> diag(inv_diag_);
+        const bool jacobi = options_.preconditioner == CGPreconditioner::Jacobi;
+        bool missing_diagonal = false;
+        custom_parallel_for(IterateOver::CSRRows(a_),
+            [jacobi, &missing_diagonal](size_t row, const auto& m, auto& d) {
+                if (!jacobi) {
+                    d.set_value_by_id(row, ComputeT(1));
+                    return;
+                }
+                auto view = m.get_view(row, GetCSRRowViewTag{});
+                ComputeT diagonal{};
+                for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                    if (view.col_indices_ptr[k] == row) diagonal += view.value(k);
+                }
+                if (diagonal == ComputeT{}) {
+                    #pragma omp atomic write
+                    missing_diagonal = true;
+                    return;
+                }
+                d.set_value_by_id(row, ComputeT(1) / diagonal);
+            },
+            mat, diag);
+        if (missing_diagonal) {
+            throw std::invalid_argument("ConjugateGradient: Jacobi preconditioner needs a nonzero diagonal");
+        }
+    }
+
+    /// @note The variant is fixed at construction (it decides which work
+    ///       vectors exist); tolerances and limits may change between solves.
+    const CGOptions& options() const { return options_; }
+    CGOptions& options() { return options_; }
+
+    /// @brief Solve A x = b starting from the initial guess in x
+    CGResult solve(const Vector& b, Vector& x) {
+        if (b.size() != n_ || x.size() != n_) {
+            throw std::invalid_argument("ConjugateGradient: vector sizes do not match the matrix");
+        }
+        return variant_ == CGVariant::Pipelined ? solve_pipelined(b, x) : solve_standard(b, x);
+    }
+
+private:
+    using ReadAcc = Accessor<Vector, AccessMode::Read>;
+    using WriteAcc = Accessor<Vector, AccessMode::Write>;
+    using ReadWriteAcc = Accessor<Vector, AccessMode::ReadWrite>;
+
+    ReduceOptions reduce_options() const {
+        return options_.reproducible ? reproducible_reduce() : ReduceOptions{};
+    }
+
+    /// r = b - A x, u = M r; returns (r.u, r.r, b.b)
+    detail::CGDots initial_residual(const Vector& b, const Vector& x) {
+        Accessor<Matrix, AccessMode::Read> mat(a_);
+        ReadAcc b_in(b), x_in(x), diag(inv_diag_);
+        WriteAcc r_out(r_), u_out(u_);
+        return custom_parallel_reduce(IterateOver::CSRRows(a_), reduce_options(),
+            [](size_t row, const auto& m, const auto& bv, const auto& xv, const auto& d, auto& r, auto& u) {
+                const ComputeT bi = bv.get_value_by_id(row);
+                const ComputeT ri = bi - detail::row_dot(m.get_view(row, GetCSRRowViewTag{}), xv);
+                const ComputeT ui = d.get_value_by_id(row) * ri;
+                r.set_value_by_id(row, ri);
+                u.set_value_by_id(row, ui);
+                return detail::CGDots{double(ri) * ui, double(ri) * ri, double(bi) * bi};
+            },
+            detail::CGDots{}, std::plus<>{}, mat, b_in, x_in, diag, r_out, u_out);
+    }
+
+    static bool zero_rhs(const detail::CGDots& init, Vector& x, CGResult& result) {
+        if (init.c != 0) return false;
+        std::fill(x.data.begin(), x.data.end(), ComputeT{});
+        result.converged = true;
+        return true;
+    }
+
+    CGResult solve_standard(const Vector& b, Vector& x) {
+        CGResult result;
+        const detail::CGDots init = initial_residual(b, x);
+        if (zero_rhs(init, x, result)) return result;
+
+        const double bnorm = std::sqrt(init.c);
+        double rz = init.a;
+        double rnorm = std::sqrt(init.b);
+        double beta = 0;
+        std::fill(p_.data.begin(), p_.data.end(), ComputeT{});
+
+        Accessor<Matrix, AccessMode::Read> mat(a_);
+        ReadAcc diag(inv_diag_);
+        while (rnorm > options_.tolerance * bnorm && result.iterations < options_.max_iterations) {
+            // p' = u + beta p; q = A p'; returns p'.q
+            const ComputeT beta_c = static_cast<ComputeT>(beta);
+            ReadAcc u_in(u_), p_in(p_);
+            WriteAcc p_out(p_next_), q_out(q_);
+            const double pq = custom_parallel_reduce(IterateOver::CSRRows(a_), reduce_options(),
+                [beta_c](size_t row, const auto& m, const auto& u, const auto& p, auto& p_new, auto& q) {
+                    auto view = m.get_view(row, GetCSRRowViewTag{});
+                    ComputeT qi{};
+                    for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                        const size_t col = view.col_indices_ptr[k];
+                        qi += view.value(k) * (u.get_value_by_id(col) + beta_c * p.get_value_by_id(col));
+                    }
+                    const ComputeT pi = u.get_value_by_id(row) + beta_c * p.get_value_by_id(row);
+                    p_new.set_value_by_id(row, pi);
+                    q.set_value_by_id(row, qi);
+                    return double(pi) * qi;
+                },
+                0.0, std::plus<>{}, mat, u_in, p_in, p_out, q_out);
+            std::swap(p_, p_next_);
+            if (!(pq > 0)) break;  // Not positive definite (or breakdown)
+
+            // x += alpha p; r -= alpha q; u = M r; returns (r.u, r.r)
+            const ComputeT alpha = static_cast<ComputeT>(rz / pq);
+            ReadAcc p_dir(p_), q_in(q_);
+            ReadWriteAcc x_io(x), r_io(r_);
+            WriteAcc u_out(u_);
+            const detail::CGDots dots = custom_parallel_reduce(IterateOver::Range1D(n_), reduce_options(),
+                [alpha](size_t i, const auto& d, const auto& p, const auto& q, auto& xv, auto& r, auto& u) {
+                    xv.set_value_by_id(i, xv.get_value_by_id(i) + alpha * p.get_value_by_id(i));
+                    const ComputeT ri = r.get_value_by_id(i) - alpha * q.get_value_by_id(i);
+                    const ComputeT ui = d.get_value_by_id(i) * ri;
+                    r.set_value_by_id(i, ri);
+                    u.set_value_by_id(i, ui);
+                    return detail::CGDots{double(ri) * ui, double(ri) * ri, 0.0};
+                },
+                detail::CGDots{}, std::plus<>{}, diag, p_dir, q_in, x_io, r_io, u_out);
+            beta = dots.a / rz;
+            rz = dots.a;
+            rnorm = std::sqrt(dots.b);
+            ++result.iterations;
+        }
+        result.relative_residual = rnorm / bnorm;
+        result.converged = rnorm <= options_.tolerance * bnorm;
+        return result;
+    }
+
+    CGResult solve_pipelined(const Vector& b, Vector& x) {
+        CGResult result;
+        const detail::CGDots init = initial_residual(b, x);
+        if (zero_rhs(init, x, result)) return result;
+        const double bnorm = std::sqrt(init.c);
+
+        Accessor<Matrix, AccessMode::Read> mat(a_);
+        ReadAcc diag(inv_diag_);
+        {
+            // w = A u; the direction recurrences start from zero
+            ReadAcc u_in(u_);
+            WriteAcc w_out(w_), p_out(p_), s_out(s_), q_out(q_), z_out(z_);
+            custom_parallel_for(IterateOver::CSRRows(a_),
+                [](size_t row, const auto& m, const auto& u, auto& w, auto& p, auto& s, auto& q, auto& z) {
+                    w.set_value_by_id(row, detail::row_dot(m.get_view(row, GetCSRRowViewTag{}), u));
+                    p.set_value_by_id(row, ComputeT{});
+                    s.set_value_by_id(row, ComputeT{});
+                    q.set_value_by_id(row, ComputeT{});
+                    z.set_value_by_id(row, ComputeT{});
+                },
+                mat, u_in, w_out, p_out, s_out, q_out, z_out);
+        }
+
+        double gamma_old = 0, alpha_old = 0, rnorm = std::sqrt(init.b);
+        while (true) {
+            // n = A M w, fused with gamma = r.u, delta = w.u, r.r
+            ReadAcc r_in(r_), u_in(u_), w_in(w_);
+            WriteAcc n_out(an_);
+            const detail::CGDots dots = custom_parallel_reduce(IterateOver::CSRRows(a_), reduce_options(),
+                [](size_t row, const auto& m, const auto& d, const auto& r, const auto& u, const auto& w, auto& nv) {
+                    auto view = m.get_view(row, GetCSRRowViewTag{});
+                    ComputeT ni{};
+                    for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                        const size_t col = view.col_indices_ptr[k];
+                        ni += view.value(k) * (d.get_value_by_id(col) * w.get_value_by_id(col));
+                    }
+                    nv.set_value_by_id(row, ni);
+                    const ComputeT ri = r.get_value_by_id(row), ui = u.get_value_by_id(row);
+                    return detail::CGDots{double(ri) * ui, double(w.get_value_by_id(row)) * ui, double(ri) * ri};
+                },
+                detail::CGDots{}, std::plus<>{}, mat, diag, r_in, u_in, w_in, n_out);
+            rnorm = std::sqrt(dots.c);
+            if (rnorm <= options_.tolerance * bnorm || result.iterations >= options_.max_iterations) break;
+
+            const double gamma = dots.a, delta = dots.b;
+            double beta = 0, alpha = 0;
+            if (result.iterations == 0) {
+                alpha = gamma / delta;
+            } else {
+                beta = gamma / gamma_old;
+                alpha = gamma / (delta - beta * gamma / alpha_old);
+            }
+            if (!std::isfinite(alpha) || !(alpha > 0)) break;  // Not positive definite (or breakdown)
+
+            // z = n + beta z; q = M w + beta q; s = w + beta s; p = u + beta p;
+            // x += alpha p; r -= alpha s; u -= alpha q; w -= alpha z
+            const ComputeT a_c = static_cast<ComputeT>(alpha), b_c = static_cast<ComputeT>(beta);
+            ReadAcc n_in(an_);
+            ReadWriteAcc z_io(z_), q_io(q_), s_io(s_), p_io(p_), x_io(x), r_io(r_), u_io(u_), w_io(w_);
+            custom_parallel_for(IterateOver::Range1D(n_),
+                [a_c, b_c](size_t i, const auto& d, const auto& nv, auto& z, auto& q, auto& s, auto& p,
+                           auto& xv, auto& r, auto& u, auto& w) {
+                    const ComputeT wi = w.get_value_by_id(i);
+                    const ComputeT zi = nv.get_value_by_id(i) + b_c * z.get_value_by_id(i);
+                    const ComputeT qi = d.get_value_by_id(i) * wi + b_c * q.get_value_by_id(i);
+                    const ComputeT si = wi + b_c * s.get_value_by_id(i);
+                    const ComputeT pi = u.get_value_by_id(i) + b_c * p.get_value_by_id(i);
+                    z.set_value_by_id(i, zi);
+                    q.set_value_by_id(i, qi);
+                    s.set_value_by_id(i, si);
+                    p.set_value_by_id(i, pi);
+                    xv.set_value_by_id(i, xv.get_value_by_id(i) + a_c * pi);
+                    r.set_value_by_id(i, r.get_value_by_id(i) - a_c * si);
+                    u.set_value_by_id(i, u.get_value_by_id(i) - a_c * qi);
+                    w.set_value_by_id(i, wi - a_c * zi);
+                },
+                diag, n_in, z_io, q_io, s_io, p_io, x_io, r_io, u_io, w_io);
+            gamma_old = gamma;
+            alpha_old = alpha;
+            ++result.iterations;
+        }
+        result.relative_residual = rnorm / bnorm;
+        result.converged = rnorm <= options_.tolerance * bnorm;
+        return result;
+    }
+
+    const Matrix& a_;
+    CGOptions options_;
+    CGVariant variant_;
+    size_t n_;
+    Vector inv_diag_;   ///< M = diag(A)^-1, or ones without a preconditioner
+    Vector r_;          ///< Residual
+    Vector u_;          ///< Preconditioned residual M r
+    Vector p_;          ///< Search direction
+    Vector p_next_;     ///< Standard: next direction (swapped with p_)
+    Vector q_;          ///< Standard: A p; pipelined: M s
+    Vector w_;          ///< Pipelined: A u
+    Vector s_;          ///< Pipelined: A p
+    Vector z_;          ///< Pipelined: A M s
+    Vector an_;         ///< Pipelined: A M w
+};
+
+/// @brief One-shot CG solve (allocates the work vectors for this call)
+template<typename StorageT, typename ComputeT>
+CGResult conjugate_gradient(const CSRMatrixT<StorageT, ComputeT>& a, const DenseArray1D<ComputeT>& b,
+                            DenseArray1D<ComputeT>& x, const CGOptions& options = {}) {
+    ConjugateGradient<StorageT, ComputeT> solver(a, options);
+    return solver.solve(b, x);
+}
+
+} // namespace accessor
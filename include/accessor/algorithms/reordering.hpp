@@ -0,0 +1,226 @@
+#pragma once
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_scan.hpp>
+#include <accessor/core/permutation.hpp>
+#include <accessor/iteration/range.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Maximum |row - col| over all nonzeros
+inline size_t matrix_bandwidth(const CSRMatrix& a) {
+    size_t bw = 0;
+    const long long n = static_cast<long long>(a.num_rows());
+    #pragma omp parallel for reduction(max:bw) schedule(static)
+    for (long long r = 0; r < n; ++r) {
+        size_t row = static_cast<size_t>(r);
+        for (size_t k = a.row_ptr[row]; k < a.row_ptr[row + 1]; ++k) {
+            size_t c = a.col_indices[k];
+            bw = std::max(bw, c > row ? c - row : row - c);
+        }
+    }
+    return bw;
+}
+
+/// @brief Envelope size: sum over rows of (row - leftmost column) below the diagonal
+inline size_t matrix_profile(const CSRMatrix& a) {
+    size_t profile = 0;
+    const long long n = static_cast<long long>(a.num_rows());
+    #pragma omp parallel for reduction(+:profile) schedule(static)
+    for (long long r = 0; r < n; ++r) {
+        size_t row = static_cast<size_t>(r);
+        size_t first = row;
+        for (size_t k = a.row_ptr[row]; k < a.row_ptr[row + 1]; ++k) {
+            first = std::min(first, a.col_indices[k]);
+        }
+        profile += row - first;
+    }
+    return profile;
+}
+
+/// @brief Order vertices by degree (row length), ties by id
+/// @param descending Highest degree first when true
+inline Permutation degree_sort(const CSRMatrix& a, bool descending = true) {
+    const size_t n = a.num_rows();
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t{0});
+    auto degree = [&a](size_t v) { return a.row_ptr[v + 1] - a.row_ptr[v]; };
+    std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+        return descending ? degree(x) > degree(y) : degree(x) < degree(y);
+    });
+    return Permutation(std::move(order));
+}
+
+/// @brief Hub sorting: vertices with above-average degree first (by degree,
+///        descending), all others keep their original relative order
+inline Permutation hub_sort(const CSRMatrix& a) {
+    const size_t n = a.num_rows();
+    const double average = n == 0 ? 0.0 : static_cast<double>(a.num_nonzeros()) / static_cast<double>(n);
+    auto degree = [&a](size_t v) { return a.row_ptr[v + 1] - a.row_ptr[v]; };
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t{0});
+    auto split = std::stable_partition(order.begin(), order.end(),
+        [&](size_t v) { return static_cast<double>(degree(v)) > average; });
+    std::stable_sort(order.begin(), split, [&](size_t x, size_t y) { return degree(x) > degree(y); });
+    return Permutation(std::move(order));
+}
+
+namespace detail {
+
+/// @brief Serial level structure from root inside one component
+/// @return Number of levels; last_level receives the vertices of the deepest level
+inline size_t rooted_level_structure(const CSRMatrix& a, size_t root, std::vector<size_t>& stamp, size_t stamp_value,
+                                     std::vector<size_t>& queue, std::vector<size_t>& last_level) {
+    queue.clear();
+    queue.push_back(root);
+    stamp[root] = stamp_value;
+    size_t levels = 0, begin = 0;
+    while (begin < queue.size()) {
+        size_t end = queue.size();
+        last_level.assign(queue.begin() + static_cast<std::ptrdiff_t>(begin), queue.end());
+        for (size_t q = begin; q < end; ++q) {
+            size_t v = queue[q];
+            for (size_t k = a.row_ptr[v]; k < a.row_ptr[v + 1]; ++k) {
+                size_t u = a.col_indices[k];
+                if (stamp[u] != stamp_value) {
+                    stamp[u] = stamp_value;
+                    queue.push_back(u);
+                }
+            }
+        }
+        begin = end;
+        ++levels;
+    }
+    return levels;
+}
+
+} // namespace detail
+
+/// @brief Reverse Cuthill-McKee ordering
+///
+/// Each connected component starts from a pseudo-peripheral vertex (George-
+/// Liu search from its minimum-degree vertex) and is expanded level by
+/// level. Within a level every vertex is claimed by its earliest parent with
+/// an atomic minimum, the children of each parent are sorted by degree, and
+/// placed at offsets from a prefix sum, which reproduces the serial
+/// Cuthill-McKee order exactly. The final order is reversed.
+/// @param a Matrix with a structurally symmetric pattern (use the pattern of
+///          A + A^T otherwise)
+inline Permutation reverse_cuthill_mckee(const CSRMatrix& a) {
+    const size_t n = a.num_rows();
+    constexpr size_t unset = std::numeric_limits<size_t>::max();
+    auto degree = [&a](size_t v) { return a.row_ptr[v + 1] - a.row_ptr[v]; };
+
+    std::vector<size_t> order;
+    order.reserve(n);
+    std::vector<size_t> position(n, unset);
+    std::vector<size_t> claim(n, unset);
+
+    // Candidate component roots, lowest degree first
+    std::vector<size_t> by_degree(n);
+    std::iota(by_degree.begin(), by_degree.end(), size_t{0});
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](size_t x, size_t y) { return degree(x) < degree(y); });
+
+    std::vector<size_t> stamp(n, 0), queue, last_level;
+    size_t stamp_value = 0;
+    std::vector<size_t> child_count;
+
+    for (size_t seed : by_degree) {
+        if (position[seed] != unset) continue;
+
+        // Pseudo-peripheral root
+        size_t root = seed;
+        size_t depth = detail::rooted_level_structure(a, root, stamp, ++stamp_value, queue, last_level);
+        for (int iter = 0; iter < 8 && depth > 1; ++iter) {
+            size_t candidate = *std::min_element(last_level.begin(), last_level.end(),
+                [&](size_t x, size_t y) { return degree(x) < degree(y); });
+            size_t candidate_depth = detail::rooted_level_structure(a, candidate, stamp, ++stamp_value, queue, last_level);
+            if (candidate_depth <= depth) break;
+            root = candidate;
+            depth = candidate_depth;
+        }
+
+        position[root] = order.size();
+        order.push_back(root);
+        size_t level_begin = order.size() - 1;
+
+        while (level_begin < order.size()) {
+            const size_t level_end = order.size();
+            const long long level_size = static_cast<long long>(level_end - level_begin);
+
+            // 1. Each unplaced neighbour is claimed by its earliest parent
+            #pragma omp parallel for schedule(dynamic, 64)
+            for (long long p = 0; p < level_size; ++p) {
+                size_t v = order[level_begin + static_cast<size_t>(p)];
+                size_t parent_pos = level_begin + static_cast<size_t>(p);
+                for (size_t k = a.row_ptr[v]; k < a.row_ptr[v + 1]; ++k) {
+                    size_t u = a.col_indices[k];
+                    if (position[u] != unset) continue;
+                    std::atomic_ref<size_t> slot(claim[u]);
+                    size_t current = slot.load(std::memory_order_relaxed);
+                    while (parent_pos < current &&
+                           !slot.compare_exchange_weak(current, parent_pos, std::memory_order_relaxed)) {
+                    }
+                }
+            }
+
+            // 2. Count children per parent and offset them with a prefix sum
+            child_count.assign(static_cast<size_t>(level_size) + 1, 0);
+            #pragma omp parallel for schedule(dynamic, 64)
+            for (long long p = 0; p < level_size; ++p) {
+                size_t v = order[level_begin + static_cast<size_t>(p)];
+                size_t parent_pos = level_begin + static_cast<size_t>(p);
+                size_t count = 0;
+                for (size_t k = a.row_ptr[v]; k < a.row_ptr[v + 1]; ++k) {
+                    size_t u = a.col_indices[k];
+                    if (position[u] == unset && claim[u] == parent_pos) ++count;
+                }
+                child_count[static_cast<size_t>(p)] = count;
+            }
+            size_t num_children;
+            {
+                Accessor<std::vector<size_t>, AccessMode::Read> in(child_count);
+                Accessor<std::vector<size_t>, AccessMode::Write> out(child_count);
+                num_children = custom_parallel_scan(IterateOver::Range1D(child_count.size()), ScanKind::Exclusive,
+                                                    size_t{0}, std::plus<>{}, in, out);
+            }
+            order.resize(level_end + num_children);
+
+            // 3. Place and sort each parent's children by degree
+            #pragma omp parallel for schedule(dynamic, 64)
+            for (long long p = 0; p < level_size; ++p) {
+                size_t v = order[level_begin + static_cast<size_t>(p)];
+                size_t parent_pos = level_begin + static_cast<size_t>(p);
+                auto first = order.begin() + static_cast<std::ptrdiff_t>(level_end + child_count[static_cast<size_t>(p)]);
+                auto out = first;
+                for (size_t k = a.row_ptr[v]; k < a.row_ptr[v + 1]; ++k) {
+                    size_t u = a.col_indices[k];
+                    if (position[u] == unset && claim[u] == parent_pos) *out++ = u;
+                }
+                std::sort(first, out, [&](size_t x, size_t y) {
+                    return degree(x) < degree(y) || (degree(x) == degree(y) && x < y);
+                });
+            }
+
+            const long long added = static_cast<long long>(num_children);
+            #pragma omp parallel for schedule(static)
+            for (long long i = 0; i < added; ++i) {
+                position[order[level_end + static_cast<size_t>(i)]] = level_end + static_cast<size_t>(i);
+            }
+            level_begin = level_end;
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return Permutation(std::move(order));
+}
+
+} // namespace accessor
@@ -0,0 +1,409 @@
+#pragma once
+#include <accessor/algorithms/reordering.hpp>
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/loop_schedule.hpp>
+#include <accessor/core/permutation.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <omp.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Cheap structural features of a sparse matrix
+struct MatrixFeatures {
+    size_t rows = 0;
+    size_t cols = 0;                 ///< One past the largest column index
+    size_t nonzeros = 0;
+    size_t max_row_length = 0;
+    size_t empty_rows = 0;
+    size_t bandwidth = 0;            ///< Maximum |row - col|
+    double mean_row_length = 0;
+    double row_length_variance = 0;
+
+    /// @brief Standard deviation of the row lengths over their mean
+    double row_length_cv() const {
+        return mean_row_length > 0 ? std::sqrt(row_length_variance) / mean_row_length : 0.0;
+    }
+};
+
+/// @brief One parallel pass over the row pointers and column indices
+inline MatrixFeatures compute_matrix_features(const CSRMatrix& a) {
+    MatrixFeatures f;
+    f.rows = a.num_rows();
+    f.nonzeros = a.num_nonzeros();
+    if (f.rows == 0) return f;
+    const long long n = static_cast<long long>(f.rows);
+    size_t max_len = 0, empty = 0, bw = 0, max_col = 0;
+    double sum_sq = 0;
+    #pragma omp parallel for schedule(static) reduction(max:max_len, bw, max_col) reduction(+:empty, sum_sq)
+    for (long long r = 0; r < n; ++r) {
+        const size_t row = static_cast<size_t>(r);
+        const size_t len = a.row_ptr[row + 1] - a.row_ptr[row];
+        max_len = std::max(max_len, len);
+        empty += len == 0;
+        sum_sq += static_cast<double>(len) * static_cast<double>(len);
+        for (size_t k = a.row_ptr[row]; k < a.row_ptr[row + 1]; ++k) {
+            const size_t c = a.col_indices[k];
+            bw = std::max(bw, c > row ? c - row : row - c);
+            max_col = std::max(max_col, c + 1);
+        }
+    }
+    f.max_row_length = max_len;
+    f.empty_rows = empty;
+    f.bandwidth = bw;
+    f.cols = max_col;
+    f.mean_row_length = static_cast<double>(f.nonzeros) / static_cast<double>(f.rows);
+    f.row_length_variance = std::max(0.0, sum_sq / static_cast<double>(f.rows) - f.mean_row_length * f.mean_row_length);
+    return f;
+}
+
+namespace detail {
+
+inline uint64_t fingerprint_mix(uint64_t h, uint64_t v) {
+    h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h * 0xff51afd7ed558ccdULL;
+}
+
+} // namespace detail
+
+/// @brief 64-bit hash of the sparsity structure (row lengths and column indices)
+///
+/// Values are left out: they do not change which kernel is fastest. Rows are
+/// hashed in fixed blocks, so the result does not depend on the thread count.
+inline uint64_t matrix_fingerprint(const CSRMatrix& a) {
+    constexpr size_t block_rows = 4096;
+    const size_t n = a.num_rows();
+    const size_t blocks = (n + block_rows - 1) / block_rows;
+    std::vector<uint64_t> block_hash(blocks);
+    const long long blocks_ll = static_cast<long long>(blocks);
+    #pragma omp parallel for schedule(static)
+    for (long long b = 0; b < blocks_ll; ++b) {
+        const size_t first = static_cast<size_t>(b) * block_rows, last = std::min(n, first + block_rows);
+        uint64_t h = static_cast<uint64_t>(b);
+        for (size_t row = first; row < last; ++row) {
+            h = detail::fingerprint_mix(h, a.row_ptr[row + 1] - a.row_ptr[row]);
+            for (size_t k = a.row_ptr[row]; k < a.row_ptr[row + 1]; ++k) h = detail::fingerprint_mix(h, a.col_indices[k]);
+        }
+        block_hash[b] = h;
+    }
+    uint64_t h = detail::fingerprint_mix(n, a.num_nonzeros());
+    for (uint64_t bh : block_hash) h = detail::fingerprint_mix(h, bh);
+    return h ^ (h >> 31);
+}
+
+/// @brief Storage order of the matrix a plan runs on
+enum class SpMVLayout {
+    Natural,              ///< The matrix as given
+    ReverseCuthillMcKee   ///< Symmetrically permuted copy; x and y are permuted on the fly
+};
+
+/// @brief How SpMV rows are assigned to iterations of custom_parallel_for
+enum class SpMVKernel {
+    Rows,          ///< One iteration per row (CSRRows)
+    NonzeroSplit   ///< One iteration per block of consecutive rows holding an equal share of nonzeros
+};
+
+inline const char* to_string(SpMVLayout l) { return l == SpMVLayout::Natural ? "natural" : "rcm"; }
+inline const char* to_string(SpMVKernel k) { return k == SpMVKernel::Rows ? "rows" : "nnz-split"; }
+
+/// @brief Everything an SpMVPlan needs besides the matrix
+struct SpMVPlanConfig {
+    SpMVLayout layout = SpMVLayout::Natural;
+    SpMVKernel kernel = SpMVKernel::Rows;
+    LoopSchedule schedule;
+    size_t parts = 0;   ///< NonzeroSplit: number of row blocks (0: one per thread)
+
+    bool operator==(const SpMVPlanConfig& o) const {
+        return layout == o.layout && kernel == o.kernel && schedule == o.schedule && parts == o.parts;
+    }
+    bool operator!=(const SpMVPlanConfig& o) const { return !(*this == o); }
+};
+
+/// @brief e.g. "natural/rows/dynamic,64" or "rcm/nnz-split x16/static"
+inline std::string to_string(const SpMVPlanConfig& c) {
+    std::ostringstream out;
+    out << to_string(c.layout) << '/' << to_string(c.kernel);
+    if (c.kernel == SpMVKernel::NonzeroSplit) out << " x" << c.parts;
+    out << '/' << to_string(c.schedule.kind);
+    if (c.schedule.chunk) out << ',' << c.schedule.chunk;
+    return out.str();
+}
+
+/// @brief Ready-to-run y = A x with a fixed layout, kernel and schedule
+///
+/// All set-up (reordering, nonzero partition, permuted vectors) happens in the
+/// constructor; apply() only runs the loop. With the natural layout the plan
+/// keeps a pointer to the matrix, which must outlive it; a reordered copy is
+/// owned and shared between copies of the plan.
+class SpMVPlan {
+public:
+    using Vector = DenseArray1D<float>;
+
+    SpMVPlan(const CSRMatrix& a, const SpMVPlanConfig& config)
+        : config_(config), matrix_(&a), rows_(a.num_rows()) {
+        if (config_.layout == SpMVLayout::ReverseCuthillMcKee) {
+            if (compute_matrix_features(a).cols > rows_) {
+                throw std::invalid_argument("SpMVPlan: reordering needs a square matrix");
+            }
+            permutation_ = std::make_shared<const Permutation>(reverse_cuthill_mckee(a));
+            reordered_ = std::make_shared<const CSRMatrix>(permute_matrix(a, *permutation_));
+            matrix_ = reordered_.get();
+            x_work_ = Vector(rows_);
+            y_work_ = Vector(rows_);
+        }
+        if (config_.kernel == SpMVKernel::NonzeroSplit) {
+            if (config_.parts == 0) config_.parts = static_cast<size_t>(omp_get_max_threads());
+            // Block p starts at the first row whose nonzeros begin at or after p * nnz / parts
+            const CSRMatrix& m = *matrix_;
+            const size_t nnz = m.num_nonzeros();
+            part_begin_.assign(config_.parts + 1, 0);
+            for (size_t p = 0; p < config_.parts && rows_ > 0; ++p) {
+                const size_t target = nnz / config_.parts * p + nnz % config_.parts * p / config_.parts;
+                part_begin_[p] = static_cast<size_t>(
+                    std::lower_bound(m.row_ptr.begin(), m.row_ptr.end() - 1, target) - m.row_ptr.begin());
+            }
+            part_begin_[config_.parts] = rows_;
+        }
+    }
+
+    const SpMVPlanConfig& config() const { return config_; }
+    size_t num_rows() const { return rows_; }
+
+    /// @brief y = A x
+    /// @throws std::invalid_argument if y has fewer entries than A has rows
+    void apply(const Vector& x, Vector& y) {
+        if (y.data.size() < rows_) throw std::invalid_argument("SpMVPlan: y is shorter than the number of rows");
+        if (config_.layout == SpMVLayout::Natural) {
+            run(x, y);
+            return;
+        }
+        const long long n = static_cast<long long>(rows_);
+        const size_t* new_to_old = permutation_->new_to_old.data();
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n; ++i) x_work_.data[i] = x.data[new_to_old[i]];
+        run(x_work_, y_work_);
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n; ++i) y.data[new_to_old[i]] = y_work_.data[i];
+    }
+
+private:
+    void run(const Vector& x, Vector& y) const {
+        Accessor<CSRMatrix, AccessMode::Read> mat(*matrix_);
+        Accessor<Vector, AccessMode::Read> x_in(x);
+        Accessor<Vector, AccessMode::Write> y_out(y);
+        auto row_product = [](size_t row, const auto& a, const auto& xv, auto& yv) {
+            auto view = a.get_view(row, GetCSRRowViewTag{});
+            float sum = 0;
+            for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+            }
+            yv.set_value_by_id(row, sum);
+        };
+        if (config_.kernel == SpMVKernel::Rows) {
+            custom_parallel_for(config_.schedule, IterateOver::CSRRows(*matrix_), row_product, mat, x_in, y_out);
+        } else {
+            custom_parallel_for(config_.schedule, IterateOver::Range1D(config_.parts),
+                [bounds = part_begin_.data(), &row_product](size_t part, const auto& a, const auto& xv, auto& yv) {
+                    for (size_t row = bounds[part]; row < bounds[part + 1]; ++row) row_product(row, a, xv, yv);
+                },
+                mat, x_in, y_out);
+        }
+    }
+
+    SpMVPlanConfig config_;
+    const CSRMatrix* matrix_;
+    size_t rows_;
+    std::shared_ptr<const Permutation> permutation_;
+    std::shared_ptr<const CSRMatrix> reordered_;
+    std::vector<size_t> part_begin_;
+    Vector x_work_, y_work_;
+};
+
+/// @brief Knobs of SpMVAutotuner
+struct SpMVAutotuneOptions {
+    int trial_runs = 5;                  ///< Timed SpMVs per candidate after one warm-up; the fastest counts
+    bool try_reordering = true;
+    double reorder_min_bandwidth = 0.05; ///< Reordering is tried only above this bandwidth / rows
+    double irregular_row_cv = 0.5;       ///< On-demand schedules and nonzero splits are tried only above
+                                         ///< this coefficient of variation of the row lengths
+    std::string cache_path;              ///< File of earlier decisions; empty for none
+};
+
+/// @brief Timing of one candidate
+struct SpMVTrial {
+    SpMVPlanConfig config;
+    double seconds = 0;
+};
+
+/// @brief Picks an SpMVPlan per matrix from short timed trials
+///
+/// Features of the matrix prune the candidates: uniform rows only compare
+/// the static schedule with one on-demand schedule, irregular rows add
+/// smaller chunks, guided scheduling and nonzero-balanced row blocks. The
+/// winning kernel is then re-timed on an RCM-reordered copy when the
+/// bandwidth is large. Decisions are keyed by matrix_fingerprint() and the
+/// thread count and, with a cache path, persisted so that later runs build
+/// the plan without any trials.
+class SpMVAutotuner {
+public:
+    explicit SpMVAutotuner(SpMVAutotuneOptions options = {}) : options_(std::move(options)) {
+        if (!options_.cache_path.empty()) load(options_.cache_path);
+    }
+
+    /// @brief Plan for a, from the cache or from trials
+    SpMVPlan tune(const CSRMatrix& a) {
+        const Key key{matrix_fingerprint(a), omp_get_max_threads()};
+        last_trials_.clear();
+        auto hit = cache_.find(key);
+        last_from_cache_ = hit != cache_.end();
+        if (last_from_cache_) return SpMVPlan(a, hit->second);
+
+        last_features_ = compute_matrix_features(a);
+        SpMVPlanConfig best;
+        double best_time = 0;
+        for (const SpMVPlanConfig& c : candidates(last_features_)) {
+            SpMVPlan plan(a, c);
+            const double t = time(plan, a);
+            if (last_trials_.empty() || t < best_time) {
+                best = plan.config();
+                best_time = t;
+            }
+            last_trials_.push_back({plan.config(), t});
+        }
+        if (options_.try_reordering && last_features_.cols <= last_features_.rows &&
+            static_cast<double>(last_features_.bandwidth) >
+                options_.reorder_min_bandwidth * static_cast<double>(last_features_.rows)) {
+            SpMVPlanConfig c = best;
+            c.layout = SpMVLayout::ReverseCuthillMcKee;
+            SpMVPlan plan(a, c);
+            const double t = time(plan, a);
+            last_trials_.push_back({plan.config(), t});
+            if (t < best_time) return remember(key, std::move(plan));
+        }
+        return remember(key, SpMVPlan(a, best));
+    }
+
+    /// @brief Natural-layout candidates for a matrix with the given features
+    std::vector<SpMVPlanConfig> candidates(const MatrixFeatures& f) const {
+        // Chunks of roughly 2K (small) and 16K (large) nonzeros
+        const size_t mean = std::max<size_t>(1, static_cast<size_t>(f.mean_row_length + 0.5));
+        const size_t small_chunk = std::clamp<size_t>(2048 / mean, 8, 4096);
+        const size_t large_chunk = small_chunk * 8;
+        const size_t threads = static_cast<size_t>(omp_get_max_threads());
+        using K = ScheduleKind;
+        std::vector<SpMVPlanConfig> c;
+        c.push_back({SpMVLayout::Natural, SpMVKernel::Rows, {K::Static, 0}, 0});
+        c.push_back({SpMVLayout::Natural, SpMVKernel::Rows, {K::Dynamic, large_chunk}, 0});
+        if (f.row_length_cv() > options_.irregular_row_cv) {
+            c.push_back({SpMVLayout::Natural, SpMVKernel::Rows, {K::Dynamic, small_chunk}, 0});
+            c.push_back({SpMVLayout::Natural, SpMVKernel::Rows, {K::Guided, small_chunk}, 0});
+            c.push_back({SpMVLayout::Natural, SpMVKernel::NonzeroSplit, {K::Static, 0}, threads});
+            c.push_back({SpMVLayout::Natural, SpMVKernel::NonzeroSplit, {K::Dynamic, 1}, threads * 8});
+        }
+        return c;
+    }
+
+    const std::vector<SpMVTrial>& last_trials() const { return last_trials_; }
+    bool last_from_cache() const { return last_from_cache_; }
+    /// @note Not recomputed when the last plan came from the cache
+    const MatrixFeatures& last_features() const { return last_features_; }
+    size_t cache_size() const { return cache_.size(); }
+    void clear_cache() { cache_.clear(); }
+
+    /// @brief Write one line per decision
+    bool save(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << "# accessor spmv autotune cache: <fingerprint> <threads> <layout> <kernel> <schedule> <chunk> <parts>\n";
+        for (const auto& [key, c] : cache_) {
+            out << std::hex << key.first << std::dec << ' ' << key.second << ' ' << to_string(c.layout) << ' '
+                << to_string(c.kernel) << ' ' << to_string(c.schedule.kind) << ' ' << c.schedule.chunk << ' '
+                << c.parts << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    /// @brief Merge decisions from a file written by save(); malformed lines are skipped
+    bool load(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) return false;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream fields(line);
+            Key key;
+            std::string layout, kernel, kind;
+            SpMVPlanConfig c;
+            if (!(fields >> std::hex >> key.first >> std::dec >> key.second >> layout >> kernel >> kind >>
+                  c.schedule.chunk >> c.parts)) {
+                continue;
+            }
+            if (layout == to_string(SpMVLayout::Natural)) c.layout = SpMVLayout::Natural;
+            else if (layout == to_string(SpMVLayout::ReverseCuthillMcKee)) c.layout = SpMVLayout::ReverseCuthillMcKee;
+            else continue;
+            if (kernel == to_string(SpMVKernel::Rows)) c.kernel = SpMVKernel::Rows;
+            else if (kernel == to_string(SpMVKernel::NonzeroSplit) && c.parts > 0) c.kernel = SpMVKernel::NonzeroSplit;
+            else continue;
+            if (kind == to_string(ScheduleKind::Static)) c.schedule.kind = ScheduleKind::Static;
+            else if (kind == to_string(ScheduleKind::Dynamic)) c.schedule.kind = ScheduleKind::Dynamic;
+            else if (kind == to_string(ScheduleKind::Guided)) c.schedule.kind = ScheduleKind::Guided;
+            else continue;
+            cache_[key] = c;
+        }
+        return true;
+    }
+
+private:
+    using Key = std::pair<uint64_t, int>;   ///< Fingerprint, thread count
+
+    double time(SpMVPlan& plan, const CSRMatrix& a) const {
+        const size_t cols = std::max(last_features_.cols, a.num_rows());
+        SpMVPlan::Vector x(std::vector<float>(cols, 1.0f)), y(a.num_rows());
+        plan.apply(x, y);
+        double best = 0;
+        for (int rep = 0; rep < std::max(1, options_.trial_runs); ++rep) {
+            auto t0 = std::chrono::steady_clock::now();
+            plan.apply(x, y);
+            const double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            if (rep == 0 || t < best) best = t;
+        }
+        return best;
+    }
+
+    SpMVPlan remember(const Key& key, SpMVPlan plan) {
+        cache_[key] = plan.config();
+        if (!options_.cache_path.empty()) {
+            // Keep decisions other processes wrote since this tuner loaded the file
+            auto mine = cache_;
+            load(options_.cache_path);
+            for (const auto& entry : mine) cache_[entry.first] = entry.second;
+            save(options_.cache_path);
+        }
+        return plan;
+    }
+
+    SpMVAutotuneOptions options_;
+    std::map<Key, SpMVPlanConfig> cache_;
+    std::vector<SpMVTrial> last_trials_;
+    MatrixFeatures last_features_;
+    bool last_from_cache_ = false;
+};
+
+} // namespace accessor
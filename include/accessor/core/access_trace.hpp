@@ -0,0 +1,540 @@
+#pragma once
+
+#include "access_mode.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <omp.h>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+/// Access tracing is opt-in: build with -DACCESSOR_ENABLE_TRACING=1 to
+/// compile the per-access hooks in. Without it accessors carry no tracing
+/// cost and AccessTraceSession records nothing.
+#if !defined(ACCESSOR_ENABLE_TRACING)
+#define ACCESSOR_ENABLE_TRACING 0
+#endif
+
+namespace accessor {
+
+/// @brief Per-call-site record of whether custom_parallel_for's
+///        auto-buffer is needed
+///
+/// Filled from traced sample runs (AccessTraceSession::record_hints) and
+/// saved to a file; a later run loads the file and custom_parallel_for
+/// skips the buffer copy and write-back for call sites whose sample never
+/// read an id that another iteration wrote. A call site is where its
+/// ExecutionContext was built, together with the kernel, iteration space
+/// and accessor types and the accessors the aliasing analysis buffers
+/// (detail::buffering_hint_key); calls without a context have no site and
+/// always buffer, as do sites no sample recorded. Hints are only valid for
+/// builds of the same sources with the same compiler. The registry is
+/// always compiled, so a build without tracing can consume hints recorded
+/// by a tracing build of the same sources.
+class BufferingHints {
+public:
+    static BufferingHints& global() {
+        static BufferingHints hints;
+        return hints;
+    }
+
+    /// @brief Record a sample result; a site stays "needed" once any sample needed it
+    void set(const std::string& site, bool needed) {
+        auto it = needed_.find(site);
+        if (it == needed_.end()) {
+            needed_.emplace(site, needed);
+        } else {
+            it->second = it->second || needed;
+        }
+    }
+
+    /// @brief True when the site is known and its samples never needed buffering
+    bool can_skip(std::string_view site) const {
+        if (needed_.empty()) return false;
+        auto it = needed_.find(site);
+        return it != needed_.end() && !it->second;
+    }
+
+    bool empty() const { return needed_.empty(); }
+    size_t size() const { return needed_.size(); }
+    void clear() { needed_.clear(); }
+
+    /// @brief Write one "<0|1> <site>" line per call site
+    bool save(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << "# accessor buffering hints: <needed> <call site>\n";
+        for (const auto& [site, needed] : needed_) out << (needed ? 1 : 0) << ' ' << site << '\n';
+        return static_cast<bool>(out);
+    }
+
+    /// @brief Merge hints from a file written by save()
+    bool load(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) return false;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.size() < 3 || line[0] == '#') continue;
+            set(line.substr(2), line[0] == '1');
+        }
+        return true;
+    }
+
+private:
+    std::map<std::string, bool, std::less<>> needed_;
+};
+
+enum class AccessKind : uint8_t { Read, Write, Reduce, View, Raw };
+
+/// @brief Dominant pattern of consecutive ids touched by one thread
+enum class AccessPattern {
+    None,        ///< Fewer than two accesses
+    Sequential,  ///< At least 90% of steps are 0 or +-1
+    Strided,     ///< One other stride accounts for at least half of the steps
+    Random
+};
+
+inline const char* to_string(AccessPattern p) {
+    switch (p) {
+        case AccessPattern::Sequential: return "sequential";
+        case AccessPattern::Strided: return "strided";
+        case AccessPattern::Random: return "random";
+        default: return "none";
+    }
+}
+
+inline const char* to_string(AccessMode m) {
+    switch (m) {
+        case AccessMode::Read: return "Read";
+        case AccessMode::Write: return "Write";
+        case AccessMode::ReadWrite: return "ReadWrite";
+        default: return "Reduce";
+    }
+}
+
+/// @brief What one accessor argument touched during a traced loop
+struct AccessorFootprint {
+    size_t arg_index = 0;
+    AccessMode mode = AccessMode::Read;
+    std::string type_name;
+    bool buffered = false;                       ///< Kernel saw an auto-buffer copy
+    size_t reads = 0, writes = 0, reduces = 0, views = 0;
+    size_t distinct_read_ids = 0;                ///< Views count their context id
+    size_t distinct_write_ids = 0;               ///< Writes and reductions
+    std::map<long long, size_t> stride_histogram;  ///< Per-thread id deltas
+    AccessPattern pattern = AccessPattern::None;
+};
+
+/// @brief Summary of one traced custom_parallel_for call
+struct LoopTrace {
+    std::string call_site;            ///< Demangled kernel type
+    size_t iterations = 0;
+    bool buffered = false;            ///< custom_parallel_for used the auto-buffer
+    bool buffering_needed = false;    ///< Some read could observe a write of the same loop
+    size_t shared_written_ids = 0;    ///< Written ids that more than one thread touched
+    bool truncated = false;           ///< Event limit reached; results are partial
+    bool opaque = false;              ///< Some accesses are unseen (raw pointers, active nested regions)
+    std::vector<AccessorFootprint> accessors;
+};
+
+namespace detail {
+
+inline std::string demangle(const char* name) {
+#if defined(__GNUG__)
+    int status = 0;
+    char* out = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status == 0 && out) {
+        std::string result(out);
+        std::free(out);
+        return result;
+    }
+#endif
+    return name;
+}
+
+/// @brief Name of a kernel's type, as shown in trace reports
+template<typename KernelFunc>
+const char* kernel_name() {
+    return typeid(std::remove_cvref_t<KernelFunc>).name();
+}
+
+/// @brief BufferingHints key of a custom_parallel_for call: its site, the
+///        kernel, iteration space and accessor types, and the indices of
+///        the accessors the aliasing analysis buffers
+template<typename KernelFunc, typename IterSpaceType, typename... AccessorTypes, typename Indices>
+std::string buffering_hint_key(const std::source_location& site, const Indices& buffered) {
+    std::string key = site.file_name();
+    key += ':' + std::to_string(site.line()) + ':' + std::to_string(site.column());
+    key += ' ';
+    key += kernel_name<KernelFunc>();
+    key += ' ';
+    key += typeid(IterSpaceType).name();
+    ((key += ' ', key += typeid(AccessorTypes).name()), ...);
+    key += " buffered";
+    for (size_t idx : buffered) key += ' ' + std::to_string(idx);
+    return key;
+}
+
+template<typename ID>
+size_t trace_id(const ID& id) {
+    if constexpr (std::is_integral_v<ID>) {
+        return static_cast<size_t>(id);
+    } else {
+        return SIZE_MAX;  // Ids that are not integers are counted but not analysed
+    }
+}
+
+inline thread_local size_t trace_iteration = 0;
+
+class AccessTraceCollector;
+inline std::atomic<AccessTraceCollector*> active_trace{nullptr};
+
+/// @brief Event storage and analysis behind AccessTraceSession
+class AccessTraceCollector {
+public:
+    explicit AccessTraceCollector(size_t max_events_per_thread) : max_events_(max_events_per_thread) {}
+
+    void begin_loop(const char* kernel, const std::string& hint_key, size_t iterations) {
+        in_loop_ = true;
+        site_ = demangle(kernel);
+        site_key_ = hint_key;
+        iterations_ = iterations;
+        traced_level_ = omp_get_level();
+        nested_opaque_.store(false, std::memory_order_relaxed);
+        slots_.clear();
+        logs_.assign(static_cast<size_t>(omp_get_max_threads()), ThreadLog{});
+    }
+
+    void register_accessor(size_t arg, const void* data, const void* original, AccessMode mode,
+                           const char* type_name, bool buffered) {
+        slots_.push_back(Slot{arg, data, original, mode, demangle(type_name), buffered});
+    }
+
+    void record(const void* data, AccessMode mode, size_t id, AccessKind kind) {
+        if (!in_loop_) return;
+        ThreadLog* log_ptr = thread_log();
+        if (!log_ptr) return;
+        ThreadLog& log = *log_ptr;
+        if (kind == AccessKind::Raw) {
+            log.opaque = true;
+            return;
+        }
+        if (log.events.size() >= max_events_) {
+            log.truncated = true;
+            return;
+        }
+        for (size_t s = 0; s < slots_.size(); ++s) {
+            if (slots_[s].data == data && slots_[s].mode == mode) {
+                log.events.push_back(Event{id, trace_iteration, static_cast<uint32_t>(s), kind});
+                return;
+            }
+        }
+    }
+
+    void end_loop() {
+        in_loop_ = false;
+        loops_.push_back(analyse());
+        hint_keys_.push_back(site_key_);
+        logs_.clear();
+    }
+
+    bool in_loop() const { return in_loop_; }
+    const std::vector<LoopTrace>& loops() const { return loops_; }
+    const std::vector<std::string>& hint_keys() const { return hint_keys_; }
+
+private:
+    struct Slot {
+        size_t arg;
+        const void* data;
+        const void* original;
+        AccessMode mode;
+        std::string type_name;
+        bool buffered;
+    };
+    struct Event {
+        size_t id;
+        size_t iteration;
+        uint32_t slot;
+        AccessKind kind;
+    };
+    struct ThreadLog {
+        std::vector<Event> events;
+        bool truncated = false;
+        bool opaque = false;
+    };
+
+    // Log of the traced loop's thread that performs the access. A region
+    // nested in the traced one reports thread numbers of its own team, so
+    // the log is chosen by the ancestor at the traced loop's level. Inactive
+    // nested regions run on that thread alone and are logged as usual; an
+    // active one would share the log between threads, so its accesses are
+    // dropped and the loop is reported opaque.
+    ThreadLog* thread_log() {
+        const int level = omp_get_level();
+        if (level <= traced_level_) return &logs_[0];  // Static extent: the calling thread runs the loop
+        for (int l = traced_level_ + 2; l <= level; ++l) {
+            if (omp_get_team_size(l) > 1) {
+                nested_opaque_.store(true, std::memory_order_relaxed);
+                return nullptr;
+            }
+        }
+        const size_t tid = static_cast<size_t>(omp_get_ancestor_thread_num(traced_level_ + 1));
+        return tid < logs_.size() ? &logs_[tid] : nullptr;
+    }
+
+    static bool is_read(AccessKind k) { return k == AccessKind::Read || k == AccessKind::View; }
+
+    static AccessPattern classify(const std::map<long long, size_t>& hist) {
+        size_t total = 0, near = 0, top = 0;
+        for (const auto& [stride, count] : hist) {
+            total += count;
+            if (stride >= -1 && stride <= 1) near += count;
+            else top = std::max(top, count);
+        }
+        if (total == 0) return AccessPattern::None;
+        if (10 * near >= 9 * total) return AccessPattern::Sequential;
+        if (2 * top >= total) return AccessPattern::Strided;
+        return AccessPattern::Random;
+    }
+
+    LoopTrace analyse() const {
+        LoopTrace t;
+        t.call_site = site_;
+        t.iterations = iterations_;
+        t.opaque = nested_opaque_.load(std::memory_order_relaxed);
+        for (const ThreadLog& log : logs_) {
+            t.truncated = t.truncated || log.truncated;
+            t.opaque = t.opaque || log.opaque;
+        }
+
+        std::vector<std::vector<size_t>> read_ids(slots_.size()), write_ids(slots_.size());
+        for (size_t s = 0; s < slots_.size(); ++s) {
+            AccessorFootprint f;
+            f.arg_index = slots_[s].arg;
+            f.mode = slots_[s].mode;
+            f.type_name = slots_[s].type_name;
+            f.buffered = slots_[s].buffered;
+            t.buffered = t.buffered || f.buffered;
+            t.accessors.push_back(std::move(f));
+        }
+        for (const ThreadLog& log : logs_) {
+            std::vector<size_t> last(slots_.size(), SIZE_MAX);
+            for (const Event& e : log.events) {
+                AccessorFootprint& f = t.accessors[e.slot];
+                switch (e.kind) {
+                    case AccessKind::Read: ++f.reads; break;
+                    case AccessKind::Write: ++f.writes; break;
+                    case AccessKind::Reduce: ++f.reduces; break;
+                    case AccessKind::View: ++f.views; break;
+                    case AccessKind::Raw: break;
+                }
+                if (e.id == SIZE_MAX) continue;
+                (is_read(e.kind) ? read_ids : write_ids)[e.slot].push_back(e.id);
+                if (last[e.slot] != SIZE_MAX) {
+                    ++f.stride_histogram[static_cast<long long>(e.id) - static_cast<long long>(last[e.slot])];
+                }
+                last[e.slot] = e.id;
+            }
+        }
+        for (size_t s = 0; s < slots_.size(); ++s) {
+            AccessorFootprint& f = t.accessors[s];
+            f.distinct_read_ids = count_distinct(read_ids[s]);
+            f.distinct_write_ids = count_distinct(write_ids[s]);
+            f.pattern = classify(f.stride_histogram);
+        }
+
+        // Accessors grouped by the object they alias
+        std::vector<const void*> objects;
+        for (const Slot& slot : slots_) {
+            if (std::find(objects.begin(), objects.end(), slot.original) == objects.end()) {
+                objects.push_back(slot.original);
+            }
+        }
+        for (const void* object : objects) {
+            size_t members = 0;
+            for (const Slot& slot : slots_) members += slot.original == object;
+
+            struct Touch {
+                std::vector<size_t> writer_iterations;   // every iteration that wrote the id
+                size_t thread = SIZE_MAX;
+                bool shared = false;
+            };
+            std::unordered_map<size_t, Touch> touched;
+            for (size_t tid = 0; tid < logs_.size(); ++tid) {
+                for (const Event& e : logs_[tid].events) {
+                    if (e.id == SIZE_MAX || slots_[e.slot].original != object) continue;
+                    Touch& touch = touched[e.id];
+                    if (touch.thread == SIZE_MAX) touch.thread = tid;
+                    else if (touch.thread != tid) touch.shared = true;
+                    if (!is_read(e.kind)) touch.writer_iterations.push_back(e.iteration);
+                }
+            }
+            for (auto& [id, touch] : touched) {
+                std::vector<size_t>& w = touch.writer_iterations;
+                std::sort(w.begin(), w.end());
+                w.erase(std::unique(w.begin(), w.end()), w.end());
+                t.shared_written_ids += !w.empty() && touch.shared;
+            }
+            if (members < 2) continue;
+            // Read-old/write-new hazard: a read of a written id sees the old
+            // value only with the buffer. Without it the read is safe only if
+            // its own iteration is the sole writer and has not written the id
+            // yet (an iteration's events are logged in order by one thread).
+            for (const ThreadLog& log : logs_) {
+                size_t iteration = SIZE_MAX;
+                std::unordered_set<size_t> written_here;
+                for (const Event& e : log.events) {
+                    if (e.id == SIZE_MAX || slots_[e.slot].original != object) continue;
+                    if (e.iteration != iteration) {
+                        iteration = e.iteration;
+                        written_here.clear();
+                    }
+                    if (!is_read(e.kind)) {
+                        written_here.insert(e.id);
+                        continue;
+                    }
+                    auto it = touched.find(e.id);
+                    if (it == touched.end() || it->second.writer_iterations.empty()) continue;
+                    const std::vector<size_t>& w = it->second.writer_iterations;
+                    if (w.size() > 1 || w[0] != e.iteration || written_here.count(e.id)) {
+                        t.buffering_needed = true;
+                    }
+                }
+            }
+        }
+        return t;
+    }
+
+    static size_t count_distinct(std::vector<size_t>& ids) {
+        std::sort(ids.begin(), ids.end());
+        return static_cast<size_t>(std::unique(ids.begin(), ids.end()) - ids.begin());
+    }
+
+    size_t max_events_;
+    bool in_loop_ = false;
+    std::string site_;
+    std::string site_key_;
+    size_t iterations_ = 0;
+    int traced_level_ = 0;
+    std::atomic<bool> nested_opaque_{false};
+    std::vector<Slot> slots_;
+    std::vector<ThreadLog> logs_;
+    std::vector<LoopTrace> loops_;
+    std::vector<std::string> hint_keys_;
+};
+
+/// @brief Record one access of an accessor (no-op without an active session)
+template<typename ID>
+inline void trace_access(const void* data, AccessMode mode, const ID& id, AccessKind kind) {
+    AccessTraceCollector* trace = active_trace.load(std::memory_order_relaxed);
+    if (trace) {
+        trace->record(data, mode, trace_id(id), kind);
+    }
+}
+
+} // namespace detail
+
+/// @brief Opt-in recording of what each accessor of each custom_parallel_for
+///        call touches, while the session object is alive
+///
+/// Use it for a sample run: per accessor it reports read/write counts,
+/// distinct ids, per-thread stride histograms and the resulting pattern;
+/// per loop whether the auto-buffer was used, whether it was actually
+/// needed (some iteration read an id that another iteration wrote, or that
+/// it had written itself) and how many written ids several threads touched. Views are recorded by their context
+/// id only. Events are stored in memory (max_events_per_thread per thread),
+/// so keep sample runs small. Without ACCESSOR_ENABLE_TRACING the session
+/// records nothing.
+/// @note One session at a time; loops nested inside a traced loop are not
+///       traced themselves, but their accesses count towards the outer loop.
+class AccessTraceSession {
+public:
+    explicit AccessTraceSession(size_t max_events_per_thread = size_t{1} << 22)
+        : collector_(max_events_per_thread) {
+        detail::active_trace.store(&collector_, std::memory_order_release);
+    }
+    ~AccessTraceSession() {
+        detail::AccessTraceCollector* expected = &collector_;
+        detail::active_trace.compare_exchange_strong(expected, nullptr);
+    }
+    AccessTraceSession(const AccessTraceSession&) = delete;
+    AccessTraceSession& operator=(const AccessTraceSession&) = delete;
+
+    static constexpr bool enabled() { return ACCESSOR_ENABLE_TRACING != 0; }
+
+    const std::vector<LoopTrace>& loops() const { return collector_.loops(); }
+
+    /// @brief Store the buffering verdict of every buffered loop that has a
+    ///        call site (truncated or opaque samples count as needing the buffer)
+    void record_hints(BufferingHints& hints = BufferingHints::global()) const {
+        const auto& keys = collector_.hint_keys();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const LoopTrace& loop = collector_.loops()[i];
+            if (loop.buffered && !keys[i].empty()) {
+                hints.set(keys[i], loop.buffering_needed || loop.truncated || loop.opaque);
+            }
+        }
+    }
+
+    void print_report(std::ostream& os) const {
+        if (!enabled()) {
+            os << "access tracing is compiled out (ACCESSOR_ENABLE_TRACING=0)\n";
+            return;
+        }
+        for (const LoopTrace& loop : loops()) {
+            os << "loop " << loop.call_site << ": " << loop.iterations << " iterations, buffered "
+               << (loop.buffered ? "yes" : "no") << ", buffering needed " << (loop.buffering_needed ? "yes" : "no")
+               << ", shared written ids " << loop.shared_written_ids << (loop.truncated ? " (truncated)" : "")
+               << (loop.opaque ? " (partly unseen: raw pointer or active nested region)" : "") << '\n';
+            for (const AccessorFootprint& f : loop.accessors) {
+                os << "  arg " << f.arg_index << ' ' << to_string(f.mode) << ' ' << f.type_name << ": "
+                   << f.reads << " reads (" << f.distinct_read_ids << " ids), " << f.writes + f.reduces
+                   << " writes (" << f.distinct_write_ids << " ids), " << f.views << " views, "
+                   << to_string(f.pattern);
+                if (!f.stride_histogram.empty()) {
+                    auto top = std::max_element(f.stride_histogram.begin(), f.stride_histogram.end(),
+                        [](const auto& a, const auto& b) { return a.second < b.second; });
+                    os << " (most common stride " << top->first << ")";
+                }
+                os << '\n';
+            }
+        }
+    }
+
+private:
+    detail::AccessTraceCollector collector_;
+};
+
+namespace detail {
+
+/// @brief Start tracing a custom_parallel_for call if a session is active
+/// @return The collector to register accessors with, or nullptr
+inline AccessTraceCollector* begin_traced_loop(const char* kernel, const std::string& hint_key, size_t iterations) {
+    AccessTraceCollector* trace = active_trace.load(std::memory_order_acquire);
+    if (!trace || trace->in_loop()) return nullptr;
+    trace->begin_loop(kernel, hint_key, iterations);
+    return trace;
+}
+
+/// @brief True while an AccessTraceSession is alive (always false without tracing)
+inline bool tracing_active() {
+    return ACCESSOR_ENABLE_TRACING && active_trace.load(std::memory_order_relaxed) != nullptr;
+}
+
+} // namespace detail
+
+} // namespace accessor
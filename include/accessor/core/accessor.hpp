@@ -1,8 +1,13 @@
 #pragma once
 
 #include "access_mode.hpp"
+#include "access_trace.hpp"
+#include "compiler_hints.hpp"
+#include "concepts.hpp"
 #include "permission_check.hpp"
+#include "reduce_policy.hpp"
 #include "../traits/data_structure_traits.hpp"
+#include <functional>
 #include <type_traits>
 
 namespace accessor {
@@ -12,6 +17,8 @@ namespace accessor {
 /// @tparam Mode The access mode for this accessor
 template<typename DS_Type, AccessMode Mode>
 class Accessor {
+    static_assert(HasDataStructureTraits<DS_Type>, "DataStructureTraits must be specialized for this type");
+
 public:
     using TraitsType = DataStructureTraits<DS_Type>;
     using ItemIDType = typename TraitsType::ItemIDType;
@@ -23,22 +30,48 @@ public:
     /// @param ds Reference to the data structure instance
     explicit Accessor(DS_Type& ds) : data_ref(ds) {}
 
+    /// @brief Constructor from a const data structure (read-only modes)
+    /// @param ds Reference to the data structure instance
+    explicit Accessor(const DS_Type& ds) requires (Mode == AccessMode::Read)
+        : data_ref(const_cast<DS_Type&>(ds)) {}
+
     /// @brief Get a value by its ID
     /// @param id The ID of the item to access
     /// @return The value at the specified ID
-    ValueType get_value_by_id(ItemIDType id) const {
+    ACCESSOR_FORCE_INLINE ValueType get_value_by_id(ItemIDType id) const {
         require_permission<Mode, AccessMode::Read>();
+#if ACCESSOR_ENABLE_TRACING
+        detail::trace_access(&data_ref, Mode, id, AccessKind::Read);
+#endif
         return TraitsType::get_value_by_id_impl(data_ref, id);
     }
 
     /// @brief Set a value by its ID
     /// @param id The ID of the item to modify
     /// @param new_value The new value to set
-    void set_value_by_id(ItemIDType id, ValueType new_value) {
+    ACCESSOR_FORCE_INLINE void set_value_by_id(ItemIDType id, ValueType new_value) {
         require_permission<Mode, AccessMode::Write>();
+#if ACCESSOR_ENABLE_TRACING
+        detail::trace_access(&data_ref, Mode, id, AccessKind::Write);
+#endif
         TraitsType::set_value_by_id_impl(data_ref, id, new_value);
     }
 
+    /// @brief Combine a term into the value stored at an ID
+    /// @tparam ReduceOp Associative, commutative binary operator
+    /// @param id The ID of the item to update
+    /// @param term The value to combine in
+    /// @param op The reduction operator
+    template<typename ReduceOp = std::plus<ValueType>>
+    ACCESSOR_FORCE_INLINE void reduce_value_by_id(ItemIDType id, ValueType term, ReduceOp op = {}) {
+        require_permission<Mode, AccessMode::Reduce>();
+#if ACCESSOR_ENABLE_TRACING
+        detail::trace_access(&data_ref, Mode, id, AccessKind::Reduce);
+#endif
+        TraitsType::apply_reduction_impl(data_ref, id, term, op,
+            ReduceSemanticsPolicy<DS_Type, ValueType, ReduceOp>::impl_kind);
+    }
+
     /// @brief Get a view of the data structure
     /// @tparam ViewSpecifierTag The type of view to get
     /// @tparam ViewArgs Additional arguments for view creation
@@ -47,16 +80,37 @@ public:
     /// @param args Additional arguments for view creation
     /// @return The requested view
     template<typename ViewSpecifierTag, typename... ViewArgs>
-    auto get_view(ItemIDType id_for_view_context, 
+    ACCESSOR_FORCE_INLINE auto get_view(ItemIDType id_for_view_context, 
                  ViewSpecifierTag tag,
                  ViewArgs&&... args) const {
         require_permission<Mode, AccessMode::Read>();
         static_assert(TraitsType::template supports_view<ViewSpecifierTag>,
             "This data structure does not support the requested view type");
+#if ACCESSOR_ENABLE_TRACING
+        detail::trace_access(&data_ref, Mode, id_for_view_context, AccessKind::View);
+#endif
         return TraitsType::get_view_impl(data_ref, id_for_view_context, tag, 
             std::forward<ViewArgs>(args)...);
     }
 
+    /// @brief Pointer to the elements of a contiguous structure, indexed by id
+    ///
+    /// For hand-written inner loops; const for Read accessors. Accesses
+    /// through the pointer are invisible to access tracing, so a traced loop
+    /// that calls this is reported opaque and keeps its auto-buffer.
+    /// @return const ValueType* for Read, ValueType* for Write and ReadWrite
+    ACCESSOR_FORCE_INLINE auto raw_data() const requires ContiguousStructure<DS_Type> {
+        static_assert(Mode != AccessMode::Reduce, "Reduce accessors do not expose raw data");
+#if ACCESSOR_ENABLE_TRACING
+        detail::trace_access(&data_ref, Mode, size_t{0}, AccessKind::Raw);
+#endif
+        if constexpr (Mode == AccessMode::Read) {
+            return static_cast<const ValueType*>(TraitsType::contiguous_data(data_ref));
+        } else {
+            return TraitsType::contiguous_data(data_ref);
+        }
+    }
+
     DS_Type& data_ref;
 };
 
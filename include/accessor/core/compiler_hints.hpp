@@ -0,0 +1,21 @@
+#pragma once
+
+/// ACCESSOR_FORCE_INLINE: the accessor hot path (Accessor member functions,
+/// traits element access, the per-iteration step of custom_parallel_for)
+/// must inline into the user kernel even at -O1 or with large kernels.
+/// ACCESSOR_FORCE_INLINE_LAMBDA is the same hint placed after a lambda's
+/// parameter list. ACCESSOR_RESTRICT marks raw pointers that never alias
+/// the other pointers of the same call.
+#if defined(__GNUC__) || defined(__clang__)
+#define ACCESSOR_FORCE_INLINE inline __attribute__((always_inline))
+#define ACCESSOR_FORCE_INLINE_LAMBDA __attribute__((always_inline))
+#define ACCESSOR_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define ACCESSOR_FORCE_INLINE __forceinline
+#define ACCESSOR_FORCE_INLINE_LAMBDA
+#define ACCESSOR_RESTRICT __restrict
+#else
+#define ACCESSOR_FORCE_INLINE inline
+#define ACCESSOR_FORCE_INLINE_LAMBDA
+#define ACCESSOR_RESTRICT
+#endif
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <accessor/traits/data_structure_traits.hpp>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace accessor {
+
+/// @brief Device-side form of an iteration space (design draft 2.5.2)
+template<typename PodType, typename ItemIDT>
+concept DeviceIterationSpacePodConcept = requires(const PodType pod, size_t global_idx) {
+    { pod.device_size() } -> std::same_as<size_t>;
+    { pod.device_get_item_id(global_idx) } -> std::same_as<ItemIDT>;
+};
+
+/// @brief What custom_parallel_for needs from an iteration space: a size and
+/// the item id at each position in [0, size())
+template<typename T>
+concept IterationSpace = requires(const T space, size_t global_idx) {
+    { space.size() } -> std::convertible_to<size_t>;
+    space[global_idx];
+};
+
+/// @brief Full interface of the IterateOver::* spaces (design draft 2.5.3)
+///
+/// DevicePodType may be void while no device back end exists.
+template<typename T>
+concept DeviceIterationSpace = IterationSpace<T> && requires(const T space, size_t global_idx) {
+    typename T::ItemIDType;
+    { space[global_idx] } -> std::same_as<typename T::ItemIDType>;
+    typename T::DevicePodType;
+    requires std::is_void_v<typename T::DevicePodType> ||
+             DeviceIterationSpacePodConcept<typename T::DevicePodType, typename T::ItemIDType>;
+    { space.to_device_pod() } -> std::same_as<typename T::DevicePodType>;
+};
+
+/// @brief DataStructureTraits is specialized for DS (design draft 2.3)
+template<typename DS>
+concept HasDataStructureTraits = requires {
+    typename DataStructureTraits<DS>::ItemIDType;
+    typename DataStructureTraits<DS>::ValueType;
+} && !std::is_void_v<typename DataStructureTraits<DS>::ItemIDType>;
+
+/// @brief The traits provide get_value_by_id_impl
+template<typename DS>
+concept ValueReadableStructure = HasDataStructureTraits<DS> &&
+    requires(const DS& ds, typename DataStructureTraits<DS>::ItemIDType id) {
+        { DataStructureTraits<DS>::get_value_by_id_impl(ds, id) }
+            -> std::convertible_to<typename DataStructureTraits<DS>::ValueType>;
+    };
+
+/// @brief The traits provide set_value_by_id_impl
+template<typename DS>
+concept ValueWritableStructure = HasDataStructureTraits<DS> &&
+    requires(DS& ds, typename DataStructureTraits<DS>::ItemIDType id, typename DataStructureTraits<DS>::ValueType v) {
+        DataStructureTraits<DS>::set_value_by_id_impl(ds, id, v);
+    };
+
+/// @brief Elements are stored contiguously, unconverted, and indexed by their id
+///
+/// The traits expose them through `static ValueType* contiguous_data(DS&)`;
+/// Accessor::raw_data() then hands out a plain pointer for fast paths.
+template<typename DS>
+concept ContiguousStructure = HasDataStructureTraits<DS> &&
+    std::same_as<typename DataStructureTraits<DS>::ItemIDType, size_t> &&
+    requires(DS& ds) {
+        { DataStructureTraits<DS>::contiguous_data(ds) } -> std::same_as<typename DataStructureTraits<DS>::ValueType*>;
+    };
+
+} // namespace accessor
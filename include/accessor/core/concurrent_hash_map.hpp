@@ -0,0 +1,363 @@
+#pragma once
+
+#include <accessor/core/parallel_compact.hpp>
+#include <accessor/core/reduce_policy.hpp>
+#include <accessor/iteration/range.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <omp.h>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace accessor {
+
+namespace detail {
+
+/// @brief Finalizer of MurmurHash3, spreads weak hashes (std::hash of
+///        integers is the identity) over the low bits used for slot masks
+inline size_t mix_hash(size_t h) {
+    uint64_t x = h;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+}
+
+/// @brief Single-owner linear-probing table holding one thread's partial
+///        reduction results
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+struct LocalAggregationTable {
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    std::vector<uint8_t> used;
+    size_t count = 0;
+    std::function<Value(const Value&, const Value&)> combine;  ///< Operator of the pending loop
+
+    template<typename ReduceOp>
+    void reduce(const Key& key, const Value& term, ReduceOp& op, const Hash& hash, const KeyEqual& equal) {
+        if (2 * (count + 1) > keys.size()) {
+            grow(hash);
+        }
+        const size_t mask = keys.size() - 1;
+        size_t i = mix_hash(hash(key)) & mask;
+        while (used[i]) {
+            if (equal(keys[i], key)) {
+                values[i] = op(values[i], term);
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+        used[i] = 1;
+        keys[i] = key;
+        values[i] = term;
+        ++count;
+    }
+
+    void grow(const Hash& hash) {
+        std::vector<Key> old_keys = std::move(keys);
+        std::vector<Value> old_values = std::move(values);
+        std::vector<uint8_t> old_used = std::move(used);
+        const size_t capacity = std::max<size_t>(64, 2 * old_keys.size());
+        keys.assign(capacity, Key{});
+        values.assign(capacity, Value{});
+        used.assign(capacity, 0);
+        const size_t mask = capacity - 1;
+        for (size_t s = 0; s < old_keys.size(); ++s) {
+            if (!old_used[s]) continue;
+            size_t i = mix_hash(hash(old_keys[s])) & mask;
+            while (used[i]) i = (i + 1) & mask;
+            used[i] = 1;
+            keys[i] = old_keys[s];
+            values[i] = old_values[s];
+        }
+    }
+
+    void clear() {
+        if (count != 0) {
+            std::fill(used.begin(), used.end(), uint8_t{0});
+            count = 0;
+        }
+        combine = nullptr;
+    }
+};
+
+} // namespace detail
+
+/// @brief Fixed-capacity concurrent hash map with open addressing
+///
+/// Linear probing over a power-of-two slot array. A slot is claimed by a
+/// compare-and-swap of its state byte (empty -> busy), the key and initial
+/// value are written, and the slot is published as full with a release
+/// store; lookups that meet a busy slot wait for it. Values are updated
+/// with atomic loads/stores and compare-and-swap loops, so insert, assign,
+/// reduce and lookup may all run concurrently. Entries are never erased
+/// individually and the table does not grow while shared: size it with the
+/// expected number of distinct keys, or call rehash() between loops.
+///
+/// Reductions either update the shared table directly
+/// (ReduceImplKind::DeviceAtomic) or aggregate into per-thread partial
+/// tables (ReduceImplKind::LocalBufferAndFinalReduce) that flush_partials()
+/// merges; custom_parallel_for calls it when a Reduce accessor's loop ends.
+/// Per-thread tables pay off for skewed keys, where a few hot slots would
+/// otherwise bounce between cores. Only outermost loops (omp_get_level()
+/// == 1) use them: a region nested in another one numbers its threads from
+/// 0 again, so nested loops and serial callers reduce into the shared table.
+/// @tparam Key Trivially copyable key type
+/// @tparam Value Trivially copyable value type usable with std::atomic_ref
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class ConcurrentHashMap {
+    static_assert(std::is_trivially_copyable_v<Key>, "ConcurrentHashMap keys must be trivially copyable");
+    static_assert(std::is_trivially_copyable_v<Value>, "ConcurrentHashMap values must be trivially copyable");
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+
+    static constexpr uint8_t slot_empty = 0;
+    static constexpr uint8_t slot_busy = 1;
+    static constexpr uint8_t slot_full = 2;
+
+    /// @param expected_entries Number of distinct keys the table must hold
+    ///        (capacity is at least twice that, rounded to a power of two)
+    explicit ConcurrentHashMap(size_t expected_entries = 0, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : hash_(hash), equal_(equal) {
+        allocate(capacity_for(expected_entries));
+        partials_.resize(static_cast<size_t>(omp_get_max_threads()));
+    }
+
+    size_t size() const { return std::atomic_ref<size_t>(const_cast<size_t&>(size_)).load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return keys_.size(); }
+
+    /// @brief Strategy used when the reduce policy leaves the choice open
+    ReduceImplKind reduce_strategy() const { return reduce_strategy_; }
+    void set_reduce_strategy(ReduceImplKind kind) { reduce_strategy_ = kind; }
+
+    /// @brief Insert a key or overwrite its value
+    void insert_or_assign(const Key& key, const Value& value) {
+        bool inserted;
+        size_t slot = find_or_insert(key, value, inserted);
+        if (!inserted) {
+            std::atomic_ref<Value>(values_[slot]).store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Combine a term into the value of a key; an absent key starts at term
+    template<typename ReduceOp>
+    void reduce(const Key& key, const Value& term, ReduceOp op) {
+        bool inserted;
+        size_t slot = find_or_insert(key, term, inserted);
+        if (inserted) {
+            return;
+        }
+        std::atomic_ref<Value> value(values_[slot]);
+        if constexpr (std::is_integral_v<Value> &&
+                      (std::is_same_v<ReduceOp, std::plus<Value>> || std::is_same_v<ReduceOp, std::plus<>>)) {
+            value.fetch_add(term, std::memory_order_relaxed);
+        } else {
+            Value current = value.load(std::memory_order_relaxed);
+            while (!value.compare_exchange_weak(current, op(current, term), std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    /// @brief Combine a term into the calling thread's partial table
+    ///
+    /// The result becomes visible in the shared table after flush_partials().
+    /// All pending local reductions of one loop must use the same operator.
+    /// Outside the outermost parallel region the term goes to the shared table.
+    template<typename ReduceOp>
+    void reduce_local(const Key& key, const Value& term, ReduceOp op) {
+        const size_t tid = static_cast<size_t>(omp_get_thread_num());
+        if (omp_get_level() != 1 || tid >= partials_.size()) {
+            // Nested or serial caller, or more threads than when the map was last prepared
+            reduce(key, term, op);
+            return;
+        }
+        auto& partial = partials_[tid];
+        if (!partial.combine) {
+            partial.combine = op;
+        }
+        partial.reduce(key, term, op, hash_, equal_);
+    }
+
+    /// @brief Merge all per-thread partial tables into the shared table
+    ///
+    /// Inside the outermost parallel region (a loop nested in a per-thread
+    /// kernel finishing) only the calling thread's own table is merged, as
+    /// the other threads may still be filling theirs; deeper levels have no
+    /// tables of their own and merge nothing.
+    void flush_partials() {
+        const int level = omp_get_level();
+        if (level > 0) {
+            const size_t tid = static_cast<size_t>(omp_get_thread_num());
+            if (level == 1 && tid < partials_.size()) {
+                flush_partial(partials_[tid]);
+            }
+            return;
+        }
+        const long long num_partials = static_cast<long long>(partials_.size());
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long t = 0; t < num_partials; ++t) {
+            flush_partial(partials_[static_cast<size_t>(t)]);
+        }
+        const size_t threads = static_cast<size_t>(omp_get_max_threads());
+        if (partials_.size() < threads) {
+            partials_.resize(threads);
+        }
+    }
+
+    /// @brief Look up a key
+    /// @return true and the value in `value` when the key is present
+    bool find(const Key& key, Value& value) const {
+        size_t slot;
+        if (!find_slot(key, slot)) {
+            return false;
+        }
+        value = std::atomic_ref<Value>(const_cast<Value&>(values_[slot])).load(std::memory_order_relaxed);
+        return true;
+    }
+
+    bool contains(const Key& key) const {
+        size_t slot;
+        return find_slot(key, slot);
+    }
+
+    Value value_or(const Key& key, const Value& fallback) const {
+        Value value;
+        return find(key, value) ? value : fallback;
+    }
+
+    /// @brief Slot-level access for iteration; valid for occupied slots only
+    bool occupied(size_t slot) const {
+        return std::atomic_ref<uint8_t>(const_cast<uint8_t&>(states_[slot])).load(std::memory_order_acquire) == slot_full;
+    }
+    const Key& key_at(size_t slot) const { return keys_[slot]; }
+    const Value& value_at(size_t slot) const { return values_[slot]; }
+
+    /// @brief Keys of all entries, in slot order (parallel compaction)
+    std::vector<Key> keys() const {
+        std::vector<size_t> slots = parallel_compact(IterateOver::Range1D(capacity()),
+                                                     [this](size_t s) { return occupied(s); });
+        std::vector<Key> result(slots.size());
+        const long long n = static_cast<long long>(slots.size());
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n; ++i) {
+            result[static_cast<size_t>(i)] = keys_[slots[static_cast<size_t>(i)]];
+        }
+        return result;
+    }
+
+    /// @brief Remove all entries, keeping the capacity (not concurrent)
+    void clear() {
+        std::fill(states_.begin(), states_.end(), slot_empty);
+        size_ = 0;
+        for (auto& partial : partials_) {
+            partial.clear();
+        }
+    }
+
+    /// @brief Resize to hold expected_entries keys and reinsert (not concurrent)
+    void rehash(size_t expected_entries) {
+        ConcurrentHashMap bigger(std::max(expected_entries, size()), hash_, equal_);
+        bigger.reduce_strategy_ = reduce_strategy_;
+        for (size_t s = 0; s < capacity(); ++s) {
+            if (states_[s] == slot_full) {
+                bigger.insert_or_assign(keys_[s], values_[s]);
+            }
+        }
+        *this = std::move(bigger);
+    }
+
+private:
+    void flush_partial(detail::LocalAggregationTable<Key, Value, Hash, KeyEqual>& partial) {
+        for (size_t s = 0; s < partial.keys.size() && partial.count != 0; ++s) {
+            if (partial.used[s]) {
+                reduce(partial.keys[s], partial.values[s], partial.combine);
+            }
+        }
+        partial.clear();
+    }
+
+    static size_t capacity_for(size_t expected_entries) {
+        return std::bit_ceil(std::max<size_t>(16, 2 * expected_entries));
+    }
+
+    void allocate(size_t capacity) {
+        keys_.assign(capacity, Key{});
+        values_.assign(capacity, Value{});
+        states_.assign(capacity, slot_empty);
+        size_ = 0;
+    }
+
+    size_t home_slot(const Key& key) const {
+        return detail::mix_hash(hash_(key)) & (capacity() - 1);
+    }
+
+    /// @brief Slot of key, claiming an empty one with `initial` if absent
+    size_t find_or_insert(const Key& key, const Value& initial, bool& inserted) {
+        const size_t mask = capacity() - 1;
+        size_t i = home_slot(key);
+        for (size_t probe = 0; probe <= mask; ++probe, i = (i + 1) & mask) {
+            std::atomic_ref<uint8_t> state(states_[i]);
+            uint8_t s = state.load(std::memory_order_acquire);
+            if (s == slot_empty) {
+                if (state.compare_exchange_strong(s, slot_busy, std::memory_order_acquire)) {
+                    keys_[i] = key;
+                    values_[i] = initial;
+                    state.store(slot_full, std::memory_order_release);
+                    std::atomic_ref<size_t>(size_).fetch_add(1, std::memory_order_relaxed);
+                    inserted = true;
+                    return i;
+                }
+                // Lost the race; s now holds the winner's state
+            }
+            while (s == slot_busy) {
+                s = state.load(std::memory_order_acquire);
+            }
+            if (equal_(keys_[i], key)) {
+                inserted = false;
+                return i;
+            }
+        }
+        throw std::length_error("ConcurrentHashMap: table is full");
+    }
+
+    bool find_slot(const Key& key, size_t& slot) const {
+        const size_t mask = capacity() - 1;
+        size_t i = home_slot(key);
+        for (size_t probe = 0; probe <= mask; ++probe, i = (i + 1) & mask) {
+            std::atomic_ref<uint8_t> state(const_cast<uint8_t&>(states_[i]));
+            uint8_t s = state.load(std::memory_order_acquire);
+            while (s == slot_busy) {
+                s = state.load(std::memory_order_acquire);
+            }
+            if (s == slot_empty) {
+                return false;
+            }
+            if (equal_(keys_[i], key)) {
+                slot = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<Key> keys_;
+    std::vector<Value> values_;
+    std::vector<uint8_t> states_;
+    size_t size_ = 0;
+    Hash hash_;
+    KeyEqual equal_;
+    ReduceImplKind reduce_strategy_ = ReduceImplKind::DeviceAtomic;
+    std::vector<detail::LocalAggregationTable<Key, Value, Hash, KeyEqual>> partials_;
+};
+
+} // namespace accessor
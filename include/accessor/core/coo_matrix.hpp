@@ -0,0 +1,18 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+struct COOMatrix {
+    size_t num_rows = 0;
+    size_t num_cols = 0;
+    std::vector<size_t> row_indices;   // 三元组行索引 (无序, 可重复)
+    std::vector<size_t> col_indices;   // 三元组列索引
+    std::vector<float> values;         // 三元组值, 重复位置在转换时求和
+
+    size_t num_entries() const { return values.size(); }
+    void add(size_t row, size_t col, float value) {
+        row_indices.push_back(row);
+        col_indices.push_back(col);
+        values.push_back(value);
+    }
+};
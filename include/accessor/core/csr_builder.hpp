@@ -0,0 +1,173 @@
+#pragma once
+
+#include "accessor.hpp"
+#include "coo_matrix.hpp"
+#include "csr_matrix.hpp"
+#include "custom_parallel_scan.hpp"
+#include <accessor/iteration/range.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Sparsity pattern recorded by a COO->CSR build
+///
+/// Besides the CSR structure it keeps, for every CSR nonzero, the list of
+/// triplets that were merged into it (sorted by triplet index). A later
+/// assembly that emits the same (row, col) sequence only gathers values.
+struct CSRAssemblyPattern {
+    size_t num_rows = 0;
+    size_t num_entries = 0;
+    std::vector<size_t> row_ptr;
+    std::vector<size_t> col_indices;
+    std::vector<size_t> entry_ptr;  ///< Size nnz+1: triplet range of each nonzero
+    std::vector<size_t> entry_src;  ///< Triplet indices grouped by nonzero
+
+    size_t num_nonzeros() const { return col_indices.size(); }
+    bool empty() const { return row_ptr.empty(); }
+};
+
+namespace detail {
+
+struct ColumnEntry {
+    size_t col;
+    size_t src;
+    bool operator<(const ColumnEntry& other) const {
+        return col < other.col || (col == other.col && src < other.src);
+    }
+};
+
+inline void exclusive_scan_in_place(std::vector<size_t>& counts) {
+    Accessor<std::vector<size_t>, AccessMode::Read> in(counts);
+    Accessor<std::vector<size_t>, AccessMode::Write> out(counts);
+    custom_parallel_scan(IterateOver::Range1D(counts.size()), ScanKind::Exclusive, size_t{0}, std::plus<>{}, in, out);
+}
+
+// Index arrays of allocator-aware matrices are scanned through a heap copy
+template<typename Alloc>
+void exclusive_scan_in_place(std::vector<size_t, Alloc>& counts) {
+    std::vector<size_t> scanned(counts.begin(), counts.end());
+    exclusive_scan_in_place(scanned);
+    std::copy(scanned.begin(), scanned.end(), counts.begin());
+}
+
+} // namespace detail
+
+/// @brief Compute the CSR structure of a triplet list
+///
+/// Row histogram, prefix sum, scatter into row buckets, then a per-row sort
+/// by (col, triplet index) and duplicate merge. Sorting by triplet index
+/// inside a duplicate group makes the value sums independent of the thread
+/// count. Row and column indices must be in range.
+inline CSRAssemblyPattern build_csr_pattern(const COOMatrix& coo) {
+    const size_t n_rows = coo.num_rows;
+    const size_t n_entries = coo.num_entries();
+    const long long n_entries_ll = static_cast<long long>(n_entries);
+    const long long n_rows_ll = static_cast<long long>(n_rows);
+
+    CSRAssemblyPattern pattern;
+    pattern.num_rows = n_rows;
+    pattern.num_entries = n_entries;
+
+    // 1. Row histogram
+    std::vector<size_t> bucket_start(n_rows + 1, 0);
+    #pragma omp parallel for schedule(static)
+    for (long long k = 0; k < n_entries_ll; ++k) {
+        std::atomic_ref<size_t>(bucket_start[coo.row_indices[k]]).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 2. Prefix sum -> bucket offsets
+    detail::exclusive_scan_in_place(bucket_start);
+
+    // 3. Scatter triplets into row buckets
+    std::vector<detail::ColumnEntry> buckets(n_entries);
+    std::vector<size_t> cursor(bucket_start.begin(), bucket_start.end() - 1);
+    #pragma omp parallel for schedule(static)
+    for (long long k = 0; k < n_entries_ll; ++k) {
+        size_t pos = std::atomic_ref<size_t>(cursor[coo.row_indices[k]]).fetch_add(1, std::memory_order_relaxed);
+        buckets[pos] = detail::ColumnEntry{coo.col_indices[k], static_cast<size_t>(k)};
+    }
+
+    // 4. Per-row sort and count distinct columns
+    pattern.row_ptr.assign(n_rows + 1, 0);
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long r = 0; r < n_rows_ll; ++r) {
+        auto first = buckets.begin() + static_cast<std::ptrdiff_t>(bucket_start[r]);
+        auto last = buckets.begin() + static_cast<std::ptrdiff_t>(bucket_start[r + 1]);
+        std::sort(first, last);
+        size_t distinct = 0;
+        for (auto it = first; it != last; ++it) {
+            if (it == first || it->col != (it - 1)->col) ++distinct;
+        }
+        pattern.row_ptr[r] = distinct;
+    }
+    detail::exclusive_scan_in_place(pattern.row_ptr);
+
+    // 5. Emit columns and the triplet groups of each nonzero
+    const size_t nnz = pattern.row_ptr[n_rows];
+    pattern.col_indices.resize(nnz);
+    pattern.entry_ptr.resize(nnz + 1);
+    pattern.entry_src.resize(n_entries);
+    pattern.entry_ptr[nnz] = n_entries;
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long r = 0; r < n_rows_ll; ++r) {
+        size_t out = pattern.row_ptr[r];
+        for (size_t b = bucket_start[r]; b < bucket_start[r + 1]; ++b) {
+            if (b == bucket_start[r] || buckets[b].col != buckets[b - 1].col) {
+                pattern.col_indices[out] = buckets[b].col;
+                pattern.entry_ptr[out] = b;
+                ++out;
+            }
+            pattern.entry_src[b] = buckets[b].src;
+        }
+    }
+    return pattern;
+}
+
+/// @brief Gather triplet values into an existing pattern (numeric phase)
+/// @param coo Triplets in the same (row, col) order as when pattern was built
+/// @param pattern Pattern from build_csr_pattern
+/// @param mat Output; its structure is replaced by the pattern's unless it already equals it
+/// @throws std::invalid_argument if coo's row or triplet count differs from the pattern's
+inline void assemble_csr_values(const COOMatrix& coo, const CSRAssemblyPattern& pattern, CSRMatrix& mat) {
+    if (coo.num_rows != pattern.num_rows || coo.num_entries() != pattern.num_entries) {
+        throw std::invalid_argument("assemble_csr_values: triplets do not match the pattern");
+    }
+    const size_t nnz = pattern.num_nonzeros();
+    // Comparing only reads; a matching structure is the common case
+    if (mat.row_ptr != pattern.row_ptr) mat.row_ptr = pattern.row_ptr;
+    if (mat.col_indices != pattern.col_indices) mat.col_indices = pattern.col_indices;
+    mat.values.resize(nnz);
+
+    const long long nnz_ll = static_cast<long long>(nnz);
+    #pragma omp parallel for schedule(static)
+    for (long long j = 0; j < nnz_ll; ++j) {
+        float sum = 0.0f;
+        for (size_t e = pattern.entry_ptr[j]; e < pattern.entry_ptr[j + 1]; ++e) {
+            sum += coo.values[pattern.entry_src[e]];
+        }
+        mat.values[j] = sum;
+    }
+}
+
+/// @brief Build a CSRMatrix from unsorted triplets, summing duplicates
+inline CSRMatrix coo_to_csr(const COOMatrix& coo) {
+    CSRAssemblyPattern pattern = build_csr_pattern(coo);
+    CSRMatrix mat;
+    assemble_csr_values(coo, pattern, mat);
+    return mat;
+}
+
+/// @brief Build a CSRMatrix and keep the pattern for later value-only assemblies
+inline CSRMatrix coo_to_csr(const COOMatrix& coo, CSRAssemblyPattern& pattern) {
+    pattern = build_csr_pattern(coo);
+    CSRMatrix mat;
+    assemble_csr_values(coo, pattern, mat);
+    return mat;
+}
+
+} // namespace accessor
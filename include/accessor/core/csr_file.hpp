@@ -0,0 +1,146 @@
+#pragma once
+#include <accessor/core/csr_matrix.hpp>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Header of the binary CSR file format
+///
+/// Layout: header, row_ptr (uint64, num_rows + 1), col_indices (uint64,
+/// num_nonzeros), values (value_bytes each, num_nonzeros). Every section
+/// starts on a kAlignment boundary so row blocks can be read with O_DIRECT.
+struct CSRFileHeader {
+    static constexpr size_t kAlignment = 4096;
+    static constexpr char kMagic[8] = {'A', 'C', 'C', 'C', 'S', 'R', '0', '1'};
+
+    char magic[8];
+    uint64_t value_bytes;
+    uint64_t num_rows;
+    uint64_t num_nonzeros;
+    uint64_t row_ptr_offset;
+    uint64_t col_indices_offset;
+    uint64_t values_offset;
+
+    static uint64_t align_up(uint64_t n) { return (n + kAlignment - 1) / kAlignment * kAlignment; }
+
+    static CSRFileHeader describe(size_t value_bytes, size_t num_rows, size_t num_nonzeros) {
+        CSRFileHeader h{};
+        std::memcpy(h.magic, kMagic, sizeof(kMagic));
+        h.value_bytes = value_bytes;
+        h.num_rows = num_rows;
+        h.num_nonzeros = num_nonzeros;
+        h.row_ptr_offset = align_up(sizeof(CSRFileHeader));
+        h.col_indices_offset = align_up(h.row_ptr_offset + (num_rows + 1) * sizeof(uint64_t));
+        h.values_offset = align_up(h.col_indices_offset + num_nonzeros * sizeof(uint64_t));
+        return h;
+    }
+
+    uint64_t file_size() const { return values_offset + num_nonzeros * value_bytes; }
+};
+
+static_assert(sizeof(size_t) == sizeof(uint64_t), "CSR files store indices as 64-bit size_t");
+
+namespace detail {
+
+/// @brief pread until count bytes arrived; throws on error or early EOF
+inline void pread_fully(int fd, void* dst, size_t count, uint64_t offset) {
+    char* out = static_cast<char*>(dst);
+    while (count > 0) {
+        const ssize_t n = ::pread(fd, out, count, static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            throw std::runtime_error(n == 0 ? "CSR file: unexpected end of file"
+                                            : std::string("CSR file: read failed: ") + std::strerror(errno));
+        }
+        out += n;
+        count -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+}
+
+inline void pwrite_fully(int fd, const void* src, size_t count, uint64_t offset) {
+    const char* in = static_cast<const char*>(src);
+    while (count > 0) {
+        const ssize_t n = ::pwrite(fd, in, count, static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            throw std::runtime_error(std::string("CSR file: write failed: ") + std::strerror(errno));
+        }
+        in += n;
+        count -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+}
+
+/// @brief Read and validate the header of an open CSR file
+template<typename StorageT>
+CSRFileHeader read_csr_header(int fd) {
+    CSRFileHeader h;
+    pread_fully(fd, &h, sizeof(h), 0);
+    if (std::memcmp(h.magic, CSRFileHeader::kMagic, sizeof(h.magic)) != 0) {
+        throw std::runtime_error("CSR file: bad magic");
+    }
+    if (h.value_bytes != sizeof(StorageT)) {
+        throw std::runtime_error("CSR file: value size does not match the storage type");
+    }
+    return h;
+}
+
+} // namespace detail
+
+/// @brief Write a matrix in the binary CSR file format
+template<typename S, typename C, typename A>
+void write_csr_file(const std::string& path, const CSRMatrixT<S, C, A>& mat) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("write_csr_file: cannot open " + path);
+    }
+    try {
+        const CSRFileHeader h = CSRFileHeader::describe(sizeof(S), mat.num_rows(), mat.num_nonzeros());
+        detail::pwrite_fully(fd, &h, sizeof(h), 0);
+        detail::pwrite_fully(fd, mat.row_ptr.data(), mat.row_ptr.size() * sizeof(size_t), h.row_ptr_offset);
+        detail::pwrite_fully(fd, mat.col_indices.data(), mat.col_indices.size() * sizeof(size_t), h.col_indices_offset);
+        detail::pwrite_fully(fd, mat.values.data(), mat.values.size() * sizeof(S), h.values_offset);
+        if (::ftruncate(fd, static_cast<off_t>(h.file_size())) != 0) {
+            throw std::runtime_error("write_csr_file: cannot size " + path);
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+/// @brief Read a whole binary CSR file into memory
+template<typename S, typename C = default_compute_type_t<S>>
+CSRMatrixT<S, C> read_csr_file(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("read_csr_file: cannot open " + path);
+    }
+    CSRMatrixT<S, C> mat;
+    try {
+        const CSRFileHeader h = detail::read_csr_header<S>(fd);
+        mat.row_ptr.resize(h.num_rows + 1);
+        mat.col_indices.resize(h.num_nonzeros);
+        mat.values.resize(h.num_nonzeros);
+        detail::pread_fully(fd, mat.row_ptr.data(), mat.row_ptr.size() * sizeof(size_t), h.row_ptr_offset);
+        detail::pread_fully(fd, mat.col_indices.data(), mat.col_indices.size() * sizeof(size_t), h.col_indices_offset);
+        detail::pread_fully(fd, mat.values.data(), mat.values.size() * sizeof(S), h.values_offset);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+    return mat;
+}
+
+} // namespace accessor
@@ -1,12 +1,68 @@
 #pragma once
+#include <accessor/core/low_precision.hpp>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <cstddef>
 
-struct CSRMatrix {
-    std::vector<float> values;         // 非零值
-    std::vector<size_t> col_indices;   // 非零元素对应的列索引
-    std::vector<size_t> row_ptr;       // 每行第一个非零元素的起始偏移 (大小为num_rows+1)
+/// @brief CSR matrix with separate storage and compute precision
+/// @tparam ValueStorageT Type the nonzeros are stored as (float, double,
+///         accessor::half, accessor::bfloat16)
+/// @tparam ComputeT Type accessors and row views hand to kernels
+/// @tparam Allocator Allocator of the values, rebound for the index arrays
+template<typename ValueStorageT = float, typename ComputeT = accessor::default_compute_type_t<ValueStorageT>,
+         typename Allocator = std::allocator<ValueStorageT>>
+struct CSRMatrixT {
+    using StorageType = ValueStorageT;
+    using ComputeType = ComputeT;
+    using allocator_type = Allocator;
+    using IndexAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>;
+
+    std::vector<ValueStorageT, Allocator> values; // 非零值
+    std::vector<size_t, IndexAllocator> col_indices;   // 非零元素对应的列索引
+    std::vector<size_t, IndexAllocator> row_ptr;       // 每行第一个非零元素的起始偏移 (大小为num_rows+1)
+
+    CSRMatrixT() = default;
+    explicit CSRMatrixT(const Allocator& alloc)
+        : values(alloc), col_indices(IndexAllocator(alloc)), row_ptr(IndexAllocator(alloc)) {}
+    CSRMatrixT(const CSRMatrixT& other, const Allocator& alloc)
+        : values(other.values, alloc), col_indices(other.col_indices, IndexAllocator(alloc)),
+          row_ptr(other.row_ptr, IndexAllocator(alloc)) {}
+    CSRMatrixT(const CSRMatrixT&) = default;
+    CSRMatrixT(CSRMatrixT&&) = default;
+    CSRMatrixT& operator=(const CSRMatrixT&) = default;
+    CSRMatrixT& operator=(CSRMatrixT&&) = default;
+
+    allocator_type get_allocator() const { return values.get_allocator(); }
 
     size_t num_rows() const { return row_ptr.empty() ? 0 : row_ptr.size() - 1; }
     size_t num_nonzeros() const { return values.size(); }
-}; 
\ No newline at end of file
+};
+
+using CSRMatrix = CSRMatrixT<float>;
+
+namespace accessor::pmr {
+
+/// @brief CSRMatrixT whose arrays come from a std::pmr::memory_resource
+template<typename ValueStorageT = float, typename ComputeT = accessor::default_compute_type_t<ValueStorageT>>
+using CSRMatrixT = ::CSRMatrixT<ValueStorageT, ComputeT, std::pmr::polymorphic_allocator<ValueStorageT>>;
+using CSRMatrix = CSRMatrixT<float>;
+
+} // namespace accessor::pmr
+
+/// @brief Same pattern, values converted to another storage precision
+template<typename ToStorageT, typename ToComputeT = accessor::default_compute_type_t<ToStorageT>,
+         typename FromStorageT, typename FromComputeT, typename FromAlloc>
+CSRMatrixT<ToStorageT, ToComputeT> convert_precision(const CSRMatrixT<FromStorageT, FromComputeT, FromAlloc>& src) {
+    CSRMatrixT<ToStorageT, ToComputeT> dst;
+    dst.row_ptr.assign(src.row_ptr.begin(), src.row_ptr.end());
+    dst.col_indices.assign(src.col_indices.begin(), src.col_indices.end());
+    dst.values.resize(src.values.size());
+    const long long nnz = static_cast<long long>(src.values.size());
+    #pragma omp parallel for schedule(static)
+    for (long long k = 0; k < nnz; ++k) {
+        dst.values[static_cast<size_t>(k)] = accessor::to_storage<ToStorageT>(
+            accessor::to_compute<double>(src.values[static_cast<size_t>(k)]));
+    }
+    return dst;
+}
@@ -8,7 +8,15 @@
 #include <vector> // Required for std::vector
 #include <algorithm> // Required for std::find_if, std::any_of etc.
 #include <iostream> // Required for std::cout
-#include <any> // Required for std::any
+#include <array>
+#include <string>
+#include <memory_resource>
+#include <accessor/core/access_trace.hpp>
+#include <accessor/core/compiler_hints.hpp>
+#include <accessor/core/concepts.hpp>
+#include <accessor/core/loop_schedule.hpp>
+#include <accessor/core/memory_resource.hpp>
+#include <accessor/core/static_extent.hpp>
 #include <accessor/traits/dense_array_traits.hpp>
 
 namespace accessor {
@@ -43,7 +51,7 @@ constexpr auto get_access_mode(const Acc&) {
 // Structure to hold buffer requirement information
 struct BufferRequirement {
     bool needs_buffering = false;
-    std::vector<size_t> write_accessor_indices; // Indices of accessors that should write to a buffer
+    std::pmr::vector<size_t> write_accessor_indices; // Indices of accessors that should write to a buffer
     // We might need more info, e.g., which read accessors conflict with them.
     // For now, let's assume if a write accessor is part of any conflict, it needs buffering.
 };
@@ -107,8 +115,9 @@ void check_pair_for_conflict_recursive(const AccTuple& acc_tuple, BufferRequirem
 
 // Function to detect buffer requirements (uses recursive helper)
 template<typename... AccessorTypes>
-BufferRequirement detect_buffer_requirements(const std::tuple<AccessorTypes&...>& acc_tuple) {
-    BufferRequirement req;
+BufferRequirement detect_buffer_requirements(const std::tuple<AccessorTypes&...>& acc_tuple,
+                                             std::pmr::memory_resource* memory = std::pmr::get_default_resource()) {
+    BufferRequirement req{false, std::pmr::vector<size_t>(memory)};
     if constexpr (sizeof...(AccessorTypes) >= 2) {
         find_conflicts_for_accessor_i<0>(acc_tuple, req);
     }
@@ -120,16 +129,16 @@ BufferRequirement detect_buffer_requirements(const std::tuple<AccessorTypes&...>
 
 namespace detail {
 
-// Helper function to build the tuple of accessors for the kernel (moved into detail)
-template<typename OriginalTuple, typename BufferRequirementType, typename TempDataStorageType, std::size_t... Is>
+// Helper function to build the tuple of accessors for the kernel (moved into detail).
+// buffers[i] is the buffer copy of accessor i's data structure, or null.
+template<typename OriginalTuple, size_t N, std::size_t... Is>
 auto create_kernel_arg_accessors_tuple_impl(
     OriginalTuple& original_accessor_tuple,
-    BufferRequirementType& buffer_req,
-    TempDataStorageType& temp_data_storage,
+    const std::array<void*, N>& buffers,
     std::index_sequence<Is...> /*seq*/
 ) {
     auto construct_kernel_accessor =
-        [&original_accessor_tuple, &buffer_req, &temp_data_storage]
+        [&original_accessor_tuple, &buffers]
         (auto accessor_compile_time_idx_wrapper) {
         constexpr size_t accessor_compile_time_idx = decltype(accessor_compile_time_idx_wrapper)::value;
         auto& original_acc_ref = std::get<accessor_compile_time_idx>(original_accessor_tuple);
@@ -137,20 +146,8 @@ auto create_kernel_arg_accessors_tuple_impl(
         using DS_Type = std::remove_reference_t<decltype(original_acc_ref.data_ref)>;
         constexpr AccessMode mode = OriginalAccType::mode_value;
 
-        bool needs_buffering_for_this_one = false;
-        size_t buffer_storage_vector_idx = 0;
-        size_t count_write_accessors_processed = 0;
-        for(size_t write_idx_from_req : buffer_req.write_accessor_indices) {
-            if (accessor_compile_time_idx == write_idx_from_req) {
-                needs_buffering_for_this_one = true;
-                buffer_storage_vector_idx = count_write_accessors_processed;
-                break;
-            }
-            count_write_accessors_processed++;
-        }
-
-        if (needs_buffering_for_this_one) {
-            return Accessor<DS_Type, mode>(std::any_cast<DS_Type&>(temp_data_storage[buffer_storage_vector_idx]));
+        if (void* buffer = buffers[accessor_compile_time_idx]) {
+            return Accessor<DS_Type, mode>(*static_cast<DS_Type*>(buffer));
         } else {
             return Accessor<DS_Type, mode>(original_acc_ref.data_ref);
         }
@@ -158,24 +155,84 @@ auto create_kernel_arg_accessors_tuple_impl(
     return std::make_tuple(construct_kernel_accessor(std::integral_constant<size_t, Is>{})...);
 }
 
+// Buffer copy of a data structure, allocated from memory. Allocator-aware
+// structures (pmr::DenseArray1D, pmr::CSRMatrixT) get their elements from
+// memory as well (uses-allocator construction); others copy onto the heap.
+template<typename DS_Type>
+DS_Type* make_buffer_copy(const DS_Type& src, std::pmr::memory_resource* memory) {
+    return std::pmr::polymorphic_allocator<>(memory).new_object<DS_Type>(src);
+}
+
+
+// Tell an active trace which object each kernel accessor points at
+template<typename KernelTuple, typename OriginalTuple, size_t... Is>
+void register_traced_accessors(AccessTraceCollector* trace, KernelTuple& kernel_args, OriginalTuple& originals,
+                               const BufferRequirement& buffer_req, std::index_sequence<Is...>) {
+    auto register_one = [&](auto& kernel_acc, auto& original_acc, size_t idx) {
+        using Acc = std::remove_reference_t<decltype(kernel_acc)>;
+        using DS_Type = std::remove_reference_t<decltype(kernel_acc.data_ref)>;
+        const bool buffered = std::find(buffer_req.write_accessor_indices.begin(),
+                                        buffer_req.write_accessor_indices.end(), idx) != buffer_req.write_accessor_indices.end();
+        trace->register_accessor(idx, &kernel_acc.data_ref, &original_acc.data_ref, Acc::mode_value,
+                                 typeid(DS_Type).name(), buffered);
+        return 0;
+    };
+    (register_one(std::get<Is>(kernel_args), std::get<Is>(originals), Is), ...);
+}
+
+// Each thread calls its own copy of a trivially copyable kernel. Values the
+// kernel captures then live on the thread's stack and cannot alias the
+// accessors' stores, so the compiler keeps them in registers across the loop
+template<typename KernelFunc>
+ACCESSOR_FORCE_INLINE decltype(auto) private_kernel(KernelFunc& kernel) {
+    if constexpr (std::is_trivially_copyable_v<KernelFunc>) {
+        return KernelFunc(kernel);
+    } else {
+        return (kernel);
+    }
+}
 
 template<typename IterSpaceType, typename KernelFunc, typename AccessorTupleType>
 void execute_parallel_kernel_directly(
     IterSpaceType iter_space,
     KernelFunc&& kernel,
-    AccessorTupleType& original_accessor_tuple)
+    AccessorTupleType& original_accessor_tuple,
+    AccessTraceCollector* trace = nullptr,
+    const LoopSchedule& schedule = {})
 {
-    #pragma omp parallel
-    {
-        #pragma omp for
-        for (size_t i = 0; i < iter_space.size(); ++i) {
-            auto item_id = iter_space[i];
-            std::apply(
-                [&kernel, item_id_val = item_id](auto&... unpacked_accessors) {
-                    kernel(item_id_val, unpacked_accessors...);
-                },
-                original_accessor_tuple
-            );
+    if (trace) {
+        register_traced_accessors(trace, original_accessor_tuple, original_accessor_tuple, BufferRequirement{},
+                                  std::make_index_sequence<std::tuple_size_v<AccessorTupleType>>{});
+    }
+    auto run_item = [&](size_t i, auto& thread_kernel) ACCESSOR_FORCE_INLINE_LAMBDA {
+#if ACCESSOR_ENABLE_TRACING
+        // A loop nested in a traced one leaves the outer iteration in place
+        if (trace) detail::trace_iteration = i;
+#endif
+        auto item_id = iter_space[i];
+        std::apply(
+            [&thread_kernel, item_id_val = item_id](auto&... unpacked_accessors) ACCESSOR_FORCE_INLINE_LAMBDA {
+                thread_kernel(item_id_val, unpacked_accessors...);
+            },
+            original_accessor_tuple
+        );
+    };
+    if constexpr (static_extent_v<IterSpaceType> <= ACCESSOR_STATIC_UNROLL_LIMIT) {
+        static_for<static_extent_v<IterSpaceType>>([&](auto i) { run_item(i, kernel); });
+    } else if (schedule.is_default()) {
+        #pragma omp parallel
+        {
+            decltype(auto) thread_kernel = private_kernel(kernel);
+            #pragma omp for
+            for (size_t i = 0; i < iter_space.size(); ++i) run_item(i, thread_kernel);
+        }
+    } else {
+        ScopedRuntimeSchedule runtime_schedule(schedule);
+        #pragma omp parallel
+        {
+            decltype(auto) thread_kernel = private_kernel(kernel);
+            #pragma omp for schedule(runtime)
+            for (size_t i = 0; i < iter_space.size(); ++i) run_item(i, thread_kernel);
         }
     }
 }
@@ -187,17 +244,19 @@ void execute_parallel_kernel_with_buffering(
     KernelFunc&& kernel,
     AccessorTupleType& original_accessor_tuple,
     const BufferRequirementType& buffer_req,
-    std::index_sequence<Indices...> /* idx_seq */
+    std::index_sequence<Indices...> /* idx_seq */,
+    AccessTraceCollector* trace = nullptr,
+    const LoopSchedule& schedule = {},
+    std::pmr::memory_resource* memory = std::pmr::get_default_resource()
     )
 {
-    std::vector<std::any> temp_data_buffers_storage;
+    std::array<void*, sizeof...(Indices)> buffers{};
 
-    // 1. Populate temp_data_buffers_storage
+    // 1. Copy the data structures of the accessors that write to a buffer
     auto populate_buffers_if_needed = [&](auto& acc_ref, size_t current_idx) {
         for (size_t write_idx : buffer_req.write_accessor_indices) {
             if (current_idx == write_idx) {
-                using DS_Type = std::remove_reference_t<decltype(acc_ref.data_ref)>;
-                temp_data_buffers_storage.emplace_back(DS_Type(acc_ref.data_ref)); // Copy and store
+                buffers[current_idx] = make_buffer_copy(acc_ref.data_ref, memory);
                 break;
             }
         }
@@ -209,38 +268,57 @@ void execute_parallel_kernel_with_buffering(
     // 2. Create the tuple of accessors for the kernel
     auto kernel_args_tuple = detail::create_kernel_arg_accessors_tuple_impl(
         original_accessor_tuple,
-        buffer_req,
-        temp_data_buffers_storage,
+        buffers,
         std::index_sequence<Indices...>{} // Pass the sequence
     );
 
+    if (trace) {
+        register_traced_accessors(trace, kernel_args_tuple, original_accessor_tuple, buffer_req,
+                                  std::index_sequence<Indices...>{});
+    }
+
     // 3. Execute kernel
-    #pragma omp parallel
-    {
-        auto thread_local_kernel_args = kernel_args_tuple;
-        #pragma omp for
-        for (size_t i = 0; i < iter_space.size(); ++i) {
-            auto item_id = iter_space[i];
-            std::apply(
-                [&kernel, item_id_val = item_id](auto&... unpacked_kernel_accessors) {
-                    kernel(item_id_val, unpacked_kernel_accessors...);
-                },
-                thread_local_kernel_args
-            );
+    auto run_item = [&](size_t i, auto& thread_local_kernel_args, auto& thread_kernel) ACCESSOR_FORCE_INLINE_LAMBDA {
+#if ACCESSOR_ENABLE_TRACING
+        // A loop nested in a traced one leaves the outer iteration in place
+        if (trace) detail::trace_iteration = i;
+#endif
+        auto item_id = iter_space[i];
+        std::apply(
+            [&thread_kernel, item_id_val = item_id](auto&... unpacked_kernel_accessors) ACCESSOR_FORCE_INLINE_LAMBDA {
+                thread_kernel(item_id_val, unpacked_kernel_accessors...);
+            },
+            thread_local_kernel_args
+        );
+    };
+    if constexpr (static_extent_v<IterSpaceType> <= ACCESSOR_STATIC_UNROLL_LIMIT) {
+        static_for<static_extent_v<IterSpaceType>>([&](auto i) { run_item(i, kernel_args_tuple, kernel); });
+    } else if (schedule.is_default()) {
+        #pragma omp parallel
+        {
+            auto thread_local_kernel_args = kernel_args_tuple;
+            decltype(auto) thread_kernel = private_kernel(kernel);
+            #pragma omp for
+            for (size_t i = 0; i < iter_space.size(); ++i) run_item(i, thread_local_kernel_args, thread_kernel);
+        }
+    } else {
+        ScopedRuntimeSchedule runtime_schedule(schedule);
+        #pragma omp parallel
+        {
+            auto thread_local_kernel_args = kernel_args_tuple;
+            decltype(auto) thread_kernel = private_kernel(kernel);
+            #pragma omp for schedule(runtime)
+            for (size_t i = 0; i < iter_space.size(); ++i) run_item(i, thread_local_kernel_args, thread_kernel);
         }
     }
 
-    // 4. Write back data
-    size_t buffer_idx_in_storage = 0;
+    // 4. Write back data and release the buffers
     auto write_back_if_needed = [&](auto& original_acc_ref, size_t current_idx) {
-        for (size_t write_idx_from_req : buffer_req.write_accessor_indices) {
-            if (current_idx == write_idx_from_req) {
-                using DS_Type = std::remove_reference_t<decltype(original_acc_ref.data_ref)>;
-                auto& buffer_data = std::any_cast<DS_Type&>(temp_data_buffers_storage[buffer_idx_in_storage]);
-                DataStructureTraits<DS_Type>::copy_data_structure_impl(original_acc_ref.data_ref, buffer_data);
-                buffer_idx_in_storage++;
-                break;
-            }
+        if (void* buffer = buffers[current_idx]) {
+            using DS_Type = std::remove_reference_t<decltype(original_acc_ref.data_ref)>;
+            auto* buffer_data = static_cast<DS_Type*>(buffer);
+            DataStructureTraits<DS_Type>::copy_data_structure_impl(original_acc_ref.data_ref, *buffer_data);
+            std::pmr::polymorphic_allocator<>(memory).delete_object(buffer_data);
         }
         return 0; // Dummy return for fold expression
     };
@@ -248,14 +326,50 @@ void execute_parallel_kernel_with_buffering(
     (write_back_if_needed(std::get<Indices>(original_accessor_tuple), Indices), ...);
 }
 
+// Structures that buffer Reduce-mode updates per thread
+// (ReduceImplKind::LocalBufferAndFinalReduce) merge them in the optional
+// traits hook finalize_reduction_impl once the loop has finished
+template<typename Acc>
+void finalize_reduction(Acc& acc) {
+    using DS_Type = std::remove_reference_t<decltype(acc.data_ref)>;
+    if constexpr (Acc::mode_value == AccessMode::Reduce &&
+                  requires { DataStructureTraits<DS_Type>::finalize_reduction_impl(acc.data_ref); }) {
+        DataStructureTraits<DS_Type>::finalize_reduction_impl(acc.data_ref);
+    }
+}
+
 } // namespace detail
 
-// Main custom_parallel_for function
-template<typename IterSpaceType, typename KernelFunc, typename... AccessorTypes>
-void custom_parallel_for(IterSpaceType iter_space, KernelFunc&& kernel, AccessorTypes&... accessors) {
+// Main custom_parallel_for function, with an explicit schedule for the iterations
+// and the execution context the buffer copies are allocated from.
+// Iteration spaces with a small static extent (StaticRange<N>) ignore the
+// schedule and run as one unrolled sequence on the calling thread, so they
+// can be nested in per-item kernels without opening a parallel region.
+template<IterationSpace IterSpaceType, typename KernelFunc, typename... AccessorTypes>
+void custom_parallel_for(const ExecutionContext& ctx, const LoopSchedule& schedule, IterSpaceType iter_space,
+                         KernelFunc&& kernel, AccessorTypes&... accessors) {
+    detail::ScratchScope scratch(ctx);
     auto original_accessor_tuple = std::forward_as_tuple(accessors...);
     // It's important that detect_buffer_requirements is defined before this point or in a visible scope.
-    BufferRequirement buffer_req = detect_buffer_requirements(original_accessor_tuple);
+    BufferRequirement buffer_req = detect_buffer_requirements(original_accessor_tuple, scratch.resource());
+
+    // Hints are keyed by the call site and what the aliasing analysis buffers;
+    // calls without a site (contexts built inside the library) always buffer
+    std::string hint_key;
+    if (buffer_req.needs_buffering && ctx.site.line() != 0 &&
+        (detail::tracing_active() || !BufferingHints::global().empty())) {
+        hint_key = detail::buffering_hint_key<KernelFunc, IterSpaceType, AccessorTypes...>(
+            ctx.site, buffer_req.write_accessor_indices);
+    }
+
+    detail::AccessTraceCollector* trace = nullptr;
+#if ACCESSOR_ENABLE_TRACING
+    trace = detail::begin_traced_loop(detail::kernel_name<KernelFunc>(), hint_key, iter_space.size());
+#endif
+    // A traced sample run always buffers so it observes the conservative schedule
+    if (!hint_key.empty() && !trace && BufferingHints::global().can_skip(hint_key)) {
+        buffer_req.needs_buffering = false;
+    }
 
     if (buffer_req.needs_buffering) {
         detail::execute_parallel_kernel_with_buffering(
@@ -263,15 +377,42 @@ void custom_parallel_for(IterSpaceType iter_space, KernelFunc&& kernel, Accessor
             std::forward<KernelFunc>(kernel),
             original_accessor_tuple,
             buffer_req,
-            std::index_sequence_for<AccessorTypes...>{} // Pass the sequence of indices
+            std::index_sequence_for<AccessorTypes...>{}, // Pass the sequence of indices
+            trace,
+            schedule,
+            scratch.resource()
         );
     } else {
         detail::execute_parallel_kernel_directly(
            iter_space,
            std::forward<KernelFunc>(kernel),
-           original_accessor_tuple
+           original_accessor_tuple,
+           trace,
+           schedule
         );
     }
+    (detail::finalize_reduction(accessors), ...);
+    if (trace) trace->end_loop();
+}
+
+// Temporaries from the calling thread's arena; without a context the call
+// has no site, so BufferingHints never skip its buffer
+template<IterationSpace IterSpaceType, typename KernelFunc, typename... AccessorTypes>
+void custom_parallel_for(const LoopSchedule& schedule, IterSpaceType iter_space, KernelFunc&& kernel,
+                         AccessorTypes&... accessors) {
+    custom_parallel_for(ExecutionContext{nullptr, std::source_location{}}, schedule, iter_space, std::forward<KernelFunc>(kernel), accessors...);
+}
+
+// Default schedule: a plain `omp for`
+template<IterationSpace IterSpaceType, typename KernelFunc, typename... AccessorTypes>
+void custom_parallel_for(const ExecutionContext& ctx, IterSpaceType iter_space, KernelFunc&& kernel,
+                         AccessorTypes&... accessors) {
+    custom_parallel_for(ctx, LoopSchedule{}, iter_space, std::forward<KernelFunc>(kernel), accessors...);
+}
+
+template<IterationSpace IterSpaceType, typename KernelFunc, typename... AccessorTypes>
+void custom_parallel_for(IterSpaceType iter_space, KernelFunc&& kernel, AccessorTypes&... accessors) {
+    custom_parallel_for(ExecutionContext{nullptr, std::source_location{}}, LoopSchedule{}, iter_space, std::forward<KernelFunc>(kernel), accessors...);
 }
 
 } // namespace accessor
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "accessor.hpp"
+#include "concepts.hpp"
+#include "custom_parallel_for.hpp"
+#include "memory_resource.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <omp.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace accessor {
+
+/// @brief How custom_parallel_reduce groups the contributions
+enum class ReduceDeterminism {
+    Fast,         ///< One block per thread; result may change with the thread count
+    Reproducible  ///< Fixed-size blocks; bit-identical for any thread count
+};
+
+/// @brief Options for custom_parallel_reduce
+struct ReduceOptions {
+    ReduceDeterminism determinism = ReduceDeterminism::Fast;
+    size_t block_size = 2048;   ///< Reproducible mode: items per block
+    bool compensated = false;   ///< Reproducible mode: Neumaier summation inside
+                                ///< blocks (floating-point std::plus only)
+};
+
+/// @brief Options for a reproducible reduction
+inline ReduceOptions reproducible_reduce(size_t block_size = 2048, bool compensated = false) {
+    return ReduceOptions{ReduceDeterminism::Reproducible, block_size, compensated};
+}
+
+namespace detail {
+
+/// Independent accumulators per block: breaks the dependency chain of op so
+/// the loop vectorizes (or at least pipelines) for simple types
+inline constexpr size_t reduce_lanes = 4;
+
+template<typename T>
+struct alignas(64) ReducePartial {
+    T value;
+    bool valid = false;
+};
+
+template<typename T, typename Op>
+struct is_compensable_sum
+    : std::bool_constant<std::is_floating_point_v<T> &&
+                         (std::is_same_v<Op, std::plus<T>> || std::is_same_v<Op, std::plus<>>)> {};
+
+/// @brief Reduce contributions [begin, end) (non-empty) with reduce_lanes
+///        accumulators; lane l takes items begin + l, begin + l + lanes, ...
+template<typename T, typename Op, typename Contrib>
+T reduce_block(size_t begin, size_t end, Op& op, Contrib& contrib) {
+    constexpr size_t L = reduce_lanes;
+    static_assert(L == 4, "Lane initialisation and combine below assume four lanes");
+    if (end - begin < L) {
+        T acc = static_cast<T>(contrib(begin));
+        for (size_t i = begin + 1; i < end; ++i) acc = op(acc, static_cast<T>(contrib(i)));
+        return acc;
+    }
+    T lane[L] = {static_cast<T>(contrib(begin)), static_cast<T>(contrib(begin + 1)),
+                 static_cast<T>(contrib(begin + 2)), static_cast<T>(contrib(begin + 3))};
+    size_t i = begin + L;
+    for (; i + L <= end; i += L) {
+        for (size_t l = 0; l < L; ++l) lane[l] = op(lane[l], static_cast<T>(contrib(i + l)));
+    }
+    for (size_t l = 0; i < end; ++i, ++l) lane[l] = op(lane[l], static_cast<T>(contrib(i)));
+    return op(op(lane[0], lane[1]), op(lane[2], lane[3]));
+}
+
+/// @brief Neumaier-compensated sum of contributions [begin, end)
+template<typename T, typename Contrib>
+T compensated_block_sum(size_t begin, size_t end, Contrib& contrib) {
+    T sum = T{}, comp = T{};
+    for (size_t i = begin; i < end; ++i) {
+        const T x = static_cast<T>(contrib(i));
+        const T t = sum + x;
+        comp += std::abs(sum) >= std::abs(x) ? (sum - t) + x : (x - t) + sum;
+        sum = t;
+    }
+    return sum + comp;
+}
+
+/// @brief Combine partials pairwise in a shape that only depends on their count
+template<typename Partials, typename Op>
+auto tree_combine(Partials& partials, Op& op) {
+    const size_t n = partials.size();
+    for (size_t stride = 1; stride < n; stride *= 2) {
+        for (size_t i = 0; i + stride < n; i += 2 * stride) {
+            partials[i] = op(partials[i], partials[i + stride]);
+        }
+    }
+    return partials[0];
+}
+
+} // namespace detail
+
+/// @brief Parallel reduction of kernel results over an iteration space
+///
+/// The kernel is called as kernel(item_id, accessors...) and returns the
+/// item's contribution; the result is init op c[0] op c[1] op ... . Each
+/// block of the space is reduced with several independent accumulators and
+/// the block partials are combined with a pairwise tree, so op must be
+/// associative and commutative. init is folded in once, so it need not be
+/// the identity of op.
+///
+/// ReduceDeterminism::Fast uses one contiguous block per thread, so the
+/// rounding of floating-point results depends on the thread count.
+/// ReduceDeterminism::Reproducible splits the space into blocks of
+/// options.block_size items regardless of the thread count; since the
+/// grouping and the combine tree then only depend on the size of the space,
+/// results are bit-identical for any number of threads. With
+/// options.compensated a floating-point sum uses Neumaier summation inside
+/// each block, which also makes it far less sensitive to cancellation.
+///
+/// Accessors are passed to the kernel as given (no auto-buffering): a
+/// kernel may write the ids its item owns (e.g. fuse an update with the
+/// dot product of its result) but must not read what other items write.
+/// Reduce-mode accessors are finalized before the call returns.
+///
+/// Block partials are allocated from ctx.memory (by default the calling
+/// thread's arena), before the parallel region is entered.
+/// @param ctx Execution context providing the temporaries
+/// @param iter_space Iteration space
+/// @param options Determinism mode and block size
+/// @param kernel Callable returning a value convertible to T
+/// @param init Initial value
+/// @param op Associative, commutative binary operation
+/// @param accessors Accessors passed through to the kernel
+/// @return init combined with every contribution
+template<IterationSpace IterSpaceType, typename KernelFunc, typename T, typename BinaryOp, typename... AccessorTypes>
+T custom_parallel_reduce(const ExecutionContext& ctx, IterSpaceType iter_space, const ReduceOptions& options,
+                         KernelFunc&& kernel, T init, BinaryOp op, AccessorTypes&... accessors) {
+    const size_t n = iter_space.size();
+    if (n == 0) {
+        return init;
+    }
+    detail::ScratchScope scratch(ctx);
+    auto contrib = [&](size_t i) { return kernel(iter_space[i], accessors...); };
+
+    if (options.determinism == ReduceDeterminism::Reproducible) {
+        const size_t block = std::max<size_t>(options.block_size, 1);
+        const size_t num_blocks = (n + block - 1) / block;
+        std::pmr::vector<T> partials(num_blocks, init, scratch.resource());
+        const long long num_blocks_ll = static_cast<long long>(num_blocks);
+        #pragma omp parallel for schedule(static)
+        for (long long b = 0; b < num_blocks_ll; ++b) {
+            const size_t begin = static_cast<size_t>(b) * block;
+            const size_t end = std::min(n, begin + block);
+            if constexpr (detail::is_compensable_sum<T, BinaryOp>::value) {
+                if (options.compensated) {
+                    partials[static_cast<size_t>(b)] = detail::compensated_block_sum<T>(begin, end, contrib);
+                    continue;
+                }
+            }
+            partials[static_cast<size_t>(b)] = detail::reduce_block<T>(begin, end, op, contrib);
+        }
+        T result = op(init, detail::tree_combine(partials, op));
+        (detail::finalize_reduction(accessors), ...);
+        return result;
+    }
+
+    // Sized for the largest team the region can get; unused slots stay invalid
+    std::pmr::vector<detail::ReducePartial<T>> slots(static_cast<size_t>(omp_get_max_threads()),
+                                                     detail::ReducePartial<T>{init, false}, scratch.resource());
+    #pragma omp parallel num_threads(static_cast<int>(slots.size()))
+    {
+        const size_t nthreads = static_cast<size_t>(omp_get_num_threads());
+        const size_t tid = static_cast<size_t>(omp_get_thread_num());
+        const size_t begin = n * tid / nthreads;
+        const size_t end = n * (tid + 1) / nthreads;
+        if (begin < end) {
+            slots[tid].value = detail::reduce_block<T>(begin, end, op, contrib);
+            slots[tid].valid = true;
+        }
+    }
+    std::pmr::vector<T> partials(scratch.resource());
+    partials.reserve(slots.size());
+    for (auto& slot : slots) {
+        if (slot.valid) partials.push_back(std::move(slot.value));
+    }
+    T result = op(init, detail::tree_combine(partials, op));
+    (detail::finalize_reduction(accessors), ...);
+    return result;
+}
+
+/// @brief custom_parallel_reduce with temporaries from the calling thread's arena
+template<IterationSpace IterSpaceType, typename KernelFunc, typename T, typename BinaryOp, typename... AccessorTypes>
+T custom_parallel_reduce(IterSpaceType iter_space, const ReduceOptions& options, KernelFunc&& kernel,
+                         T init, BinaryOp op, AccessorTypes&... accessors) {
+    return custom_parallel_reduce(ExecutionContext{}, iter_space, options, std::forward<KernelFunc>(kernel),
+                                  std::move(init), std::move(op), accessors...);
+}
+
+/// @brief custom_parallel_reduce with ReduceDeterminism::Fast
+template<IterationSpace IterSpaceType, typename KernelFunc, typename T, typename BinaryOp, typename... AccessorTypes>
+    requires (!std::is_same_v<std::decay_t<KernelFunc>, ReduceOptions>)
+T custom_parallel_reduce(IterSpaceType iter_space, KernelFunc&& kernel, T init, BinaryOp op,
+                         AccessorTypes&... accessors) {
+    return custom_parallel_reduce(ExecutionContext{}, iter_space, ReduceOptions{}, std::forward<KernelFunc>(kernel),
+                                  std::move(init), std::move(op), accessors...);
+}
+
+} // namespace accessor
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "accessor.hpp"
+#include "concepts.hpp"
+#include "memory_resource.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <omp.h>
+#include <utility>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Scan flavour for custom_parallel_scan
+enum class ScanKind {
+    Inclusive,  ///< out[i] = init op in[0] op ... op in[i]
+    Exclusive   ///< out[i] = init op in[0] op ... op in[i-1]
+};
+
+/// @brief Parallel prefix scan over an iteration space
+///
+/// Two-pass blocked algorithm: every thread reduces a contiguous block of the
+/// iteration space, the per-block partials are scanned in order starting
+/// from init, then every thread rescans its block from its carry-in and
+/// writes the result. The last block is not pre-reduced, so a single thread
+/// makes one pass. Partials are combined left to right, so op only needs to
+/// be associative.
+///
+/// Input and output may be accessors to the same data: each element is read
+/// before it is written and only by the thread owning its block, so the scan
+/// runs in place without the auto-buffering copy of custom_parallel_for.
+/// Ids produced by the iteration space must be distinct.
+///
+/// The block carries are allocated from ctx.memory (by default the calling
+/// thread's arena) before the parallel region is entered.
+///
+/// @param ctx Execution context providing the temporaries
+/// @param iter_space Iteration space defining the scan order
+/// @param kind Inclusive or exclusive
+/// @param init Initial value folded in front of the sequence
+/// @param op Associative binary operation
+/// @param in Accessor with read permission
+/// @param out Accessor with write permission
+/// @return init combined with every input element
+template<IterationSpace IterSpaceType, typename T, typename BinaryOp, typename InAcc, typename OutAcc>
+T custom_parallel_scan(const ExecutionContext& ctx, IterSpaceType iter_space, ScanKind kind, T init, BinaryOp op,
+                       InAcc& in, OutAcc& out) {
+    const size_t n = iter_space.size();
+    if (n == 0) {
+        return init;
+    }
+
+    detail::ScratchScope scratch(ctx);
+    std::pmr::vector<T> carry(scratch.resource());
+    const int max_threads = omp_get_max_threads();
+    carry.reserve(static_cast<size_t>(max_threads) + 1);   // assign() below then never reallocates
+    T total = init;
+
+    #pragma omp parallel num_threads(max_threads)
+    {
+        const size_t nthreads = static_cast<size_t>(omp_get_num_threads());
+        const size_t tid = static_cast<size_t>(omp_get_thread_num());
+        const size_t begin = n * tid / nthreads;
+        const size_t end = n * (tid + 1) / nthreads;
+
+        #pragma omp single
+        carry.assign(nthreads + 1, init);
+
+        // 1. Per-block reduction (nobody consumes the last block's partial)
+        if (begin < end && tid + 1 < nthreads) {
+            T partial = static_cast<T>(in.get_value_by_id(iter_space[begin]));
+            for (size_t i = begin + 1; i < end; ++i) {
+                partial = op(partial, static_cast<T>(in.get_value_by_id(iter_space[i])));
+            }
+            carry[tid + 1] = std::move(partial);
+        }
+
+        // 2. Scan of block partials (empty blocks pass the carry through)
+        #pragma omp barrier
+        #pragma omp single
+        {
+            T running = init;
+            for (size_t t = 0; t + 1 < nthreads; ++t) {
+                size_t b = n * t / nthreads, e = n * (t + 1) / nthreads;
+                T next = (b < e) ? op(running, carry[t + 1]) : running;
+                carry[t] = running;
+                running = std::move(next);
+            }
+            carry[nthreads - 1] = std::move(running);
+        }
+
+        // 3. Rescan each block from its carry-in
+        T running = carry[tid];
+        if (kind == ScanKind::Inclusive) {
+            for (size_t i = begin; i < end; ++i) {
+                auto id = iter_space[i];
+                running = op(running, static_cast<T>(in.get_value_by_id(id)));
+                out.set_value_by_id(id, running);
+            }
+        } else {
+            for (size_t i = begin; i < end; ++i) {
+                auto id = iter_space[i];
+                T value = static_cast<T>(in.get_value_by_id(id));
+                out.set_value_by_id(id, running);
+                running = op(running, value);
+            }
+        }
+        if (tid + 1 == nthreads) {
+            total = std::move(running);
+        }
+    }
+    return total;
+}
+
+/// @brief custom_parallel_scan with temporaries from the calling thread's arena
+template<IterationSpace IterSpaceType, typename T, typename BinaryOp, typename InAcc, typename OutAcc>
+T custom_parallel_scan(IterSpaceType iter_space, ScanKind kind, T init, BinaryOp op, InAcc& in, OutAcc& out) {
+    return custom_parallel_scan(ExecutionContext{}, iter_space, kind, std::move(init), std::move(op), in, out);
+}
+
+} // namespace accessor
@@ -0,0 +1,329 @@
+#pragma once
+
+#include "accessor.hpp"
+#include "compiler_hints.hpp"
+#include "concepts.hpp"
+#include "custom_parallel_for.hpp"
+#include "loop_schedule.hpp"
+#include "memory_resource.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <omp.h>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+namespace accessor {
+
+/// @brief Shape of a hierarchical (league/team/vector) loop
+///
+/// The league is the iteration space; each of its items is processed by one
+/// team of team_size threads, which split the item's inner work with the
+/// TeamMember loops. Items go to teams round-robin in chunks (Static) or on
+/// demand (Dynamic and Guided, which behave the same here); chunk 0 means 1.
+struct TeamPolicy {
+    size_t team_size = 0;            ///< Threads per team; 0: min(4, available threads)
+    size_t team_scratch_bytes = 0;   ///< Scratch shared by the members of a team, per league item
+    size_t thread_scratch_bytes = 0; ///< Scratch private to each member, per league item
+    LoopSchedule schedule{};
+};
+
+namespace detail {
+
+inline constexpr size_t team_cache_line = 64;
+inline constexpr size_t team_default_size = 4;
+
+struct alignas(team_cache_line) TeamCacheLine {
+    std::byte bytes[team_cache_line];
+};
+
+/// Generation-counting barrier for the threads of one team. Waiters spin
+/// briefly and then yield, so oversubscribed teams still make progress.
+class TeamBarrier {
+public:
+    explicit TeamBarrier(size_t size = 1) : size_(size) {}
+
+    void arrive_and_wait() {
+        if (size_ == 1) return;
+        const size_t generation = generation_.load(std::memory_order_acquire);
+        if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == size_) {
+            arrived_.store(0, std::memory_order_relaxed);
+            generation_.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+        for (unsigned spin = 0; generation_.load(std::memory_order_acquire) == generation; ++spin) {
+            if (spin >= 64) std::this_thread::yield();
+        }
+    }
+
+private:
+    alignas(team_cache_line) std::atomic<size_t> arrived_{0};
+    alignas(team_cache_line) std::atomic<size_t> generation_{0};
+    size_t size_;
+};
+
+/// State shared by the members of one team. The slot and scratch lines are
+/// carved from the call's memory resource before the parallel region.
+struct TeamState {
+    TeamBarrier barrier;
+    size_t handoff[2] = {0, 0};            ///< Dynamic schedule: chunk start published by rank 0
+    TeamCacheLine* reduce;                 ///< 2 x team_size slots, alternating between reductions
+    TeamCacheLine* scratch;
+    size_t scratch_lines;
+
+    TeamState(size_t team_size, TeamCacheLine* reduce_lines, TeamCacheLine* scratch_lines_ptr, size_t scratch_line_count)
+        : barrier(team_size), reduce(reduce_lines), scratch(scratch_lines_ptr), scratch_lines(scratch_line_count) {}
+};
+
+inline size_t team_cache_lines(size_t bytes) { return (bytes + team_cache_line - 1) / team_cache_line; }
+
+} // namespace detail
+
+/// @brief Handle a team kernel receives for the league item it is working on
+///
+/// All members of a team must make the same sequence of team-level calls
+/// (parallel_for, parallel_reduce, team_barrier, team_scratch) for an item.
+/// parallel_for has no implicit barrier: call team_barrier() before reading
+/// what other members wrote. parallel_reduce returns the same value on every
+/// member; its partials are combined in rank order, so for a fixed team size
+/// the result does not depend on timing.
+class TeamMember {
+public:
+    size_t league_rank() const { return league_rank_; }   ///< Position of the item in the league
+    size_t league_size() const { return league_size_; }
+    size_t team_rank() const { return team_rank_; }
+    size_t team_size() const { return team_size_; }
+
+    void team_barrier() { state_->barrier.arrive_and_wait(); }
+
+    /// @brief Calls f(i) for i in [0, n), each member taking one contiguous block
+    template<typename F>
+    ACCESSOR_FORCE_INLINE void parallel_for(size_t n, F&& f) const {
+        const size_t begin = block_begin(n, team_rank_), end = block_begin(n, team_rank_ + 1);
+        for (size_t i = begin; i < end; ++i) f(i);
+    }
+
+    /// @brief init op f(0) op ... op f(n-1) across the team
+    ///
+    /// op must be associative; init is folded in once. T must be trivially
+    /// copyable and fit in one cache line.
+    template<typename T, typename F, typename BinaryOp = std::plus<T>>
+    T parallel_reduce(size_t n, F&& f, T init, BinaryOp op = BinaryOp{}) {
+        static_assert(std::is_trivially_copyable_v<T> && sizeof(T) + 1 <= detail::team_cache_line,
+                      "team reductions hold each partial in one cache line");
+        const size_t begin = block_begin(n, team_rank_), end = block_begin(n, team_rank_ + 1);
+        if (team_size_ == 1) {
+            for (size_t i = begin; i < end; ++i) init = op(init, static_cast<T>(f(i)));
+            return init;
+        }
+        // Alternating slot sets: a member rewrites set p only after everyone
+        // passed the barrier of the reduction that last read it
+        detail::TeamCacheLine* slots = state_->reduce + (reductions_++ & 1) * team_size_;
+        detail::TeamCacheLine& mine = slots[team_rank_];
+        const bool has_partial = begin < end;
+        if (has_partial) {
+            T partial = static_cast<T>(f(begin));
+            for (size_t i = begin + 1; i < end; ++i) partial = op(partial, static_cast<T>(f(i)));
+            std::memcpy(mine.bytes, &partial, sizeof(T));
+        }
+        mine.bytes[sizeof(T)] = std::byte{has_partial};
+        team_barrier();
+        for (size_t r = 0; r < team_size_; ++r) {
+            if (slots[r].bytes[sizeof(T)] == std::byte{0}) continue;
+            T partial;
+            std::memcpy(&partial, slots[r].bytes, sizeof(T));
+            init = op(init, partial);
+        }
+        return init;
+    }
+
+    /// @brief Runs f() on rank 0 only (no barrier)
+    template<typename F>
+    void single(F&& f) const {
+        if (team_rank_ == 0) f();
+    }
+
+    /// @brief Vector level: f(i) for i in [0, n) on this thread, as one SIMD loop
+    template<typename F>
+    ACCESSOR_FORCE_INLINE void vector_for(size_t n, F&& f) const {
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i) f(i);
+    }
+
+    /// @brief Vector level: init + f(0) + ... + f(n-1) on this thread, as one SIMD loop
+    template<typename T, typename F>
+    ACCESSOR_FORCE_INLINE T vector_sum(size_t n, F&& f, T init = T{}) const {
+        T sum = init;
+        #pragma omp simd reduction(+ : sum)
+        for (size_t i = 0; i < n; ++i) sum += static_cast<T>(f(i));
+        return sum;
+    }
+
+    /// @brief count elements of team scratch, the same storage on every member
+    ///
+    /// Successive calls for one item return consecutive regions; the space
+    /// is recycled for the next item. The total must fit in
+    /// TeamPolicy::team_scratch_bytes, otherwise std::length_error is thrown
+    /// (which ends the program unless the kernel catches it).
+    template<typename T>
+    T* team_scratch(size_t count) {
+        return carve<T>(state_->scratch, state_->scratch_lines, team_scratch_used_, count);
+    }
+
+    /// @brief count elements of this member's private scratch (TeamPolicy::thread_scratch_bytes),
+    ///        bounds-checked like team_scratch
+    template<typename T>
+    T* thread_scratch(size_t count) {
+        return carve<T>(thread_scratch_, thread_scratch_lines_, thread_scratch_used_, count);
+    }
+
+private:
+    template<typename IterSpaceType, typename KernelFunc, typename... AccessorTypes>
+    friend void custom_team_parallel_for(const ExecutionContext&, const TeamPolicy&, IterSpaceType, KernelFunc&&,
+                                         AccessorTypes&...);
+
+    TeamMember(detail::TeamState* state, detail::TeamCacheLine* thread_scratch, size_t thread_scratch_lines,
+               size_t league_size, size_t team_rank, size_t team_size)
+        : state_(state), thread_scratch_(thread_scratch), thread_scratch_lines_(thread_scratch_lines),
+          league_size_(league_size), team_rank_(team_rank), team_size_(team_size) {}
+
+    void begin_item(size_t league_rank) {
+        league_rank_ = league_rank;
+        team_scratch_used_ = 0;
+        thread_scratch_used_ = 0;
+    }
+
+    size_t block_begin(size_t n, size_t rank) const { return n / team_size_ * rank + std::min(rank, n % team_size_); }
+
+    template<typename T>
+    static T* carve(detail::TeamCacheLine* base, size_t lines, size_t& used, size_t count) {
+        static_assert(alignof(T) <= detail::team_cache_line, "scratch is cache-line aligned");
+        const size_t offset = (used + alignof(T) - 1) / alignof(T) * alignof(T);
+        const size_t capacity = lines * detail::team_cache_line;
+        if (offset > capacity || count > (capacity - offset) / sizeof(T)) [[unlikely]] {
+            throw std::length_error("TeamMember: scratch request exceeds the TeamPolicy scratch size");
+        }
+        used = offset + count * sizeof(T);
+        return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(base) + offset);
+    }
+
+    detail::TeamState* state_;
+    detail::TeamCacheLine* thread_scratch_;
+    size_t thread_scratch_lines_;
+    size_t league_rank_ = 0;
+    size_t league_size_;
+    size_t team_rank_;
+    size_t team_size_;
+    size_t reductions_ = 0;
+    size_t team_scratch_used_ = 0;
+    size_t thread_scratch_used_ = 0;
+};
+
+/// @brief Hierarchical parallel loop: one team of threads per league item
+///
+/// The kernel is called as kernel(member, item_id, accessors...) by every
+/// member of the team that owns the item, and splits the item's inner work
+/// with member.parallel_for / parallel_reduce (thread level) and
+/// vector_for / vector_sum (SIMD level). A single long CSR row can so be
+/// spread over a team, while IterateOver::CSRRowBlocks packs many short rows
+/// into one item. Teams are carved out of one parallel region (threads
+/// [k * team_size, (k + 1) * team_size) form team k), so no nested OpenMP
+/// parallelism is involved; inside an active parallel region the teams
+/// collapse to one thread.
+///
+/// Like custom_parallel_reduce, accessors are passed as given (no
+/// auto-buffering): items must not read what other items write. Reduce-mode
+/// accessors are finalized after the loop.
+///
+/// Team state, reduction slots and scratch are allocated from ctx.memory (by
+/// default the calling thread's arena) before the parallel region is entered.
+/// @param ctx Execution context providing the temporaries
+/// @param policy Team size, scratch sizes and league schedule
+/// @param league Iteration space of the league
+/// @param kernel Callable (TeamMember&, item_id, accessors...)
+/// @param accessors Accessors passed through to the kernel
+template<typename IterSpaceType, typename KernelFunc, typename... AccessorTypes>
+void custom_team_parallel_for(const ExecutionContext& ctx, const TeamPolicy& policy, IterSpaceType league,
+                              KernelFunc&& kernel, AccessorTypes&... accessors) {
+    static_assert(IterationSpace<IterSpaceType>, "league must be an iteration space");
+    const size_t n = league.size();
+    if (n == 0) return;
+    const size_t threads = omp_in_parallel() ? 1 : static_cast<size_t>(omp_get_max_threads());
+    const size_t requested = policy.team_size ? policy.team_size : detail::team_default_size;
+    const size_t max_team_size = std::max<size_t>(1, std::min(requested, threads));
+    const size_t max_teams = std::max<size_t>(1, std::min(threads / max_team_size, n));
+    const size_t chunk = std::max<size_t>(policy.schedule.chunk, 1);
+    const bool dynamic = policy.schedule.kind != ScheduleKind::Static;
+
+    detail::ScratchScope scratch(ctx);
+    std::pmr::polymorphic_allocator<> alloc(scratch.resource());
+    const size_t reduce_lines = 2 * max_team_size;
+    const size_t team_lines = detail::team_cache_lines(policy.team_scratch_bytes);
+    const size_t thread_lines = detail::team_cache_lines(policy.thread_scratch_bytes);
+    const size_t total_lines = max_teams * (reduce_lines + team_lines + thread_lines * max_team_size);
+    detail::TeamState* teams = alloc.allocate_object<detail::TeamState>(max_teams);
+    detail::TeamCacheLine* lines = alloc.allocate_object<detail::TeamCacheLine>(total_lines);
+    detail::TeamCacheLine* team_scratch = lines + max_teams * reduce_lines;
+    detail::TeamCacheLine* thread_scratch = team_scratch + max_teams * team_lines;
+    alignas(detail::team_cache_line) std::atomic<size_t> next_chunk{0};
+
+    #pragma omp parallel num_threads(static_cast<int>(max_teams * max_team_size))
+    {
+        // The runtime may grant fewer threads than requested; lay the teams
+        // out over the ones that exist
+        const size_t granted = static_cast<size_t>(omp_get_num_threads());
+        const size_t team_size = std::min(max_team_size, granted);
+        const size_t num_teams = std::min(max_teams, granted / team_size);
+        const size_t tid = static_cast<size_t>(omp_get_thread_num());
+        const size_t team = tid / team_size, rank = tid % team_size;
+        if (team < num_teams && rank == 0) {
+            std::construct_at(teams + team, team_size, lines + team * reduce_lines,
+                              team_scratch + team * team_lines, team_lines);
+        }
+        #pragma omp barrier
+        if (team < num_teams) {
+            detail::TeamState& state = teams[team];
+            TeamMember member(&state, thread_scratch + tid * thread_lines, thread_lines, n, rank, team_size);
+            auto run_item = [&](size_t item) ACCESSOR_FORCE_INLINE_LAMBDA {
+                member.begin_item(item);
+                kernel(member, league[item], accessors...);
+            };
+            if (!dynamic) {
+                for (size_t start = team * chunk; start < n; start += num_teams * chunk) {
+                    const size_t end = std::min(n, start + chunk);
+                    for (size_t item = start; item < end; ++item) run_item(item);
+                }
+            } else {
+                // Rank 0 claims chunks and publishes them through alternating
+                // hand-off slots; the barrier orders publish and read
+                for (size_t round = 0;; ++round) {
+                    if (rank == 0) state.handoff[round & 1] = next_chunk.fetch_add(chunk, std::memory_order_relaxed);
+                    state.barrier.arrive_and_wait();
+                    const size_t start = state.handoff[round & 1];
+                    if (start >= n) break;
+                    const size_t end = std::min(n, start + chunk);
+                    for (size_t item = start; item < end; ++item) run_item(item);
+                }
+            }
+        }
+        #pragma omp barrier
+        if (team < num_teams && rank == 0) std::destroy_at(teams + team);
+    }
+    alloc.deallocate_object(lines, total_lines);
+    alloc.deallocate_object(teams, max_teams);
+    (detail::finalize_reduction(accessors), ...);
+}
+
+/// @brief custom_team_parallel_for with temporaries from the calling thread's arena
+template<typename IterSpaceType, typename KernelFunc, typename... AccessorTypes>
+void custom_team_parallel_for(const TeamPolicy& policy, IterSpaceType league, KernelFunc&& kernel,
+                              AccessorTypes&... accessors) {
+    custom_team_parallel_for(ExecutionContext{}, policy, league, std::forward<KernelFunc>(kernel), accessors...);
+}
+
+} // namespace accessor
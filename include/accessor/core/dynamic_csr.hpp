@@ -0,0 +1,441 @@
+#pragma once
+
+#include "csr_builder.hpp"
+#include "csr_matrix.hpp"
+#include "parallel_compact.hpp"
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <omp.h>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace accessor {
+
+enum class CSRUpdateKind : uint8_t {
+    Insert,   ///< Add the entry, or overwrite its value if present
+    Erase,    ///< Remove the entry if present
+};
+
+template<typename StorageT>
+struct CSRUpdate {
+    size_t row;
+    size_t col;
+    StorageT value;
+    CSRUpdateKind kind;
+};
+
+struct DynamicCSROptions {
+    /// Compact once the overlay (including rows superseded by later
+    /// batches) holds this fraction of the base nonzeros; 0 disables
+    double compaction_threshold = 0.25;
+    /// Compact on a background thread instead of inside apply_updates
+    bool background_compaction = true;
+};
+
+namespace detail {
+
+/// @brief Sort with per-thread chunk sorts followed by a parallel merge tree
+template<typename It, typename Compare>
+void parallel_sort(It first, It last, Compare cmp) {
+    const size_t n = static_cast<size_t>(last - first);
+    const size_t chunks = static_cast<size_t>(omp_get_max_threads());
+    if (chunks <= 1 || n < (size_t{1} << 14)) {
+        std::sort(first, last, cmp);
+        return;
+    }
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t c = 0; c <= chunks; ++c) bounds[c] = n * c / chunks;
+    const long long chunks_ll = static_cast<long long>(chunks);
+    #pragma omp parallel for schedule(static)
+    for (long long c = 0; c < chunks_ll; ++c) {
+        std::sort(first + static_cast<std::ptrdiff_t>(bounds[c]), first + static_cast<std::ptrdiff_t>(bounds[c + 1]), cmp);
+    }
+    for (size_t width = 1; width < chunks; width *= 2) {
+        const long long pairs = static_cast<long long>((chunks + 2 * width - 1) / (2 * width));
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long p = 0; p < pairs; ++p) {
+            const size_t lo = static_cast<size_t>(p) * 2 * width;
+            const size_t mid = std::min(lo + width, chunks), hi = std::min(lo + 2 * width, chunks);
+            std::inplace_merge(first + static_cast<std::ptrdiff_t>(bounds[lo]), first + static_cast<std::ptrdiff_t>(bounds[mid]),
+                               first + static_cast<std::ptrdiff_t>(bounds[hi]), cmp);
+        }
+    }
+}
+
+} // namespace detail
+
+/// @brief Sparse matrix with a fixed row count that accepts batched
+///        inserts and deletes
+///
+/// A base CSRMatrixT plus an overlay: every row touched by a batch is
+/// rewritten, merged and sorted, into an append-only overlay arena, and the
+/// row view points at whichever copy is current. Views are ordinary
+/// CSRMatrixRowViewT, so GetCSRRowViewTag kernels run unchanged; the cost of
+/// updates shows up as rows scattered through the arena instead of
+/// contiguous in the base. Compaction folds the overlay into a fresh base.
+///
+/// Background compaction freezes the current overlay and merges base +
+/// frozen overlay on a worker thread while later batches go to a new
+/// overlay; the result is swapped in by the next apply_updates,
+/// poll_compaction or wait_for_compaction. Updates, views and compaction
+/// calls must not run concurrently with each other; views are invalidated
+/// by the next apply_updates or compaction swap.
+/// @tparam Allocator Allocator of the base CSR arrays; compaction allocates
+///         the new base with the current base's allocator (the overlays
+///         use the default heap)
+template<typename StorageT = float, typename ComputeT = default_compute_type_t<StorageT>,
+         typename Allocator = std::allocator<StorageT>>
+class DynamicCSRMatrix {
+public:
+    using StorageType = StorageT;
+    using ComputeType = ComputeT;
+    using Matrix = CSRMatrixT<StorageT, ComputeT, Allocator>;
+    using Update = CSRUpdate<StorageT>;
+    using RowView = CSRMatrixRowViewT<StorageT, ComputeT>;
+
+    /// @param base Initial contents; columns must be sorted and unique within each row
+    explicit DynamicCSRMatrix(Matrix base, DynamicCSROptions options = {})
+        : options_(options), base_(std::move(base)), nnz_(base_.num_nonzeros()) {
+        if (base_.row_ptr.empty()) base_.row_ptr.push_back(0);
+        active_.reset(num_rows());
+    }
+
+    /// @brief Copy of the current contents; a running background compaction
+    ///        of other is not waited for, its frozen rows are folded into the copy's base
+    DynamicCSRMatrix(const DynamicCSRMatrix& other)
+        : options_(other.options_),
+          base_(other.compacting_ ? merged(other.base_, other.frozen_) : other.base_),
+          active_(other.active_),
+          nnz_(other.nnz_),
+          compactions_(other.compactions_) {}
+
+    DynamicCSRMatrix& operator=(const DynamicCSRMatrix& other) {
+        if (this == &other) return *this;
+        wait_for_compaction();
+        options_ = other.options_;
+        base_ = other.compacting_ ? merged(other.base_, other.frozen_) : other.base_;
+        active_ = other.active_;
+        nnz_ = other.nnz_;
+        compactions_ = other.compactions_;
+        return *this;
+    }
+
+    ~DynamicCSRMatrix() {
+        if (worker_.joinable()) worker_.join();
+    }
+
+    size_t num_rows() const { return base_.num_rows(); }
+    size_t num_nonzeros() const { return nnz_; }
+    /// @brief Rows currently served from an overlay instead of the base
+    size_t overlay_rows() const { return active_.rows + (compacting_ ? frozen_.rows : 0); }
+    /// @brief Entries held by the overlays, including superseded row copies
+    size_t overlay_entries() const { return active_.cols.size() + (compacting_ ? frozen_.cols.size() : 0); }
+    size_t compactions() const { return compactions_; }
+    bool compaction_in_progress() const { return compacting_; }
+    const DynamicCSROptions& options() const { return options_; }
+
+    /// @brief Current contents of a row, columns sorted
+    RowView row_view(size_t row) const {
+        if (const size_t b = active_.begin[row]; b != kNone) {
+            return RowView{active_.vals.data() + b, active_.cols.data() + b, active_.length[row]};
+        }
+        if (compacting_) {
+            if (const size_t b = frozen_.begin[row]; b != kNone) {
+                return RowView{frozen_.vals.data() + b, frozen_.cols.data() + b, frozen_.length[row]};
+            }
+        }
+        const size_t start = base_.row_ptr[row];
+        return RowView{base_.values.data() + start, base_.col_indices.data() + start, base_.row_ptr[row + 1] - start};
+    }
+
+    /// @brief Apply a batch; within the batch later updates of an entry win
+    ///
+    /// Sorts the batch by (row, col, position), reduces each entry to its
+    /// last update, then rewrites every touched row in parallel: one pass
+    /// sizes the merged rows, a prefix sum places them in the arena, a second
+    /// pass writes them. May start or finish a compaction afterwards.
+    void apply_updates(const std::vector<Update>& batch) {
+        poll_compaction();
+        const size_t n_rows = num_rows();
+        const long long batch_ll = static_cast<long long>(batch.size());
+        bool out_of_range = false;
+        #pragma omp parallel for schedule(static) reduction(|| : out_of_range)
+        for (long long i = 0; i < batch_ll; ++i) {
+            out_of_range = out_of_range || batch[static_cast<size_t>(i)].row >= n_rows;
+        }
+        if (out_of_range) {
+            throw std::out_of_range("DynamicCSRMatrix: update row out of range");
+        }
+        if (batch.empty()) return;
+
+        // 1. Order updates by (row, col, position) and keep the last per entry
+        std::vector<uint32_t> order(batch.size());
+        if (batch.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("DynamicCSRMatrix: batch too large");
+        }
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < batch_ll; ++i) order[static_cast<size_t>(i)] = static_cast<uint32_t>(i);
+        detail::parallel_sort(order.begin(), order.end(), [&batch](uint32_t x, uint32_t y) {
+            const Update& a = batch[x];
+            const Update& b = batch[y];
+            if (a.row != b.row) return a.row < b.row;
+            if (a.col != b.col) return a.col < b.col;
+            return x < y;
+        });
+        const std::vector<size_t> last_of_entry = parallel_compact(IterateOver::Range1D(order.size()), [&](size_t i) {
+            return i + 1 == order.size() || batch[order[i]].row != batch[order[i + 1]].row ||
+                   batch[order[i]].col != batch[order[i + 1]].col;
+        });
+        std::vector<uint32_t> ops(last_of_entry.size());
+        const long long n_ops = static_cast<long long>(ops.size());
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n_ops; ++i) ops[static_cast<size_t>(i)] = order[last_of_entry[static_cast<size_t>(i)]];
+        const std::vector<size_t> row_starts = parallel_compact(IterateOver::Range1D(ops.size()), [&](size_t i) {
+            return i == 0 || batch[ops[i]].row != batch[ops[i - 1]].row;
+        });
+
+        // 2. Size of every touched row after the merge
+        const size_t touched = row_starts.size();
+        const long long touched_ll = static_cast<long long>(touched);
+        auto ops_of = [&](size_t t) {
+            return std::pair<size_t, size_t>{row_starts[t], t + 1 < touched ? row_starts[t + 1] : ops.size()};
+        };
+        std::vector<size_t> offsets(touched + 1, 0);
+        long long nnz_delta = 0;
+        size_t new_rows = 0;
+        #pragma omp parallel for schedule(dynamic, 64) reduction(+ : nnz_delta, new_rows)
+        for (long long t = 0; t < touched_ll; ++t) {
+            const auto [first, last] = ops_of(static_cast<size_t>(t));
+            const size_t row = batch[ops[first]].row;
+            const RowView current = row_view(row);
+            offsets[t] = merge_row(current, batch, ops, first, last, nullptr, nullptr);
+            nnz_delta += static_cast<long long>(offsets[t]) - static_cast<long long>(current.num_non_zeros);
+            new_rows += active_.begin[row] == kNone;
+        }
+        detail::exclusive_scan_in_place(offsets);
+
+        // 3. Write the merged rows at the end of the arena
+        const size_t arena_start = active_.cols.size();
+        active_.cols.resize(arena_start + offsets[touched]);
+        active_.vals.resize(arena_start + offsets[touched]);
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (long long t = 0; t < touched_ll; ++t) {
+            const auto [first, last] = ops_of(static_cast<size_t>(t));
+            const size_t row = batch[ops[first]].row;
+            const size_t out = arena_start + offsets[t];
+            merge_row(row_view(row), batch, ops, first, last, active_.cols.data() + out, active_.vals.data() + out);
+            active_.begin[row] = out;
+            active_.length[row] = offsets[t + 1] - offsets[t];
+        }
+        active_.rows += new_rows;
+        nnz_ = static_cast<size_t>(static_cast<long long>(nnz_) + nnz_delta);
+
+        maybe_compact();
+    }
+
+    /// @brief Fold all overlays into a fresh base now (waits for a running background compaction)
+    void compact() {
+        wait_for_compaction();
+        base_ = merged(base_, active_);
+        active_.reset(num_rows());
+        ++compactions_;
+    }
+
+    /// @brief Start a background compaction unless one is running
+    /// @return Whether one was started
+    bool start_background_compaction() {
+        poll_compaction();
+        if (compacting_) return false;
+        std::swap(frozen_, active_);
+        active_.reset(num_rows());
+        compacting_ = true;
+        compaction_done_.store(false, std::memory_order_relaxed);
+        worker_ = std::thread([this] {
+            try {
+                // Reads only base_ and frozen_, which nothing modifies until the swap
+                next_base_ = merged(base_, frozen_);
+            } catch (...) {
+                worker_error_ = std::current_exception();
+            }
+            compaction_done_.store(true, std::memory_order_release);
+        });
+        return true;
+    }
+
+    /// @brief Swap in a finished background compaction, if any
+    /// @return Whether one was swapped in
+    bool poll_compaction() {
+        if (!compacting_ || !compaction_done_.load(std::memory_order_acquire)) return false;
+        finish_compaction();
+        return true;
+    }
+
+    void wait_for_compaction() {
+        if (compacting_) finish_compaction();
+    }
+
+    /// @brief Copy of the current contents as a CSRMatrixT
+    Matrix to_csr() const {
+        Matrix with_frozen(base_.get_allocator());
+        const Matrix* base = &base_;
+        if (compacting_) {
+            with_frozen = merged(base_, frozen_);
+            base = &with_frozen;
+        }
+        return merged(*base, active_);
+    }
+
+private:
+    static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+    /// Rewritten rows; begin/length are per matrix row, kNone if not present
+    struct Overlay {
+        std::vector<size_t> begin;
+        std::vector<size_t> length;
+        std::vector<size_t> cols;
+        std::vector<StorageT> vals;
+        size_t rows = 0;
+
+        void reset(size_t num_rows) {
+            begin.assign(num_rows, kNone);
+            length.assign(num_rows, 0);
+            cols.clear();
+            vals.clear();
+            rows = 0;
+        }
+    };
+
+    /// @brief Merge a sorted row with its reduced updates; out == nullptr only counts
+    static size_t merge_row(const RowView& row, const std::vector<Update>& batch, const std::vector<uint32_t>& ops,
+                            size_t first, size_t last, size_t* out_cols, StorageT* out_vals) {
+        size_t i = 0, n = 0;
+        for (size_t k = first; k < last; ++k) {
+            const Update& u = batch[ops[k]];
+            for (; i < row.num_non_zeros && row.col_indices_ptr[i] < u.col; ++i, ++n) {
+                if (out_cols) {
+                    out_cols[n] = row.col_indices_ptr[i];
+                    out_vals[n] = row.values_ptr[i];
+                }
+            }
+            if (i < row.num_non_zeros && row.col_indices_ptr[i] == u.col) ++i;   // Replaced or erased
+            if (u.kind == CSRUpdateKind::Insert) {
+                if (out_cols) {
+                    out_cols[n] = u.col;
+                    out_vals[n] = u.value;
+                }
+                ++n;
+            }
+        }
+        for (; i < row.num_non_zeros; ++i, ++n) {
+            if (out_cols) {
+                out_cols[n] = row.col_indices_ptr[i];
+                out_vals[n] = row.values_ptr[i];
+            }
+        }
+        return n;
+    }
+
+    /// @brief base with the rows of overlay substituted, as a new CSR
+    static Matrix merged(const Matrix& base, const Overlay& overlay) {
+        const size_t n_rows = base.num_rows();
+        const long long n_rows_ll = static_cast<long long>(n_rows);
+        auto row_of = [&](size_t r) {
+            if (overlay.begin[r] != kNone) {
+                return std::pair<const size_t*, size_t>{overlay.cols.data() + overlay.begin[r], overlay.length[r]};
+            }
+            return std::pair<const size_t*, size_t>{base.col_indices.data() + base.row_ptr[r],
+                                                    base.row_ptr[r + 1] - base.row_ptr[r]};
+        };
+        Matrix out(base.get_allocator());
+        out.row_ptr.assign(n_rows + 1, 0);
+        #pragma omp parallel for schedule(static)
+        for (long long r = 0; r < n_rows_ll; ++r) out.row_ptr[r] = row_of(static_cast<size_t>(r)).second;
+        detail::exclusive_scan_in_place(out.row_ptr);
+        out.col_indices.resize(out.row_ptr[n_rows]);
+        out.values.resize(out.row_ptr[n_rows]);
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (long long r = 0; r < n_rows_ll; ++r) {
+            const auto [cols, len] = row_of(static_cast<size_t>(r));
+            const StorageT* vals = overlay.begin[r] != kNone ? overlay.vals.data() + overlay.begin[r]
+                                                             : base.values.data() + base.row_ptr[r];
+            std::copy(cols, cols + len, out.col_indices.begin() + static_cast<std::ptrdiff_t>(out.row_ptr[r]));
+            std::copy(vals, vals + len, out.values.begin() + static_cast<std::ptrdiff_t>(out.row_ptr[r]));
+        }
+        return out;
+    }
+
+    void finish_compaction() {
+        worker_.join();
+        compacting_ = false;
+        if (worker_error_) {
+            // Keep serving base + frozen + active: fold the frozen rows back under the active ones
+            std::exception_ptr error = std::exchange(worker_error_, nullptr);
+            restore_frozen();
+            std::rethrow_exception(error);
+        }
+        base_ = std::move(next_base_);
+        next_base_ = Matrix(base_.get_allocator());
+        frozen_.reset(0);
+        ++compactions_;
+    }
+
+    void restore_frozen() {
+        Overlay combined = std::move(frozen_);
+        const size_t n_rows = num_rows();
+        for (size_t r = 0; r < n_rows; ++r) {
+            if (active_.begin[r] == kNone) continue;
+            if (combined.begin[r] == kNone) ++combined.rows;
+            combined.begin[r] = combined.cols.size();
+            combined.length[r] = active_.length[r];
+            combined.cols.insert(combined.cols.end(), active_.cols.begin() + static_cast<std::ptrdiff_t>(active_.begin[r]),
+                                 active_.cols.begin() + static_cast<std::ptrdiff_t>(active_.begin[r] + active_.length[r]));
+            combined.vals.insert(combined.vals.end(), active_.vals.begin() + static_cast<std::ptrdiff_t>(active_.begin[r]),
+                                 active_.vals.begin() + static_cast<std::ptrdiff_t>(active_.begin[r] + active_.length[r]));
+        }
+        active_ = std::move(combined);
+        frozen_.reset(0);
+    }
+
+    void maybe_compact() {
+        if (options_.compaction_threshold <= 0) return;
+        const double limit = options_.compaction_threshold * static_cast<double>(std::max<size_t>(base_.num_nonzeros(), 1024));
+        if (static_cast<double>(active_.cols.size()) < limit) return;
+        if (options_.background_compaction) {
+            start_background_compaction();
+        } else {
+            compact();
+        }
+    }
+
+    DynamicCSROptions options_;
+    Matrix base_;
+    Overlay active_;
+    Overlay frozen_;
+    size_t nnz_;
+    size_t compactions_ = 0;
+    bool compacting_ = false;
+    std::atomic<bool> compaction_done_{false};
+    std::thread worker_;
+    Matrix next_base_;
+    std::exception_ptr worker_error_;
+};
+
+namespace pmr {
+
+/// @brief DynamicCSRMatrix whose base arrays come from a std::pmr::memory_resource
+template<typename StorageT = float, typename ComputeT = default_compute_type_t<StorageT>>
+using DynamicCSRMatrix = accessor::DynamicCSRMatrix<StorageT, ComputeT, std::pmr::polymorphic_allocator<StorageT>>;
+
+} // namespace pmr
+
+} // namespace accessor
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <omp.h>
+#include <utility>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Sparse frontier: explicit list of active vertex ids
+struct SparseFrontier {
+    std::vector<size_t> vertices;   ///< Active vertex ids
+    size_t num_vertices;            ///< Size of the vertex universe
+
+    SparseFrontier() : num_vertices(0) {}
+    explicit SparseFrontier(size_t n) : num_vertices(n) {}
+
+    size_t size() const { return vertices.size(); }
+    bool empty() const { return vertices.empty(); }
+    void clear() { vertices.clear(); }
+};
+
+/// @brief Dense frontier: one bit per vertex
+/// @note insert/test use atomic word updates, so concurrent inserts from a
+///       parallel loop are safe even when vertices share a word.
+struct DenseFrontier {
+    static constexpr size_t bits_per_word = 64;
+
+    std::vector<uint64_t> words;
+    size_t num_vertices;
+
+    DenseFrontier() : num_vertices(0) {}
+    explicit DenseFrontier(size_t n) : words((n + bits_per_word - 1) / bits_per_word, 0), num_vertices(n) {}
+
+    static size_t word_of(size_t v) { return v / bits_per_word; }
+    static uint64_t mask_of(size_t v) { return uint64_t{1} << (v % bits_per_word); }
+
+    /// @brief Test membership of vertex v
+    bool test(size_t v) const {
+        uint64_t& word = const_cast<uint64_t&>(words[word_of(v)]);
+        return (std::atomic_ref<uint64_t>(word).load(std::memory_order_relaxed) & mask_of(v)) != 0;
+    }
+
+    /// @brief Insert vertex v
+    /// @return true if v was not present before this call
+    bool insert(size_t v) {
+        uint64_t old = std::atomic_ref<uint64_t>(words[word_of(v)]).fetch_or(mask_of(v), std::memory_order_relaxed);
+        return (old & mask_of(v)) == 0;
+    }
+
+    /// @brief Remove vertex v
+    void erase(size_t v) {
+        std::atomic_ref<uint64_t>(words[word_of(v)]).fetch_and(~mask_of(v), std::memory_order_relaxed);
+    }
+
+    /// @brief Number of active vertices (parallel popcount)
+    size_t count() const {
+        size_t total = 0;
+        const long long num_words = static_cast<long long>(words.size());
+        #pragma omp parallel for reduction(+:total) schedule(static)
+        for (long long w = 0; w < num_words; ++w) {
+            total += static_cast<size_t>(std::popcount(words[w]));
+        }
+        return total;
+    }
+
+    void clear() { std::fill(words.begin(), words.end(), uint64_t{0}); }
+};
+
+/// @brief Scatter a sparse frontier into a bitmap
+inline void sparse_to_dense(const SparseFrontier& src, DenseFrontier& dst) {
+    if (dst.num_vertices != src.num_vertices) {
+        dst = DenseFrontier(src.num_vertices);
+    } else {
+        dst.clear();
+    }
+    const long long n = static_cast<long long>(src.vertices.size());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n; ++i) {
+        dst.insert(src.vertices[i]);
+    }
+}
+
+/// @brief Compact a bitmap into a sorted vertex list
+/// @note Two passes over contiguous word blocks: per-thread popcount, then
+///       scatter at the exclusive prefix offset of each thread.
+inline void dense_to_sparse(const DenseFrontier& src, SparseFrontier& dst) {
+    dst.num_vertices = src.num_vertices;
+    const size_t num_words = src.words.size();
+    std::vector<size_t> offsets;
+
+    #pragma omp parallel
+    {
+        const size_t nthreads = static_cast<size_t>(omp_get_num_threads());
+        const size_t tid = static_cast<size_t>(omp_get_thread_num());
+        const size_t begin = num_words * tid / nthreads;
+        const size_t end = num_words * (tid + 1) / nthreads;
+
+        #pragma omp single
+        offsets.assign(nthreads + 1, 0);
+
+        size_t local = 0;
+        for (size_t w = begin; w < end; ++w) {
+            local += static_cast<size_t>(std::popcount(src.words[w]));
+        }
+        offsets[tid + 1] = local;
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (size_t t = 0; t < nthreads; ++t) {
+                offsets[t + 1] += offsets[t];
+            }
+            dst.vertices.resize(offsets[nthreads]);
+        }
+
+        size_t out = offsets[tid];
+        for (size_t w = begin; w < end; ++w) {
+            uint64_t bits = src.words[w];
+            while (bits != 0) {
+                dst.vertices[out++] = w * DenseFrontier::bits_per_word + static_cast<size_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+/// @brief Representation currently preferred by a Frontier
+enum class FrontierRepresentation {
+    Sparse,
+    Dense
+};
+
+/// @brief Frontier holding a sparse list and/or a bitmap, switching by size
+///
+/// Either representation may be materialized on demand; adapt() selects the
+/// preferred one from the active fraction so that small frontiers are walked
+/// as lists and large ones are tested as bitmaps.
+class Frontier {
+public:
+    static constexpr double default_dense_fraction = 1.0 / 20.0;
+
+    explicit Frontier(size_t num_vertices, double dense_fraction = default_dense_fraction)
+        : sparse_(num_vertices), dense_(num_vertices), dense_fraction_(dense_fraction) {}
+
+    /// @brief Replace the contents with a vertex list
+    void assign(SparseFrontier&& list) {
+        sparse_ = std::move(list);
+        count_ = sparse_.size();
+        sparse_valid_ = true;
+        dense_valid_ = false;
+        adapt();
+    }
+
+    /// @brief Replace the contents with a bitmap
+    void assign(DenseFrontier&& bitmap) {
+        dense_ = std::move(bitmap);
+        count_ = dense_.count();
+        dense_valid_ = true;
+        sparse_valid_ = false;
+        adapt();
+    }
+
+    void clear() {
+        sparse_.clear();
+        dense_.clear();
+        count_ = 0;
+        sparse_valid_ = true;
+        dense_valid_ = true;
+        repr_ = FrontierRepresentation::Sparse;
+    }
+
+    /// @brief Pick the representation by size and materialize it
+    void adapt() {
+        bool dense = static_cast<double>(count_) > dense_fraction_ * static_cast<double>(num_vertices());
+        repr_ = dense ? FrontierRepresentation::Dense : FrontierRepresentation::Sparse;
+        if (dense) {
+            ensure_dense();
+        } else {
+            ensure_sparse();
+        }
+    }
+
+    void ensure_sparse() {
+        if (!sparse_valid_) {
+            dense_to_sparse(dense_, sparse_);
+            sparse_valid_ = true;
+        }
+    }
+
+    void ensure_dense() {
+        if (!dense_valid_) {
+            sparse_to_dense(sparse_, dense_);
+            dense_valid_ = true;
+        }
+    }
+
+    size_t num_vertices() const { return sparse_.num_vertices; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    FrontierRepresentation representation() const { return repr_; }
+    bool has_sparse() const { return sparse_valid_; }
+    bool has_dense() const { return dense_valid_; }
+
+    const SparseFrontier& sparse() const { return sparse_; }
+    const DenseFrontier& dense() const { return dense_; }
+
+    /// @brief Mutable access for building accessors; callers must not
+    ///        change membership, or the other representation goes stale
+    SparseFrontier& sparse() { return sparse_; }
+    DenseFrontier& dense() { return dense_; }
+
+private:
+    SparseFrontier sparse_;
+    DenseFrontier dense_;
+    double dense_fraction_;
+    size_t count_ = 0;
+    bool sparse_valid_ = true;
+    bool dense_valid_ = true;
+    FrontierRepresentation repr_ = FrontierRepresentation::Sparse;
+};
+
+} // namespace accessor
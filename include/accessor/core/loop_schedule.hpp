@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <omp.h>
+
+namespace accessor {
+
+/// @brief OpenMP schedule kind of a parallel loop
+enum class ScheduleKind {
+    Static,    ///< Contiguous blocks fixed in advance
+    Dynamic,   ///< Chunks handed out on demand
+    Guided     ///< On-demand chunks shrinking towards the chunk size
+};
+
+/// @brief Schedule of the iterations of one custom_parallel_for call
+///
+/// The default (Static, chunk 0) is the plain `omp for` schedule used when no
+/// schedule is given. chunk 0 leaves the chunk size to the runtime.
+struct LoopSchedule {
+    ScheduleKind kind = ScheduleKind::Static;
+    size_t chunk = 0;
+
+    bool is_default() const { return kind == ScheduleKind::Static && chunk == 0; }
+
+    bool operator==(const LoopSchedule& o) const { return kind == o.kind && chunk == o.chunk; }
+    bool operator!=(const LoopSchedule& o) const { return !(*this == o); }
+};
+
+inline const char* to_string(ScheduleKind k) {
+    switch (k) {
+        case ScheduleKind::Dynamic: return "dynamic";
+        case ScheduleKind::Guided: return "guided";
+        default: return "static";
+    }
+}
+
+namespace detail {
+
+/// Installs a schedule for `omp for schedule(runtime)` loops started by the
+/// calling thread and restores the previous one on destruction
+class ScopedRuntimeSchedule {
+public:
+    explicit ScopedRuntimeSchedule(const LoopSchedule& s) {
+        omp_get_schedule(&saved_kind_, &saved_chunk_);
+        omp_sched_t kind = omp_sched_static;
+        if (s.kind == ScheduleKind::Dynamic) kind = omp_sched_dynamic;
+        if (s.kind == ScheduleKind::Guided) kind = omp_sched_guided;
+        omp_set_schedule(kind, static_cast<int>(s.chunk));
+    }
+    ~ScopedRuntimeSchedule() { omp_set_schedule(saved_kind_, saved_chunk_); }
+    ScopedRuntimeSchedule(const ScopedRuntimeSchedule&) = delete;
+    ScopedRuntimeSchedule& operator=(const ScopedRuntimeSchedule&) = delete;
+
+private:
+    omp_sched_t saved_kind_;
+    int saved_chunk_;
+};
+
+} // namespace detail
+
+} // namespace accessor
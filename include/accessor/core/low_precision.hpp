@@ -0,0 +1,146 @@
+#pragma once
+
+#include <accessor/core/compiler_hints.hpp>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace accessor {
+
+/// @brief bfloat16 storage type (8-bit exponent, 7-bit mantissa)
+///
+/// Storage only: arithmetic happens after conversion to float.
+struct bfloat16 {
+    uint16_t bits = 0;
+
+    bfloat16() = default;
+    /// @brief Round to nearest even
+    explicit bfloat16(float f) {
+        uint32_t u = std::bit_cast<uint32_t>(f);
+        if ((u & 0x7fffffffu) > 0x7f800000u) {
+            bits = static_cast<uint16_t>((u >> 16) | 0x0040u);  // quiet NaN
+        } else {
+            bits = static_cast<uint16_t>((u + 0x7fffu + ((u >> 16) & 1u)) >> 16);
+        }
+    }
+    operator float() const { return std::bit_cast<float>(static_cast<uint32_t>(bits) << 16); }
+};
+
+/// @brief IEEE 754 binary16 storage type
+///
+/// Uses F16C instructions when the target enables them, a bit-exact
+/// software conversion otherwise.
+struct half {
+    uint16_t bits = 0;
+
+    half() = default;
+    /// @brief Round to nearest even
+    explicit half(float f) : bits(from_float(f)) {}
+    operator float() const { return to_float(bits); }
+
+    static uint16_t from_float(float f) {
+#if defined(__F16C__)
+        return static_cast<uint16_t>(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#else
+        uint32_t u = std::bit_cast<uint32_t>(f);
+        uint32_t sign = (u >> 16) & 0x8000u;
+        uint32_t abs = u & 0x7fffffffu;
+        if (abs >= 0x7f800000u) {  // Inf / NaN
+            return static_cast<uint16_t>(sign | 0x7c00u | (abs > 0x7f800000u ? 0x0200u : 0u));
+        }
+        if (abs >= 0x477ff000u) {  // Rounds to >= 65520: overflow
+            return static_cast<uint16_t>(sign | 0x7c00u);
+        }
+        if (abs < 0x38800000u) {   // Subnormal half (or zero)
+            // Add 0.5 so the float adder does the round-to-nearest-even
+            float scaled = std::bit_cast<float>(abs) + 0.5f;
+            return static_cast<uint16_t>(sign | (std::bit_cast<uint32_t>(scaled) - 0x3f000000u));
+        }
+        uint32_t mant_odd = (abs >> 13) & 1u;
+        abs += 0xc8000fffu + mant_odd;  // Rebias exponent (-112 << 23) and round
+        return static_cast<uint16_t>(sign | (abs >> 13));
+#endif
+    }
+
+    static float to_float(uint16_t h) {
+#if defined(__F16C__)
+        return _cvtsh_ss(h);
+#else
+        uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+        uint32_t exp = (h >> 10) & 0x1fu;
+        uint32_t mant = h & 0x3ffu;
+        if (exp == 0x1fu) {
+            return std::bit_cast<float>(sign | 0x7f800000u | (mant << 13));
+        }
+        if (exp == 0) {
+            // Subnormal: mant * 2^-24
+            float magnitude = static_cast<float>(mant) * (1.0f / 16777216.0f);
+            return std::bit_cast<float>(sign | std::bit_cast<uint32_t>(magnitude));
+        }
+        return std::bit_cast<float>(sign | ((exp + 112u) << 23) | (mant << 13));
+#endif
+    }
+};
+
+/// @brief Type kernels compute in when reading a given storage type
+template<typename Storage>
+struct default_compute_type { using type = Storage; };
+
+template<> struct default_compute_type<bfloat16> { using type = float; };
+template<> struct default_compute_type<half> { using type = float; };
+
+template<typename Storage>
+using default_compute_type_t = typename default_compute_type<Storage>::type;
+
+/// @brief Convert a contiguous run of stored values to the compute type
+///
+/// Plain loops for bfloat16 (a shift) and float/double widening
+/// auto-vectorize; binary16 uses 8-wide F16C conversion when available.
+template<typename Storage, typename Compute>
+inline void convert_n(const Storage* ACCESSOR_RESTRICT src, Compute* ACCESSOR_RESTRICT dst, size_t n) {
+    if constexpr (std::is_same_v<Storage, bfloat16>) {
+        const uint16_t* bits = reinterpret_cast<const uint16_t*>(src);
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = static_cast<Compute>(std::bit_cast<float>(static_cast<uint32_t>(bits[i]) << 16));
+        }
+    } else if constexpr (std::is_same_v<Storage, half>) {
+        size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+        if constexpr (std::is_same_v<Compute, float>) {
+            for (; i + 8 <= n; i += 8) {
+                __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            dst[i] = static_cast<Compute>(half::to_float(src[i].bits));
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = static_cast<Compute>(src[i]);
+        }
+    }
+}
+
+/// @brief Convert one stored value to the compute type
+template<typename Compute, typename Storage>
+inline Compute to_compute(const Storage& s) {
+    return static_cast<Compute>(static_cast<std::conditional_t<std::is_class_v<Storage>, float, Storage>>(s));
+}
+
+/// @brief Convert one compute value to the storage type
+template<typename Storage, typename Compute>
+inline Storage to_storage(const Compute& c) {
+    if constexpr (std::is_class_v<Storage>) {
+        return Storage(static_cast<float>(c));
+    } else {
+        return static_cast<Storage>(c);
+    }
+}
+
+} // namespace accessor
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <source_location>
+#include <vector>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace accessor {
+
+/// @brief Counters of a memory resource
+struct AllocationStats {
+    size_t allocations = 0;          ///< do_allocate calls
+    size_t bytes = 0;                ///< Bytes handed out
+    size_t system_allocations = 0;   ///< Chunks obtained from the system
+    size_t system_bytes = 0;
+};
+
+/// @brief Bump allocator over large, reusable chunks
+///
+/// Allocation moves a pointer; deallocation does nothing, memory comes back
+/// all at once with rewind(mark) or reset(). Chunks stay mapped after a
+/// rewind, so a loop that needs the same temporaries on every call stops
+/// touching the system allocator (and taking page faults) after the first
+/// one. On Linux chunks are 2 MiB-aligned anonymous mappings advised for
+/// transparent huge pages; elsewhere they come from aligned operator new.
+///
+/// Not thread-safe: an arena serves one thread at a time. thread_arena()
+/// gives every thread its own.
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t huge_page_bytes = size_t{2} << 20;
+
+    /// @brief Position of the bump pointer, for rewind()
+    struct Mark {
+        size_t chunk = 0;
+        size_t offset = 0;
+    };
+
+    /// @param chunk_bytes Size of each chunk (larger requests get a chunk of their own)
+    explicit ArenaResource(size_t chunk_bytes = huge_page_bytes)
+        : chunk_bytes_(std::max<size_t>(round_up(chunk_bytes, 4096), 4096)) {}
+
+    ~ArenaResource() override {
+        for (const Chunk& c : chunks_) system_free(c);
+    }
+
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+
+    Mark mark() const { return {current_, offset_}; }
+
+    /// @brief Frees everything allocated since m was taken
+    void rewind(Mark m) {
+        current_ = m.chunk;
+        offset_ = m.offset;
+    }
+
+    /// @brief Frees everything; the chunks are kept for reuse
+    void reset() { rewind({}); }
+
+    /// @brief Returns chunks past the bump pointer to the system
+    void trim() {
+        const size_t keep = chunks_.empty() ? 0 : current_ + 1;
+        for (size_t i = keep; i < chunks_.size(); ++i) system_free(chunks_[i]);
+        chunks_.resize(std::min(keep, chunks_.size()));
+    }
+
+    /// @brief Bytes currently obtained from the system
+    size_t reserved_bytes() const {
+        size_t total = 0;
+        for (const Chunk& c : chunks_) total += c.size;
+        return total;
+    }
+
+    const AllocationStats& stats() const { return stats_; }
+    void reset_stats() { stats_ = {}; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++stats_.allocations;
+        stats_.bytes += bytes;
+        for (;; ++current_, offset_ = 0) {
+            if (current_ == chunks_.size()) {
+                chunks_.push_back(system_allocate(std::max(chunk_bytes_, round_up(bytes + alignment, 4096))));
+            }
+            const Chunk& c = chunks_[current_];
+            const size_t start = round_up(offset_, alignment);
+            if (start <= c.size && bytes <= c.size - start) {
+                offset_ = start + bytes;
+                return c.data + start;
+            }
+        }
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    struct Chunk {
+        std::byte* data;
+        size_t size;
+    };
+
+    static size_t round_up(size_t x, size_t a) { return (x + a - 1) / a * a; }
+
+    Chunk system_allocate(size_t size) {
+        ++stats_.system_allocations;
+        stats_.system_bytes += size;
+#if defined(__linux__)
+        // Over-map by one huge page and cut the ends off so the chunk is
+        // 2 MiB-aligned and eligible for transparent huge pages
+        const size_t mapped = size + huge_page_bytes;
+        void* p = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        const uintptr_t base = reinterpret_cast<uintptr_t>(p);
+        const uintptr_t aligned = round_up(base, huge_page_bytes);
+        if (aligned > base) ::munmap(p, aligned - base);
+        const size_t tail = base + mapped - (aligned + size);
+        if (tail > 0) ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+#ifdef MADV_HUGEPAGE
+        ::madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);   // best effort
+#endif
+        return {reinterpret_cast<std::byte*>(aligned), size};
+#else
+        return {static_cast<std::byte*>(::operator new(size, std::align_val_t{huge_page_bytes})), size};
+#endif
+    }
+
+    static void system_free(const Chunk& c) {
+#if defined(__linux__)
+        ::munmap(c.data, c.size);
+#else
+        ::operator delete(c.data, std::align_val_t{huge_page_bytes});
+#endif
+    }
+
+    size_t chunk_bytes_;
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;
+    size_t offset_ = 0;
+    AllocationStats stats_;
+};
+
+/// @brief The calling thread's arena, the default home of library temporaries
+inline ArenaResource& thread_arena() {
+    thread_local ArenaResource arena;
+    return arena;
+}
+
+/// @brief Forwards to an upstream resource and counts what passes through
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+
+    const AllocationStats& stats() const { return stats_; }
+    void reset_stats() { stats_ = {}; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++stats_.allocations;
+        stats_.bytes += bytes;
+        return upstream_->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override { upstream_->deallocate(p, bytes, alignment); }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    std::pmr::memory_resource* upstream_;
+    AllocationStats stats_;
+};
+
+/// @brief Where a parallel call takes its temporaries from
+///
+/// Buffers of auto-buffered accessors, reduction partials, scan carries and
+/// team state are allocated from `memory` and released before the call
+/// returns. The default (nullptr) is the calling thread's arena, rewound at
+/// the end of every call. Any other resource is used as is, e.g.
+/// std::pmr::new_delete_resource() for the global heap or a
+/// CountingResource to measure a call.
+///
+/// `site` is where the context was built and identifies the call for
+/// BufferingHints. Write the context in the call expression (or give each
+/// call its own) so separate calls do not share hints; contexts built
+/// inside the library carry no site, and such calls always buffer.
+struct ExecutionContext {
+    std::pmr::memory_resource* memory = nullptr;
+    std::source_location site = std::source_location::current();
+};
+
+namespace detail {
+
+/// Resource for the temporaries of one call. Arenas (the default thread
+/// arena, or an ArenaResource passed explicitly) are rewound on exit.
+class ScratchScope {
+public:
+    explicit ScratchScope(const ExecutionContext& ctx)
+        : arena_(ctx.memory ? dynamic_cast<ArenaResource*>(ctx.memory) : &thread_arena()),
+          resource_(ctx.memory ? ctx.memory : arena_),
+          mark_(arena_ ? arena_->mark() : ArenaResource::Mark{}) {}
+    ~ScratchScope() {
+        if (arena_) arena_->rewind(mark_);
+    }
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    std::pmr::memory_resource* resource() const { return resource_; }
+
+private:
+    ArenaResource* arena_;
+    std::pmr::memory_resource* resource_;
+    ArenaResource::Mark mark_;
+};
+
+} // namespace detail
+
+} // namespace accessor
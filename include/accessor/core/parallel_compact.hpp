@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <omp.h>
+#include <type_traits>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Parallel stream compaction over an iteration space
+///
+/// Each thread evaluates the predicate once over a contiguous block of
+/// global indices and keeps the flags, the per-thread counts are prefix
+/// summed, then every thread scatters its selected ids at its offset.
+/// The output preserves iteration order.
+/// @param iter_space Any type with size() and operator[](size_t)
+/// @param pred Callable taking an item id and returning bool
+/// @return Selected item ids in iteration order
+template<typename IterSpaceType, typename Predicate>
+auto parallel_compact(const IterSpaceType& iter_space, Predicate&& pred) {
+    using ItemIDType = std::decay_t<decltype(iter_space[size_t{0}])>;
+    const size_t n = iter_space.size();
+    std::vector<ItemIDType> selected;
+    std::vector<unsigned char> flags(n);
+    std::vector<size_t> offsets;
+
+    #pragma omp parallel
+    {
+        const size_t nthreads = static_cast<size_t>(omp_get_num_threads());
+        const size_t tid = static_cast<size_t>(omp_get_thread_num());
+        const size_t begin = n * tid / nthreads;
+        const size_t end = n * (tid + 1) / nthreads;
+
+        #pragma omp single
+        offsets.assign(nthreads + 1, 0);
+
+        // 1. Predicate
+        size_t local = 0;
+        for (size_t i = begin; i < end; ++i) {
+            bool keep = static_cast<bool>(pred(iter_space[i]));
+            flags[i] = keep;
+            local += keep;
+        }
+        offsets[tid + 1] = local;
+
+        // 2. Prefix sum of per-thread counts
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (size_t t = 0; t < nthreads; ++t) {
+                offsets[t + 1] += offsets[t];
+            }
+            selected.resize(offsets[nthreads]);
+        }
+
+        // 3. Scatter
+        size_t out = offsets[tid];
+        for (size_t i = begin; i < end; ++i) {
+            if (flags[i]) {
+                selected[out++] = iter_space[i];
+            }
+        }
+    }
+    return selected;
+}
+
+} // namespace accessor
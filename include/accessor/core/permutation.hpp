@@ -0,0 +1,120 @@
+#pragma once
+
+#include "csr_matrix.hpp"
+#include "custom_parallel_scan.hpp"
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Bijection between original ("old") and reordered ("new") ids
+struct Permutation {
+    std::vector<size_t> new_to_old;
+    std::vector<size_t> old_to_new;
+
+    Permutation() = default;
+
+    /// @brief Build from the new->old map; the inverse is derived
+    explicit Permutation(std::vector<size_t> new_to_old_map)
+        : new_to_old(std::move(new_to_old_map)), old_to_new(new_to_old.size()) {
+        const long long n = static_cast<long long>(new_to_old.size());
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n; ++i) {
+            old_to_new[new_to_old[i]] = static_cast<size_t>(i);
+        }
+    }
+
+    static Permutation identity(size_t n) {
+        std::vector<size_t> ids(n);
+        std::iota(ids.begin(), ids.end(), size_t{0});
+        return Permutation(std::move(ids));
+    }
+
+    size_t size() const { return new_to_old.size(); }
+
+    Permutation inverse() const {
+        Permutation inv;
+        inv.new_to_old = old_to_new;
+        inv.old_to_new = new_to_old;
+        return inv;
+    }
+};
+
+/// @brief Symmetric permutation B = P A P^T of a square matrix
+///
+/// Row i of B is row new_to_old[i] of A with columns renumbered through
+/// old_to_new and sorted, so B is a plain CSRMatrix in the new numbering.
+inline CSRMatrix permute_matrix(const CSRMatrix& a, const Permutation& p) {
+    const size_t n = a.num_rows();
+    const long long n_ll = static_cast<long long>(n);
+    CSRMatrix b;
+    b.row_ptr.assign(n + 1, 0);
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n_ll; ++i) {
+        size_t r = p.new_to_old[i];
+        b.row_ptr[i] = a.row_ptr[r + 1] - a.row_ptr[r];
+    }
+    {
+        Accessor<std::vector<size_t>, AccessMode::Read> in(b.row_ptr);
+        Accessor<std::vector<size_t>, AccessMode::Write> out(b.row_ptr);
+        custom_parallel_scan(IterateOver::Range1D(n + 1), ScanKind::Exclusive, size_t{0}, std::plus<>{}, in, out);
+    }
+
+    b.col_indices.resize(a.num_nonzeros());
+    b.values.resize(a.num_nonzeros());
+    #pragma omp parallel
+    {
+        std::vector<std::pair<size_t, float>> row;
+        #pragma omp for schedule(dynamic, 256)
+        for (long long i = 0; i < n_ll; ++i) {
+            size_t r = p.new_to_old[i];
+            row.clear();
+            for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) {
+                row.emplace_back(p.old_to_new[a.col_indices[k]], a.values[k]);
+            }
+            std::sort(row.begin(), row.end(),
+                [](const auto& x, const auto& y) { return x.first < y.first; });
+            size_t out = b.row_ptr[i];
+            for (auto& [col, val] : row) {
+                b.col_indices[out] = col;
+                b.values[out] = val;
+                ++out;
+            }
+        }
+    }
+    return b;
+}
+
+/// @brief Gather a vector into the new numbering: out[new] = in[new_to_old[new]]
+///
+/// A resized out keeps its allocator.
+template<typename T, typename C, typename InAlloc, typename OutAlloc>
+void permute_vector(const DenseArray1D<T, C, InAlloc>& in, const Permutation& p, DenseArray1D<T, C, OutAlloc>& out) {
+    const long long n = static_cast<long long>(p.size());
+    if (out.size() != p.size()) out = DenseArray1D<T, C, OutAlloc>(p.size(), out.get_allocator());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n; ++i) {
+        out.data[i] = in.data[p.new_to_old[i]];
+    }
+}
+
+/// @brief Scatter a vector back to the old numbering: out[new_to_old[new]] = in[new]
+///
+/// A resized out keeps its allocator.
+template<typename T, typename C, typename InAlloc, typename OutAlloc>
+void unpermute_vector(const DenseArray1D<T, C, InAlloc>& in, const Permutation& p, DenseArray1D<T, C, OutAlloc>& out) {
+    const long long n = static_cast<long long>(p.size());
+    if (out.size() != p.size()) out = DenseArray1D<T, C, OutAlloc>(p.size(), out.get_allocator());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n; ++i) {
+        out.data[p.new_to_old[i]] = in.data[i];
+    }
+}
+
+} // namespace accessor
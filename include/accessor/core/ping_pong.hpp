@@ -0,0 +1,50 @@
+#pragma once
+
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <cstddef>
+#include <utility>
+
+namespace accessor {
+
+/// @brief Two copies of a data structure for read-old/write-new sweeps
+///
+/// Each sweep reads current() and writes next(), then swap() flips the
+/// roles. Because the read and write accessors refer to different objects,
+/// custom_parallel_for sees no conflict and skips the full-copy auto-buffer
+/// and write-back. Items a sweep does not write (e.g. boundaries) keep the
+/// value from two sweeps ago, so both copies start from the same data.
+template<typename DS_Type>
+class PingPong {
+public:
+    explicit PingPong(const DS_Type& initial) : grids_{initial, initial}, current_(0) {}
+
+    DS_Type& current() { return grids_[current_]; }
+    const DS_Type& current() const { return grids_[current_]; }
+    DS_Type& next() { return grids_[1 - current_]; }
+    const DS_Type& next() const { return grids_[1 - current_]; }
+
+    void swap() { current_ = 1 - current_; }
+
+private:
+    DS_Type grids_[2];
+    int current_;
+};
+
+/// @brief Run `steps` read-old/write-new sweeps over a PingPong pair
+///
+/// The kernel is called as kernel(id, read_acc, write_acc, extra...) with a
+/// Read accessor on current() and a Write accessor on next(); the pair is
+/// swapped after every sweep, so current() holds the result.
+template<typename IterSpaceType, typename DS_Type, typename KernelFunc, typename... AccessorTypes>
+void ping_pong_sweeps(const IterSpaceType& iter_space, PingPong<DS_Type>& grids, size_t steps,
+                      KernelFunc&& kernel, AccessorTypes&... accessors) {
+    for (size_t s = 0; s < steps; ++s) {
+        Accessor<DS_Type, AccessMode::Read> read_acc(grids.current());
+        Accessor<DS_Type, AccessMode::Write> write_acc(grids.next());
+        custom_parallel_for(iter_space, kernel, read_acc, write_acc, accessors...);
+        grids.swap();
+    }
+}
+
+} // namespace accessor
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace accessor {
+
+/// @brief How a data structure carries out Reduce-mode updates
+enum class ReduceImplKind {
+    DeviceAtomic,               ///< Atomic read-modify-write on the shared structure
+    LocalBufferAndFinalReduce,  ///< Per-thread partial results merged when the loop ends
+    Undefined                   ///< No preference; the traits pick their default
+};
+
+/// @brief Recommended reduction strategy for a (structure, value, operator) combination
+///
+/// Specialize to steer a particular operator, e.g. a non-commutative or
+/// expensive one, towards per-thread buffering. The value is passed to
+/// DataStructureTraits::apply_reduction_impl as a hint.
+template<typename DS_Type, typename ValueType, typename ReduceOp>
+struct ReduceSemanticsPolicy {
+    static constexpr ReduceImplKind impl_kind = ReduceImplKind::Undefined;
+};
+
+} // namespace accessor
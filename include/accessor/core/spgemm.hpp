@@ -0,0 +1,400 @@
+#pragma once
+
+#include "csr_builder.hpp"
+#include "csr_matrix.hpp"
+#include "low_precision.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Accumulator used for an output row of a SpGEMM
+enum class SpGEMMAccumulator {
+    Auto,   ///< Dense when the output is narrow or the row is heavy, hash otherwise
+    Hash,
+    Dense,
+};
+
+struct SpGEMMOptions {
+    SpGEMMAccumulator accumulator = SpGEMMAccumulator::Auto;
+    /// Auto uses the dense accumulator for every row when the output has at
+    /// most this many columns (its per-thread index then stays in cache)
+    size_t dense_max_columns = size_t{1} << 17;
+    /// Otherwise Auto uses it for rows whose flop count exceeds this
+    /// fraction of the output columns
+    double dense_row_fraction = 1.0 / 16.0;
+};
+
+/// @brief Structure of C = A B computed by spgemm_symbolic
+///
+/// Columns are sorted within each row. A later spgemm_numeric with the same
+/// A and B structure only recomputes values.
+struct SpGEMMPattern {
+    size_t num_rows = 0;
+    size_t num_cols = 0;
+    std::vector<size_t> row_ptr;
+    std::vector<size_t> col_indices;
+    size_t flops = 0;        ///< Multiply-adds of one numeric phase
+    size_t dense_rows = 0;   ///< Rows using the dense accumulator
+    size_t a_nonzeros = 0;   ///< Nonzeros of A and B the pattern was computed from
+    size_t b_rows = 0;
+    size_t b_nonzeros = 0;
+    SpGEMMOptions options;
+
+    size_t num_nonzeros() const { return col_indices.size(); }
+    bool empty() const { return row_ptr.empty(); }
+};
+
+namespace detail {
+
+/// @brief Per-thread row accumulator: maps output columns to slots
+///
+/// Dense mode indexes a num_cols array directly; hash mode uses an open
+/// addressing table sized to a bound on the row's columns. Either way the distinct
+/// columns and their sums are kept in first-touch order, and sums follow
+/// the order of the row's products, so both modes give identical bits.
+template<typename T>
+class SpGEMMRowAccumulator {
+public:
+    static constexpr size_t kEmpty = std::numeric_limits<size_t>::max();
+
+    /// @param max_columns Upper bound on the row's distinct columns (sizes the hash table)
+    void begin_row(size_t max_columns, bool dense, size_t num_cols) {
+        dense_ = dense;
+        if (dense_) {
+            if (dense_slot_.size() < num_cols) dense_slot_.assign(num_cols, kEmpty);
+        } else {
+            size_t size = 16;
+            while (size < 2 * max_columns) size *= 2;
+            if (table_.size() < size) table_.resize(size, Entry{kEmpty, 0});
+            mask_ = size - 1;
+            max_columns_ = max_columns;
+        }
+    }
+
+    /// @brief Slot of col, created on first use; kEmpty if a hash-mode row
+    ///        would exceed max_columns distinct columns
+    size_t insert(size_t col) {
+        if (dense_) {
+            size_t& slot = dense_slot_[col];
+            if (slot == kEmpty) {
+                slot = columns_.size();
+                columns_.push_back(col);
+                sums_.push_back(T{});
+            }
+            return slot;
+        }
+        for (size_t h = hash(col);; h = (h + 1) & mask_) {
+            Entry& e = table_[h];
+            if (e.col == col) return e.slot;
+            if (e.col == kEmpty) {
+                if (columns_.size() == max_columns_) return kEmpty;
+                e = Entry{col, columns_.size()};
+                positions_.push_back(h);
+                columns_.push_back(col);
+                sums_.push_back(T{});
+                return e.slot;
+            }
+        }
+    }
+
+    /// @brief False (and nothing added) if col does not fit, see insert()
+    bool add(size_t col, T value) {
+        const size_t slot = insert(col);
+        if (slot == kEmpty) return false;
+        sums_[slot] += value;
+        return true;
+    }
+
+    /// @brief Sum accumulated for col, or nullptr if the row never inserted it
+    const T* find(size_t col) const {
+        if (dense_) {
+            const size_t slot = dense_slot_[col];
+            return slot == kEmpty ? nullptr : &sums_[slot];
+        }
+        for (size_t h = hash(col);; h = (h + 1) & mask_) {
+            if (table_[h].col == col) return &sums_[table_[h].slot];
+            if (table_[h].col == kEmpty) return nullptr;
+        }
+    }
+
+    const std::vector<size_t>& columns() const { return columns_; }
+
+    void end_row() {
+        // Only the touched entries are reset, so rows cost O(flops) whatever the table size
+        if (dense_) {
+            for (size_t c : columns_) dense_slot_[c] = kEmpty;
+        } else {
+            for (size_t h : positions_) table_[h].col = kEmpty;
+            positions_.clear();
+        }
+        columns_.clear();
+        sums_.clear();
+    }
+
+private:
+    struct Entry {
+        size_t col;
+        size_t slot;
+    };
+
+    size_t hash(size_t col) const { return static_cast<size_t>((col * 0x9E3779B97F4A7C15ull) >> 17) & mask_; }
+
+    bool dense_ = false;
+    size_t mask_ = 0;
+    size_t max_columns_ = 0;
+    std::vector<size_t> dense_slot_;
+    std::vector<Entry> table_;
+    std::vector<size_t> positions_;   ///< Table entries used by the current row
+    std::vector<size_t> columns_;
+    std::vector<T> sums_;
+};
+
+inline bool spgemm_row_is_dense(const SpGEMMOptions& options, size_t row_flops, size_t num_cols) {
+    switch (options.accumulator) {
+    case SpGEMMAccumulator::Dense: return true;
+    case SpGEMMAccumulator::Hash: return false;
+    default:
+        return num_cols <= options.dense_max_columns ||
+               static_cast<double>(row_flops) > options.dense_row_fraction * static_cast<double>(num_cols);
+    }
+}
+
+template<typename S, typename C, typename A>
+size_t max_column_plus_one(const CSRMatrixT<S, C, A>& m) {
+    size_t result = 0;
+    const long long nnz = static_cast<long long>(m.col_indices.size());
+    #pragma omp parallel for schedule(static) reduction(max : result)
+    for (long long k = 0; k < nnz; ++k) {
+        result = std::max(result, m.col_indices[static_cast<size_t>(k)] + 1);
+    }
+    return result;
+}
+
+} // namespace detail
+
+/// @brief Symbolic phase of C = A B: output structure
+///
+/// Per-row flop counts, per-row distinct column counts with per-thread
+/// accumulators, an exclusive scan into row_ptr, then each row's columns
+/// are written and sorted. Column indices of A must be rows of B.
+/// @param num_cols Columns of B (and C); 0 means one past the largest column index of B
+template<typename S, typename C, typename AA, typename BA>
+SpGEMMPattern spgemm_symbolic(const CSRMatrixT<S, C, AA>& a, const CSRMatrixT<S, C, BA>& b, size_t num_cols = 0,
+                              SpGEMMOptions options = {}) {
+    const size_t n_rows = a.num_rows();
+    const long long n_rows_ll = static_cast<long long>(n_rows);
+    SpGEMMPattern pattern;
+    pattern.num_rows = n_rows;
+    pattern.num_cols = num_cols != 0 ? num_cols : detail::max_column_plus_one(b);
+    pattern.options = options;
+    pattern.a_nonzeros = a.num_nonzeros();
+    pattern.b_rows = b.num_rows();
+    pattern.b_nonzeros = b.num_nonzeros();
+
+    // 1. Flops per row
+    std::vector<size_t> row_flops(n_rows);
+    size_t flops = 0, dense_rows = 0;
+    #pragma omp parallel for schedule(static) reduction(+ : flops, dense_rows)
+    for (long long r = 0; r < n_rows_ll; ++r) {
+        size_t f = 0;
+        for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) {
+            const size_t j = a.col_indices[k];
+            f += b.row_ptr[j + 1] - b.row_ptr[j];
+        }
+        row_flops[r] = f;
+        flops += f;
+        dense_rows += detail::spgemm_row_is_dense(options, f, pattern.num_cols);
+    }
+    pattern.flops = flops;
+    pattern.dense_rows = dense_rows;
+
+    // 2. Distinct columns per row, 3. prefix sum
+    pattern.row_ptr.assign(n_rows + 1, 0);
+    #pragma omp parallel
+    {
+        detail::SpGEMMRowAccumulator<char> acc;
+        #pragma omp for schedule(dynamic, 64)
+        for (long long r = 0; r < n_rows_ll; ++r) {
+            acc.begin_row(row_flops[r], detail::spgemm_row_is_dense(options, row_flops[r], pattern.num_cols),
+                          pattern.num_cols);
+            for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) {
+                const size_t j = a.col_indices[k];
+                for (size_t l = b.row_ptr[j]; l < b.row_ptr[j + 1]; ++l) acc.insert(b.col_indices[l]);
+            }
+            pattern.row_ptr[r] = acc.columns().size();
+            acc.end_row();
+        }
+    }
+    detail::exclusive_scan_in_place(pattern.row_ptr);
+
+    // 4. Sorted columns of each row
+    pattern.col_indices.resize(pattern.row_ptr[n_rows]);
+    #pragma omp parallel
+    {
+        detail::SpGEMMRowAccumulator<char> acc;
+        #pragma omp for schedule(dynamic, 64)
+        for (long long r = 0; r < n_rows_ll; ++r) {
+            acc.begin_row(row_flops[r], detail::spgemm_row_is_dense(options, row_flops[r], pattern.num_cols),
+                          pattern.num_cols);
+            for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) {
+                const size_t j = a.col_indices[k];
+                for (size_t l = b.row_ptr[j]; l < b.row_ptr[j + 1]; ++l) acc.insert(b.col_indices[l]);
+            }
+            auto out = pattern.col_indices.begin() + static_cast<std::ptrdiff_t>(pattern.row_ptr[r]);
+            std::copy(acc.columns().begin(), acc.columns().end(), out);
+            std::sort(out, out + static_cast<std::ptrdiff_t>(acc.columns().size()));
+            acc.end_row();
+        }
+    }
+    return pattern;
+}
+
+/// @brief Numeric phase of C = A B into an existing pattern
+///
+/// A and B must have the structure the pattern was computed from; their
+/// values may differ. Products are summed in the order of A's row and B's
+/// rows, independent of the thread count and the accumulator.
+/// @param c Output; its structure is replaced by the pattern's unless it already equals it
+/// @throws std::invalid_argument if the sizes of A or B differ from the ones
+///         the pattern was computed from, or a row produces columns the
+///         pattern does not have (c's values are then unspecified)
+template<typename S, typename C, typename AA, typename BA, typename CA>
+void spgemm_numeric(const SpGEMMPattern& pattern, const CSRMatrixT<S, C, AA>& a, const CSRMatrixT<S, C, BA>& b,
+                    CSRMatrixT<S, C, CA>& c) {
+    if (a.num_rows() != pattern.num_rows || a.num_nonzeros() != pattern.a_nonzeros) {
+        throw std::invalid_argument("spgemm_numeric: A does not match the pattern");
+    }
+    if (b.num_rows() != pattern.b_rows || b.num_nonzeros() != pattern.b_nonzeros) {
+        throw std::invalid_argument("spgemm_numeric: B does not match the pattern");
+    }
+    const size_t nnz = pattern.num_nonzeros();
+    // Comparing only reads; a matching structure is the common case
+    if (!std::ranges::equal(c.row_ptr, pattern.row_ptr)) {
+        c.row_ptr.assign(pattern.row_ptr.begin(), pattern.row_ptr.end());
+    }
+    if (!std::ranges::equal(c.col_indices, pattern.col_indices)) {
+        c.col_indices.assign(pattern.col_indices.begin(), pattern.col_indices.end());
+    }
+    c.values.resize(nnz);
+
+    const long long n_rows_ll = static_cast<long long>(pattern.num_rows);
+    const size_t num_cols = pattern.num_cols;
+    std::atomic<bool> mismatch{false};
+    #pragma omp parallel
+    {
+        detail::SpGEMMRowAccumulator<C> acc;
+        #pragma omp for schedule(dynamic, 64)
+        for (long long r = 0; r < n_rows_ll; ++r) {
+            const size_t out_begin = pattern.row_ptr[r], out_end = pattern.row_ptr[r + 1];
+            size_t row_flops = 0;
+            for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) {
+                row_flops += b.row_ptr[a.col_indices[k] + 1] - b.row_ptr[a.col_indices[k]];
+            }
+            // The pattern gives the exact number of distinct columns for the hash table
+            acc.begin_row(out_end - out_begin, detail::spgemm_row_is_dense(pattern.options, row_flops, pattern.num_cols),
+                          pattern.num_cols);
+            // A structure that differs despite matching sizes shows up as a
+            // column outside the pattern or more columns than the pattern's row
+            bool row_ok = true;
+            for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1] && row_ok; ++k) {
+                const size_t j = a.col_indices[k];
+                const C a_val = to_compute<C>(a.values[k]);
+                for (size_t l = b.row_ptr[j]; l < b.row_ptr[j + 1]; ++l) {
+                    const size_t col = b.col_indices[l];
+                    if (col >= num_cols || !acc.add(col, a_val * to_compute<C>(b.values[l]))) {
+                        row_ok = false;
+                        break;
+                    }
+                }
+            }
+            row_ok = row_ok && acc.columns().size() == out_end - out_begin;
+            for (size_t k = out_begin; k < out_end && row_ok; ++k) {
+                const C* sum = acc.find(pattern.col_indices[k]);
+                if (!sum) {
+                    row_ok = false;
+                    break;
+                }
+                c.values[k] = to_storage<S>(*sum);
+            }
+            if (!row_ok) mismatch.store(true, std::memory_order_relaxed);
+            acc.end_row();
+        }
+    }
+    if (mismatch.load()) {
+        throw std::invalid_argument("spgemm_numeric: A or B has a different structure than the pattern");
+    }
+}
+
+/// @brief C = A B, allocated with A's allocator
+template<typename S, typename C, typename AA, typename BA>
+CSRMatrixT<S, C, AA> spgemm(const CSRMatrixT<S, C, AA>& a, const CSRMatrixT<S, C, BA>& b, SpGEMMOptions options = {}) {
+    SpGEMMPattern pattern = spgemm_symbolic(a, b, 0, options);
+    CSRMatrixT<S, C, AA> c(a.get_allocator());
+    spgemm_numeric(pattern, a, b, c);
+    return c;
+}
+
+/// @brief C = A B, keeping the pattern for later value-only products
+template<typename S, typename C, typename AA, typename BA>
+CSRMatrixT<S, C, AA> spgemm(const CSRMatrixT<S, C, AA>& a, const CSRMatrixT<S, C, BA>& b, SpGEMMPattern& pattern,
+                            SpGEMMOptions options = {}) {
+    pattern = spgemm_symbolic(a, b, 0, options);
+    CSRMatrixT<S, C, AA> c(a.get_allocator());
+    spgemm_numeric(pattern, a, b, c);
+    return c;
+}
+
+/// @brief A^T with sorted columns, allocated with A's allocator
+///
+/// Column histogram, prefix sum and an atomic scatter, then each output row
+/// is sorted by column, so the result does not depend on the thread count.
+/// @param num_cols Columns of A; 0 means one past the largest column index
+template<typename S, typename C, typename A>
+CSRMatrixT<S, C, A> transpose_csr(const CSRMatrixT<S, C, A>& a, size_t num_cols = 0) {
+    const size_t n_out = num_cols != 0 ? num_cols : detail::max_column_plus_one(a);
+    const size_t nnz = a.num_nonzeros();
+    const long long n_rows_ll = static_cast<long long>(a.num_rows());
+    const long long n_out_ll = static_cast<long long>(n_out);
+
+    CSRMatrixT<S, C, A> t(a.get_allocator());
+    t.row_ptr.assign(n_out + 1, 0);
+    const long long nnz_ll = static_cast<long long>(nnz);
+    #pragma omp parallel for schedule(static)
+    for (long long k = 0; k < nnz_ll; ++k) {
+        std::atomic_ref<size_t>(t.row_ptr[a.col_indices[k]]).fetch_add(1, std::memory_order_relaxed);
+    }
+    detail::exclusive_scan_in_place(t.row_ptr);
+
+    std::vector<std::pair<size_t, S>> entries(nnz);
+    std::vector<size_t> cursor(t.row_ptr.begin(), t.row_ptr.end() - 1);
+    #pragma omp parallel for schedule(static)
+    for (long long r = 0; r < n_rows_ll; ++r) {
+        for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) {
+            const size_t pos = std::atomic_ref<size_t>(cursor[a.col_indices[k]]).fetch_add(1, std::memory_order_relaxed);
+            entries[pos] = {static_cast<size_t>(r), a.values[k]};
+        }
+    }
+
+    t.col_indices.resize(nnz);
+    t.values.resize(nnz);
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long r = 0; r < n_out_ll; ++r) {
+        auto first = entries.begin() + static_cast<std::ptrdiff_t>(t.row_ptr[r]);
+        auto last = entries.begin() + static_cast<std::ptrdiff_t>(t.row_ptr[r + 1]);
+        std::sort(first, last, [](const auto& x, const auto& y) { return x.first < y.first; });
+        for (size_t k = t.row_ptr[r]; k < t.row_ptr[r + 1]; ++k) {
+            t.col_indices[k] = entries[k].first;
+            t.values[k] = entries[k].second;
+        }
+    }
+    return t;
+}
+
+} // namespace accessor
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/// Iteration spaces with a static extent up to this size run as one fully
+/// unrolled sequence on the calling thread; define to override.
+#if !defined(ACCESSOR_STATIC_UNROLL_LIMIT)
+#define ACCESSOR_STATIC_UNROLL_LIMIT 64
+#endif
+
+namespace accessor {
+
+/// @brief Extent of a type whose size is only known at run time
+inline constexpr size_t dynamic_extent = std::numeric_limits<size_t>::max();
+
+/// @brief Compile-time size of an iteration space or data structure
+///
+/// Types with a `static constexpr size_t extent` member report it; all
+/// others report dynamic_extent.
+template<typename T>
+struct static_extent : std::integral_constant<size_t, dynamic_extent> {};
+
+template<typename T>
+    requires requires { { T::extent } -> std::convertible_to<size_t>; }
+struct static_extent<T> : std::integral_constant<size_t, T::extent> {};
+
+template<typename T>
+inline constexpr size_t static_extent_v = static_extent<std::remove_cvref_t<T>>::value;
+
+template<typename T>
+inline constexpr bool has_static_extent_v = static_extent_v<T> != dynamic_extent;
+
+/// @brief Call f(std::integral_constant<size_t, I>{}) for I = 0 .. N-1, unrolled
+template<size_t N, typename F>
+constexpr void static_for(F&& f) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<size_t, I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+/// @brief Turn a run-time size into a compile-time one
+///
+/// Calls f(std::integral_constant<size_t, N>{}) for the first N in Sizes
+/// equal to n, fallback(n) when none matches. Each size instantiates f once.
+template<size_t... Sizes, typename F, typename Fallback>
+decltype(auto) dispatch_static_extent(size_t n, F&& f, Fallback&& fallback) {
+    using Result = decltype(fallback(n));
+    if constexpr (std::is_void_v<Result>) {
+        const bool matched = ((n == Sizes ? (f(std::integral_constant<size_t, Sizes>{}), true) : false) || ...);
+        if (!matched) fallback(n);
+    } else {
+        Result result{};
+        const bool matched = ((n == Sizes ? (result = f(std::integral_constant<size_t, Sizes>{}), true) : false) || ...);
+        if (!matched) result = fallback(n);
+        return result;
+    }
+}
+
+/// @brief dispatch_static_extent over the sizes of typical small per-item kernels
+template<typename F, typename Fallback>
+decltype(auto) dispatch_common_extent(size_t n, F&& f, Fallback&& fallback) {
+    return dispatch_static_extent<1, 2, 3, 4, 6, 8, 9, 16>(n, std::forward<F>(f), std::forward<Fallback>(fallback));
+}
+
+} // namespace accessor
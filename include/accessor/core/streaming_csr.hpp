@@ -0,0 +1,296 @@
+#pragma once
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_file.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace accessor {
+
+struct StreamingOptions {
+    size_t block_nonzeros = size_t{1} << 22;   ///< Target nonzeros per block (a block holds at least one row)
+    size_t pipeline_depth = 2;                 ///< Blocks in memory at once: 2 = double, 3 = triple buffering
+    bool direct_io = false;                    ///< Read with O_DIRECT, bypassing the page cache
+};
+
+/// @brief Where the time of a streaming pass went
+///
+/// Reading and computing overlap, so total_seconds is close to
+/// max(read_seconds, compute_seconds) when the pipeline is deep enough.
+struct StreamingStats {
+    size_t blocks = 0;
+    size_t bytes_read = 0;
+    double read_seconds = 0;      ///< Loader thread time spent in reads
+    double compute_seconds = 0;   ///< Time spent in the block callback
+    double stall_seconds = 0;     ///< Time the callback side waited for a block
+    double total_seconds = 0;
+
+    double disk_gbps() const { return read_seconds > 0 ? static_cast<double>(bytes_read) / read_seconds / 1e9 : 0; }
+    double compute_gbps() const {
+        return compute_seconds > 0 ? static_cast<double>(bytes_read) / compute_seconds / 1e9 : 0;
+    }
+    double achieved_gbps() const {
+        return total_seconds > 0 ? static_cast<double>(bytes_read) / total_seconds / 1e9 : 0;
+    }
+};
+
+/// @brief Contiguous rows of a streamed matrix
+///
+/// matrix is an ordinary CSRMatrixT holding rows [first_row, first_row +
+/// matrix.num_rows()) renumbered from 0, with the original column indices.
+template<typename S, typename C>
+struct CSRBlock {
+    size_t index = 0;
+    size_t first_row = 0;
+    CSRMatrixT<S, C> matrix;
+};
+
+/// @brief Streams row blocks of a binary CSR file (see write_csr_file)
+///
+/// Only row_ptr is held in memory (8 bytes per row). for_each_block runs a
+/// loader thread that reads up to pipeline_depth blocks ahead with pread
+/// while the calling thread processes the current one, so the callback can
+/// use custom_parallel_for on the block without waiting for the disk.
+/// Block buffers are reused across blocks and passes.
+template<typename S, typename C = default_compute_type_t<S>>
+class StreamingCSRReader {
+public:
+    using Block = CSRBlock<S, C>;
+
+    explicit StreamingCSRReader(const std::string& path, StreamingOptions options = {}) : options_(options) {
+        if (options_.pipeline_depth == 0 || options_.block_nonzeros == 0) {
+            throw std::invalid_argument("StreamingCSRReader: pipeline depth and block size must be positive");
+        }
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("StreamingCSRReader: cannot open " + path);
+        }
+        try {
+            header_ = detail::read_csr_header<S>(fd_);
+            row_ptr_.resize(header_.num_rows + 1);
+            detail::pread_fully(fd_, row_ptr_.data(), row_ptr_.size() * sizeof(size_t), header_.row_ptr_offset);
+        } catch (...) {
+            ::close(fd_);
+            throw;
+        }
+        if (options_.direct_io) {
+            // Not every file system supports O_DIRECT (tmpfs does not); fall back to buffered reads
+            direct_fd_ = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+        }
+        plan_blocks();
+    }
+
+    ~StreamingCSRReader() {
+        if (direct_fd_ >= 0) ::close(direct_fd_);
+        ::close(fd_);
+    }
+    StreamingCSRReader(const StreamingCSRReader&) = delete;
+    StreamingCSRReader& operator=(const StreamingCSRReader&) = delete;
+
+    size_t num_rows() const { return header_.num_rows; }
+    size_t num_nonzeros() const { return header_.num_nonzeros; }
+    size_t num_blocks() const { return block_rows_.size() - 1; }
+    /// @brief First row of every block, plus num_rows() at the end
+    const std::vector<size_t>& block_rows() const { return block_rows_; }
+    const std::vector<size_t>& row_ptr() const { return row_ptr_; }
+    /// @brief Whether reads actually bypass the page cache
+    bool direct_io_active() const { return direct_fd_ >= 0; }
+
+    /// @brief Call fn(const Block&) on every block in row order
+    ///
+    /// Exceptions from fn or from reading stop the loader and propagate.
+    template<typename BlockFunc>
+    StreamingStats for_each_block(BlockFunc&& fn) {
+        using Clock = std::chrono::steady_clock;
+        const size_t blocks = num_blocks();
+        const size_t depth = std::min(options_.pipeline_depth, std::max<size_t>(blocks, 1));
+        slots_.resize(std::max(slots_.size(), depth));
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<bool> ready(depth, false);
+        bool stop = false;
+        std::exception_ptr load_error;
+        StreamingStats stats;
+        stats.blocks = blocks;
+        const auto start = Clock::now();
+
+        std::thread loader([&] {
+            for (size_t b = 0; b < blocks; ++b) {
+                const size_t slot = b % depth;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&] { return stop || !ready[slot]; });
+                    if (stop) return;
+                }
+                const auto t0 = Clock::now();
+                try {
+                    load_block(b, slots_[slot]);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    load_error = std::current_exception();
+                    cv.notify_all();
+                    return;
+                }
+                const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+                std::lock_guard<std::mutex> lock(mutex);
+                stats.read_seconds += seconds;
+                stats.bytes_read += slots_[slot].matrix.num_nonzeros() * (sizeof(size_t) + sizeof(S));
+                ready[slot] = true;
+                cv.notify_all();
+            }
+        });
+
+        try {
+            for (size_t b = 0; b < blocks; ++b) {
+                const size_t slot = b % depth;
+                const auto t0 = Clock::now();
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&] { return ready[slot] || load_error; });
+                    if (!ready[slot]) std::rethrow_exception(load_error);
+                }
+                const auto t1 = Clock::now();
+                fn(static_cast<const Block&>(slots_[slot]));
+                const auto t2 = Clock::now();
+                stats.stall_seconds += std::chrono::duration<double>(t1 - t0).count();
+                stats.compute_seconds += std::chrono::duration<double>(t2 - t1).count();
+                std::lock_guard<std::mutex> lock(mutex);
+                ready[slot] = false;
+                cv.notify_all();
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+                cv.notify_all();
+            }
+            loader.join();
+            throw;
+        }
+        loader.join();
+        stats.total_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return stats;
+    }
+
+private:
+    static constexpr size_t kStagingBytes = size_t{4} << 20;
+
+    struct AlignedFree {
+        void operator()(char* p) const { std::free(p); }
+    };
+
+    void plan_blocks() {
+        block_rows_.assign(1, 0);
+        const size_t n = num_rows();
+        size_t row = 0;
+        while (row < n) {
+            // Largest end with at most block_nonzeros nonzeros, but at least one row
+            const size_t limit = row_ptr_[row] + options_.block_nonzeros;
+            size_t end = static_cast<size_t>(std::upper_bound(row_ptr_.begin() + static_cast<std::ptrdiff_t>(row) + 1,
+                                                              row_ptr_.end(), limit) - row_ptr_.begin()) - 1;
+            row = std::max(end, row + 1);
+            block_rows_.push_back(row);
+        }
+    }
+
+    void load_block(size_t b, Block& block) {
+        const size_t first = block_rows_[b], last = block_rows_[b + 1];
+        const size_t nz_begin = row_ptr_[first], nnz = row_ptr_[last] - nz_begin;
+        block.index = b;
+        block.first_row = first;
+        block.matrix.row_ptr.resize(last - first + 1);
+        for (size_t r = first; r <= last; ++r) block.matrix.row_ptr[r - first] = row_ptr_[r] - nz_begin;
+        block.matrix.col_indices.resize(nnz);
+        block.matrix.values.resize(nnz);
+        read(block.matrix.col_indices.data(), nnz * sizeof(size_t), header_.col_indices_offset + nz_begin * sizeof(size_t));
+        read(block.matrix.values.data(), nnz * sizeof(S), header_.values_offset + nz_begin * sizeof(S));
+    }
+
+    void read(void* dst, size_t count, uint64_t offset) {
+        if (direct_fd_ < 0) {
+            detail::pread_fully(fd_, dst, count, offset);
+            return;
+        }
+        // O_DIRECT needs aligned offsets, lengths and buffers: read aligned
+        // chunks into a staging buffer and copy the wanted bytes out
+        constexpr uint64_t align = CSRFileHeader::kAlignment;
+        if (!staging_) {
+            staging_.reset(static_cast<char*>(std::aligned_alloc(align, kStagingBytes)));
+            if (!staging_) throw std::bad_alloc();
+        }
+        char* out = static_cast<char*>(dst);
+        while (count > 0) {
+            const uint64_t aligned = offset / align * align;
+            const size_t skip = static_cast<size_t>(offset - aligned);
+            const size_t want = static_cast<size_t>(std::min<uint64_t>(kStagingBytes, CSRFileHeader::align_up(skip + count)));
+            ssize_t n;
+            do {
+                n = ::pread(direct_fd_, staging_.get(), want, static_cast<off_t>(aligned));
+            } while (n < 0 && errno == EINTR);
+            if (n <= static_cast<ssize_t>(skip)) {
+                throw std::runtime_error("StreamingCSRReader: direct read failed");
+            }
+            const size_t got = std::min(count, static_cast<size_t>(n) - skip);
+            std::memcpy(out, staging_.get() + skip, got);
+            out += got;
+            count -= got;
+            offset += got;
+        }
+    }
+
+    StreamingOptions options_;
+    int fd_ = -1;
+    int direct_fd_ = -1;
+    CSRFileHeader header_{};
+    std::vector<size_t> row_ptr_;
+    std::vector<size_t> block_rows_;
+    std::vector<Block> slots_;
+    std::unique_ptr<char, AlignedFree> staging_;
+};
+
+/// @brief y = A x with A streamed from disk block by block
+///
+/// Each block's rows are computed with custom_parallel_for over
+/// IterateOver::CSRRows of the block while the loader reads the next one.
+/// x and y must be held in memory.
+template<typename S, typename C, typename T>
+StreamingStats streaming_spmv(StreamingCSRReader<S, C>& a, const DenseArray1D<T>& x, DenseArray1D<T>& y) {
+    if (y.size() < a.num_rows()) {
+        throw std::invalid_argument("streaming_spmv: y shorter than the number of rows");
+    }
+    Accessor<DenseArray1D<T>, AccessMode::Read> x_in(x);
+    Accessor<DenseArray1D<T>, AccessMode::Write> y_out(y);
+    return a.for_each_block([&](const CSRBlock<S, C>& block) {
+        Accessor<CSRMatrixT<S, C>, AccessMode::Read> mat(block.matrix);
+        const size_t first = block.first_row;
+        custom_parallel_for(IterateOver::CSRRows(block.matrix),
+            [first](size_t row, const auto& m, const auto& xv, auto& yv) {
+                auto view = m.get_view(row, GetCSRRowViewTag{});
+                T sum{};
+                for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                    sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+                }
+                yv.set_value_by_id(first + row, sum);
+            },
+            mat, x_in, y_out);
+    });
+}
+
+} // namespace accessor
@@ -0,0 +1,313 @@
+#pragma once
+#include "transport.hpp"
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/custom_parallel_reduce.hpp>
+#include <accessor/core/parallel_compact.hpp>
+#include <accessor/iteration/masked.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Contiguous blocks of global rows, one per rank
+struct RowPartition {
+    std::vector<size_t> offsets;   ///< Rank r owns rows [offsets[r], offsets[r + 1])
+
+    /// @brief Blocks of (almost) equal row count
+    static RowPartition uniform(size_t num_rows, int num_ranks) {
+        RowPartition p;
+        p.offsets.resize(static_cast<size_t>(num_ranks) + 1);
+        for (size_t r = 0; r <= static_cast<size_t>(num_ranks); ++r) {
+            p.offsets[r] = num_rows * r / static_cast<size_t>(num_ranks);
+        }
+        return p;
+    }
+
+    int num_ranks() const { return static_cast<int>(offsets.size()) - 1; }
+    size_t num_rows() const { return offsets.back(); }
+    size_t begin(int rank) const { return offsets[static_cast<size_t>(rank)]; }
+    size_t end(int rank) const { return offsets[static_cast<size_t>(rank) + 1]; }
+    size_t local_size(int rank) const { return end(rank) - begin(rank); }
+
+    int owner(size_t global_row) const {
+        return static_cast<int>(std::upper_bound(offsets.begin(), offsets.end(), global_row) - offsets.begin()) - 1;
+    }
+};
+
+/// @brief Which local entries go to and come from which rank in a halo exchange
+///
+/// Ghost entries from one owner are contiguous and ordered by global index,
+/// so every message is received straight into the ghost section of the
+/// vector; only the send side needs packing.
+struct HaloPlan {
+    std::vector<int> send_ranks;
+    std::vector<size_t> send_offsets;   ///< Into send_indices, size send_ranks + 1
+    std::vector<size_t> send_indices;   ///< Local rows to pack, grouped by destination
+    std::vector<int> recv_ranks;
+    std::vector<size_t> recv_offsets;   ///< Into the ghost section, size recv_ranks + 1
+
+    size_t send_volume() const { return send_indices.size(); }
+    size_t recv_volume() const { return recv_offsets.empty() ? 0 : recv_offsets.back(); }
+};
+
+/// @brief This rank's rows of a row-block distributed CSR matrix
+///
+/// Columns are renumbered locally: owned columns map to [0, local_rows)
+/// and the remote ("ghost") columns the block touches map to
+/// [local_rows, local_rows + num_ghosts), ordered by global index. The local
+/// matrix is an ordinary CSRMatrixT, so accessors and IterateOver::CSRRows
+/// work on it; interior_rows() only reference owned columns and can be
+/// computed before the halo arrives, boundary_rows() need ghosts.
+/// Construction is collective: it builds the HaloPlan with two rounds of
+/// messages (request counts, then requested indices).
+template<typename StorageT = double, typename ComputeT = default_compute_type_t<StorageT>>
+class DistributedCSRMatrix {
+public:
+    using Matrix = CSRMatrixT<StorageT, ComputeT>;
+
+    /// @param transport Transport shared by all ranks of the matrix
+    /// @param partition Row blocks of all ranks
+    /// @param local_rows This rank's rows with global column indices
+    DistributedCSRMatrix(Transport& transport, RowPartition partition, Matrix local_rows)
+        : transport_(&transport), partition_(std::move(partition)), local_(std::move(local_rows)) {
+        const int me = transport.rank();
+        if (partition_.num_ranks() != transport.size() || local_.num_rows() != partition_.local_size(me)) {
+            throw std::invalid_argument("DistributedCSRMatrix: partition does not match the transport or the local rows");
+        }
+        renumber_columns();
+        classify_rows();
+        build_plan();
+    }
+
+    /// @brief Take this rank's block out of a matrix every rank holds in full
+    static DistributedCSRMatrix from_global(Transport& transport, const RowPartition& partition, const Matrix& global) {
+        const int me = transport.rank();
+        const size_t begin = partition.begin(me), end = partition.end(me);
+        Matrix block;
+        block.row_ptr.assign(global.row_ptr.begin() + static_cast<std::ptrdiff_t>(begin),
+                             global.row_ptr.begin() + static_cast<std::ptrdiff_t>(end) + 1);
+        const size_t first = block.row_ptr.front();
+        for (size_t& p : block.row_ptr) p -= first;
+        block.col_indices.assign(global.col_indices.begin() + static_cast<std::ptrdiff_t>(first),
+                                 global.col_indices.begin() + static_cast<std::ptrdiff_t>(first + block.row_ptr.back()));
+        block.values.assign(global.values.begin() + static_cast<std::ptrdiff_t>(first),
+                            global.values.begin() + static_cast<std::ptrdiff_t>(first + block.row_ptr.back()));
+        return DistributedCSRMatrix(transport, partition, std::move(block));
+    }
+
+    Transport& transport() const { return *transport_; }
+    const RowPartition& partition() const { return partition_; }
+    const Matrix& local() const { return local_; }
+    size_t local_rows() const { return local_.num_rows(); }
+    size_t num_ghosts() const { return ghost_columns_.size(); }
+    size_t global_row(size_t local_row) const { return partition_.begin(transport_->rank()) + local_row; }
+
+    /// @brief Global indices of the ghost columns, in local order
+    const std::vector<size_t>& ghost_columns() const { return ghost_columns_; }
+    const HaloPlan& halo_plan() const { return plan_; }
+    const IterateOver::IndexList<size_t>& interior_rows() const { return interior_; }
+    const IterateOver::IndexList<size_t>& boundary_rows() const { return boundary_; }
+
+private:
+    void renumber_columns() {
+        const int me = transport_->rank();
+        const size_t begin = partition_.begin(me), end = partition_.end(me);
+        std::vector<size_t> remote;
+        for (size_t c : local_.col_indices) {
+            if (c < begin || c >= end) remote.push_back(c);
+        }
+        std::sort(remote.begin(), remote.end());
+        remote.erase(std::unique(remote.begin(), remote.end()), remote.end());
+        ghost_columns_ = std::move(remote);
+
+        const size_t n_local = end - begin;
+        const long long nnz = static_cast<long long>(local_.col_indices.size());
+        #pragma omp parallel for schedule(static)
+        for (long long k = 0; k < nnz; ++k) {
+            size_t& c = local_.col_indices[static_cast<size_t>(k)];
+            if (c >= begin && c < end) {
+                c -= begin;
+            } else {
+                c = n_local + static_cast<size_t>(std::lower_bound(ghost_columns_.begin(), ghost_columns_.end(), c) -
+                                                  ghost_columns_.begin());
+            }
+        }
+    }
+
+    void classify_rows() {
+        const size_t n_local = local_.num_rows();
+        const Matrix& m = local_;
+        auto touches_ghost = [&m, n_local](size_t row) {
+            for (size_t k = m.row_ptr[row]; k < m.row_ptr[row + 1]; ++k) {
+                if (m.col_indices[k] >= n_local) return true;
+            }
+            return false;
+        };
+        interior_ = IterateOver::IndexList<size_t>(
+            parallel_compact(IterateOver::Range1D(n_local), [&](size_t row) { return !touches_ghost(row); }));
+        boundary_ = IterateOver::IndexList<size_t>(parallel_compact(IterateOver::Range1D(n_local), touches_ghost));
+    }
+
+    void build_plan() {
+        Transport& t = *transport_;
+        const int me = t.rank(), p = t.size();
+        const size_t begin = partition_.begin(me);
+
+        // Ghosts are sorted, so each owner's ghosts form one contiguous range
+        std::vector<size_t> request_counts(static_cast<size_t>(p), 0);
+        for (size_t g : ghost_columns_) ++request_counts[static_cast<size_t>(partition_.owner(g))];
+        plan_.recv_offsets.push_back(0);
+        for (int r = 0; r < p; ++r) {
+            if (request_counts[static_cast<size_t>(r)] == 0) continue;
+            plan_.recv_ranks.push_back(r);
+            plan_.recv_offsets.push_back(plan_.recv_offsets.back() + request_counts[static_cast<size_t>(r)]);
+        }
+
+        // counts[r * p + q]: entries rank r needs from rank q
+        std::vector<size_t> counts(static_cast<size_t>(p) * static_cast<size_t>(p));
+        t.allgather(request_counts.data(), counts.data(), request_counts.size() * sizeof(size_t));
+
+        plan_.send_offsets.push_back(0);
+        for (int r = 0; r < p; ++r) {
+            const size_t n = counts[static_cast<size_t>(r) * static_cast<size_t>(p) + static_cast<size_t>(me)];
+            if (n == 0) continue;
+            plan_.send_ranks.push_back(r);
+            plan_.send_offsets.push_back(plan_.send_offsets.back() + n);
+        }
+        plan_.send_indices.resize(plan_.send_offsets.back());
+        for (size_t i = 0; i < plan_.send_ranks.size(); ++i) {
+            t.post_recv(plan_.send_ranks[i], plan_.send_indices.data() + plan_.send_offsets[i],
+                        (plan_.send_offsets[i + 1] - plan_.send_offsets[i]) * sizeof(size_t));
+        }
+        for (size_t i = 0; i < plan_.recv_ranks.size(); ++i) {
+            t.post_send(plan_.recv_ranks[i], ghost_columns_.data() + plan_.recv_offsets[i],
+                        (plan_.recv_offsets[i + 1] - plan_.recv_offsets[i]) * sizeof(size_t));
+        }
+        t.wait_all();
+        for (size_t& idx : plan_.send_indices) idx -= begin;
+    }
+
+    Transport* transport_;
+    RowPartition partition_;
+    Matrix local_;
+    std::vector<size_t> ghost_columns_;
+    IterateOver::IndexList<size_t> interior_;
+    IterateOver::IndexList<size_t> boundary_;
+    HaloPlan plan_;
+};
+
+/// @brief Vector distributed like the rows of a DistributedCSRMatrix, with
+///        room for the ghost entries that matrix needs
+///
+/// values holds the owned entries followed by the ghosts, matching the
+/// local column numbering, so an Accessor on values serves both. Ghosts are
+/// only meaningful after a halo exchange.
+template<typename T>
+class DistributedVector {
+public:
+    template<typename S, typename C>
+    explicit DistributedVector(const DistributedCSRMatrix<S, C>& layout)
+        : values(layout.local_rows() + layout.num_ghosts()), plan_(&layout.halo_plan()), transport_(&layout.transport()),
+          local_size_(layout.local_rows()), send_buffer_(layout.halo_plan().send_volume()) {}
+
+    size_t local_size() const { return local_size_; }
+    T& operator[](size_t local_idx) { return values.data[local_idx]; }
+    const T& operator[](size_t local_idx) const { return values.data[local_idx]; }
+
+    /// @brief Pack and post the halo messages; ghosts are valid after finish_halo_exchange()
+    void start_halo_exchange() {
+        const HaloPlan& plan = *plan_;
+        Accessor<DenseArray1D<T>, AccessMode::Read> in(values);
+        Accessor<DenseArray1D<T>, AccessMode::Write> out(send_buffer_);
+        const std::vector<size_t>& indices = plan.send_indices;
+        custom_parallel_for(IterateOver::Range1D(indices.size()),
+            [&indices](size_t i, const auto& v, auto& buf) { buf.set_value_by_id(i, v.get_value_by_id(indices[i])); },
+            in, out);
+        T* ghosts = values.data.data() + local_size_;
+        for (size_t i = 0; i < plan.recv_ranks.size(); ++i) {
+            transport_->post_recv(plan.recv_ranks[i], ghosts + plan.recv_offsets[i],
+                                  (plan.recv_offsets[i + 1] - plan.recv_offsets[i]) * sizeof(T));
+        }
+        for (size_t i = 0; i < plan.send_ranks.size(); ++i) {
+            transport_->post_send(plan.send_ranks[i], send_buffer_.data.data() + plan.send_offsets[i],
+                                  (plan.send_offsets[i + 1] - plan.send_offsets[i]) * sizeof(T));
+        }
+    }
+
+    void finish_halo_exchange() { transport_->wait_all(); }
+
+    void halo_exchange() {
+        start_halo_exchange();
+        finish_halo_exchange();
+    }
+
+    DenseArray1D<T> values;
+
+private:
+    const HaloPlan* plan_;
+    Transport* transport_;
+    size_t local_size_;
+    DenseArray1D<T> send_buffer_;
+};
+
+namespace detail {
+
+template<typename RowsSpace, typename MatAcc, typename XAcc, typename YAcc>
+void local_spmv(const RowsSpace& rows, MatAcc& a, XAcc& x, YAcc& y) {
+    custom_parallel_for(rows,
+        [](size_t row, const auto& m, const auto& xv, auto& yv) {
+            auto view = m.get_view(row, GetCSRRowViewTag{});
+            typename XAcc::ValueType sum{};
+            for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+            }
+            yv.set_value_by_id(row, sum);
+        },
+        a, x, y);
+}
+
+} // namespace detail
+
+/// @brief y = A x for a distributed matrix
+///
+/// Posts the halo exchange of x, computes the interior rows while the
+/// messages are in flight, then waits and computes the boundary rows.
+/// With overlap = false the exchange completes before any row is computed
+/// (for comparison). Only the owned entries of y are written.
+template<typename S, typename C, typename T>
+void distributed_spmv(const DistributedCSRMatrix<S, C>& a, DistributedVector<T>& x, DistributedVector<T>& y,
+                      bool overlap = true) {
+    Accessor<CSRMatrixT<S, C>, AccessMode::Read> mat(a.local());
+    Accessor<DenseArray1D<T>, AccessMode::Read> x_in(x.values);
+    Accessor<DenseArray1D<T>, AccessMode::Write> y_out(y.values);
+    x.start_halo_exchange();
+    if (!overlap) {
+        x.finish_halo_exchange();
+        detail::local_spmv(IterateOver::Range1D(a.local_rows()), mat, x_in, y_out);
+        return;
+    }
+    detail::local_spmv(a.interior_rows(), mat, x_in, y_out);
+    x.finish_halo_exchange();
+    detail::local_spmv(a.boundary_rows(), mat, x_in, y_out);
+}
+
+/// @brief Global dot product of the owned entries (same value on every rank)
+template<typename T>
+double distributed_dot(const DistributedVector<T>& x, const DistributedVector<T>& y, Transport& transport) {
+    Accessor<DenseArray1D<T>, AccessMode::Read> xa(x.values), ya(y.values);
+    double sum = custom_parallel_reduce(IterateOver::Range1D(x.local_size()),
+        [](size_t i, const auto& a, const auto& b) { return double(a.get_value_by_id(i)) * b.get_value_by_id(i); },
+        0.0, std::plus<>{}, xa, ya);
+    transport.allreduce_sum(&sum, 1);
+    return sum;
+}
+
+} // namespace accessor
@@ -0,0 +1,67 @@
+#pragma once
+#include "transport.hpp"
+#include <climits>
+#include <cstddef>
+#include <mpi.h>
+#include <stdexcept>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Transport over an MPI communicator
+///
+/// MPI must be initialized before construction and finalized after the
+/// transport and everything using it are gone. All point-to-point messages
+/// use one tag, so MPI's ordering guarantee gives the posting-order matching
+/// Transport promises.
+class MpiTransport : public Transport {
+public:
+    explicit MpiTransport(MPI_Comm comm = MPI_COMM_WORLD, int tag = 7531) : comm_(comm), tag_(tag) {
+        MPI_Comm_rank(comm_, &rank_);
+        MPI_Comm_size(comm_, &size_);
+    }
+
+    int rank() const override { return rank_; }
+    int size() const override { return size_; }
+
+    void post_send(int dest, const void* data, size_t bytes) override {
+        requests_.emplace_back();
+        MPI_Isend(data, count(bytes), MPI_BYTE, dest, tag_, comm_, &requests_.back());
+    }
+
+    void post_recv(int src, void* data, size_t bytes) override {
+        requests_.emplace_back();
+        MPI_Irecv(data, count(bytes), MPI_BYTE, src, tag_, comm_, &requests_.back());
+    }
+
+    void wait_all() override {
+        MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+        requests_.clear();
+    }
+
+    void barrier() override { MPI_Barrier(comm_); }
+
+    void allgather(const void* send, void* recv, size_t bytes_per_rank) override {
+        MPI_Allgather(send, count(bytes_per_rank), MPI_BYTE, recv, count(bytes_per_rank), MPI_BYTE, comm_);
+    }
+
+    void allreduce_sum(double* values, size_t n) override {
+        MPI_Allreduce(MPI_IN_PLACE, values, count(n), MPI_DOUBLE, MPI_SUM, comm_);
+    }
+
+private:
+    static int count(size_t n) {
+        if (n > static_cast<size_t>(INT_MAX)) {
+            throw std::length_error("MpiTransport: message larger than INT_MAX elements");
+        }
+        return static_cast<int>(n);
+    }
+
+    MPI_Comm comm_;
+    int tag_;
+    int rank_ = 0;
+    int size_ = 1;
+    std::vector<MPI_Request> requests_;
+};
+
+} // namespace accessor
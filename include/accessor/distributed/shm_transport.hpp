@@ -0,0 +1,258 @@
+#pragma once
+#include "transport.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <functional>
+#include <new>
+#include <sched.h>
+#include <signal.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace accessor {
+
+/// @brief POSIX shared-memory segment connecting the processes of one node
+///
+/// Holds one single-producer/single-consumer byte ring per ordered pair of
+/// ranks plus a process-shared barrier. The segment is created with
+/// shm_open and unlinked right after mapping, so it disappears with the
+/// last process that maps it. Create it before fork(); every child uses it
+/// through a ShmTransport (see run_shm_processes).
+class ShmWorld {
+public:
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared-memory rings need lock-free 64-bit atomics");
+
+    /// @param size Number of processes
+    /// @param channel_capacity Bytes buffered per ordered pair of ranks;
+    ///        longer messages are streamed through the ring
+    explicit ShmWorld(int size, size_t channel_capacity = size_t{1} << 20)
+        : size_(size), capacity_(channel_capacity) {
+        if (size < 1 || channel_capacity == 0) {
+            throw std::invalid_argument("ShmWorld: need at least one rank and a nonzero channel capacity");
+        }
+        const size_t channels = static_cast<size_t>(size) * static_cast<size_t>(size);
+        bytes_ = sizeof(Header) + channels * sizeof(Channel) + channels * capacity_;
+        const std::string name = "/accessor_shm_" + std::to_string(::getpid()) + "_" +
+                                 std::to_string(reinterpret_cast<uintptr_t>(this));
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("ShmWorld: shm_open failed");
+        }
+        ::shm_unlink(name.c_str());
+        if (::ftruncate(fd, static_cast<off_t>(bytes_)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("ShmWorld: ftruncate failed");
+        }
+        void* base = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            throw std::runtime_error("ShmWorld: mmap failed");
+        }
+        base_ = static_cast<char*>(base);
+        new (base_) Header{};
+        for (size_t c = 0; c < channels; ++c) new (channel(c)) Channel{};
+    }
+
+    ~ShmWorld() { ::munmap(base_, bytes_); }
+    ShmWorld(const ShmWorld&) = delete;
+    ShmWorld& operator=(const ShmWorld&) = delete;
+
+    int size() const { return size_; }
+    size_t channel_capacity() const { return capacity_; }
+
+private:
+    friend class ShmTransport;
+
+    struct Header {
+        alignas(64) std::atomic<uint32_t> barrier_count{0};
+        alignas(64) std::atomic<uint32_t> barrier_generation{0};
+    };
+    struct Channel {
+        alignas(64) std::atomic<uint64_t> written{0};  ///< Bytes pushed by the sender
+        alignas(64) std::atomic<uint64_t> read{0};     ///< Bytes pulled by the receiver
+    };
+
+    Header& header() const { return *reinterpret_cast<Header*>(base_); }
+    Channel* channel(size_t c) const {
+        return reinterpret_cast<Channel*>(base_ + sizeof(Header)) + c;
+    }
+    Channel* channel(int src, int dst) const {
+        return channel(static_cast<size_t>(src) * static_cast<size_t>(size_) + static_cast<size_t>(dst));
+    }
+    char* ring(int src, int dst) const {
+        const size_t channels = static_cast<size_t>(size_) * static_cast<size_t>(size_);
+        const size_t c = static_cast<size_t>(src) * static_cast<size_t>(size_) + static_cast<size_t>(dst);
+        return base_ + sizeof(Header) + channels * sizeof(Channel) + c * capacity_;
+    }
+
+    int size_;
+    size_t capacity_;
+    size_t bytes_ = 0;
+    char* base_ = nullptr;
+};
+
+/// @brief Transport over a ShmWorld, for one rank
+///
+/// post_send pushes as much as fits into the ring right away; wait_all
+/// keeps pushing and pulling all pending operations until every one is
+/// complete, so exchanges larger than the ring cannot deadlock.
+class ShmTransport : public Transport {
+public:
+    ShmTransport(ShmWorld& world, int rank) : world_(world), rank_(rank) {}
+
+    int rank() const override { return rank_; }
+    int size() const override { return world_.size(); }
+
+    void post_send(int dest, const void* data, size_t bytes) override {
+        sends_.push_back(Pending{dest, static_cast<char*>(const_cast<void*>(data)), bytes});
+        progress();
+    }
+
+    void post_recv(int src, void* data, size_t bytes) override {
+        recvs_.push_back(Pending{src, static_cast<char*>(data), bytes});
+    }
+
+    void wait_all() override {
+        while (!sends_.empty() || !recvs_.empty()) {
+            if (!progress()) ::sched_yield();
+        }
+    }
+
+    void barrier() override {
+        auto& h = world_.header();
+        const uint32_t generation = h.barrier_generation.load(std::memory_order_acquire);
+        if (h.barrier_count.fetch_add(1, std::memory_order_acq_rel) + 1 == static_cast<uint32_t>(size())) {
+            h.barrier_count.store(0, std::memory_order_relaxed);
+            h.barrier_generation.fetch_add(1, std::memory_order_acq_rel);
+        } else {
+            while (h.barrier_generation.load(std::memory_order_acquire) == generation) ::sched_yield();
+        }
+    }
+
+private:
+    struct Pending {
+        int peer;
+        char* data;
+        size_t remaining;
+    };
+
+    /// @brief Advance the oldest pending operation of every channel
+    /// @return Whether any byte moved
+    bool progress() {
+        bool moved = false;
+        std::vector<int> blocked;
+        for (Pending& op : sends_) {
+            if (op.remaining == 0 || std::find(blocked.begin(), blocked.end(), op.peer) != blocked.end()) continue;
+            moved = push(op) || moved;
+            if (op.remaining > 0) blocked.push_back(op.peer);
+        }
+        blocked.clear();
+        for (Pending& op : recvs_) {
+            if (op.remaining == 0 || std::find(blocked.begin(), blocked.end(), op.peer) != blocked.end()) continue;
+            moved = pull(op) || moved;
+            if (op.remaining > 0) blocked.push_back(op.peer);
+        }
+        auto done = [](const Pending& op) { return op.remaining == 0; };
+        sends_.erase(std::remove_if(sends_.begin(), sends_.end(), done), sends_.end());
+        recvs_.erase(std::remove_if(recvs_.begin(), recvs_.end(), done), recvs_.end());
+        return moved;
+    }
+
+    bool push(Pending& op) {
+        auto* ch = world_.channel(rank_, op.peer);
+        char* ring = world_.ring(rank_, op.peer);
+        const size_t cap = world_.capacity_;
+        const uint64_t written = ch->written.load(std::memory_order_relaxed);
+        const uint64_t read = ch->read.load(std::memory_order_acquire);
+        const size_t n = std::min(op.remaining, cap - static_cast<size_t>(written - read));
+        if (n == 0) return false;
+        const size_t pos = static_cast<size_t>(written % cap);
+        const size_t first = std::min(n, cap - pos);
+        std::memcpy(ring + pos, op.data, first);
+        std::memcpy(ring, op.data + first, n - first);
+        ch->written.store(written + n, std::memory_order_release);
+        op.data += n;
+        op.remaining -= n;
+        return true;
+    }
+
+    bool pull(Pending& op) {
+        auto* ch = world_.channel(op.peer, rank_);
+        const char* ring = world_.ring(op.peer, rank_);
+        const size_t cap = world_.capacity_;
+        const uint64_t read = ch->read.load(std::memory_order_relaxed);
+        const uint64_t written = ch->written.load(std::memory_order_acquire);
+        const size_t n = std::min(op.remaining, static_cast<size_t>(written - read));
+        if (n == 0) return false;
+        const size_t pos = static_cast<size_t>(read % cap);
+        const size_t first = std::min(n, cap - pos);
+        std::memcpy(op.data, ring + pos, first);
+        std::memcpy(op.data + first, ring, n - first);
+        ch->read.store(read + n, std::memory_order_release);
+        op.data += n;
+        op.remaining -= n;
+        return true;
+    }
+
+    ShmWorld& world_;
+    int rank_;
+    std::vector<Pending> sends_;
+    std::vector<Pending> recvs_;
+};
+
+/// @brief Fork size processes that each run fn(transport) and wait for them
+///
+/// A child's exit status is fn's return value (1 if it throws); the child
+/// never returns from this function. If one child fails the others are
+/// killed. Fork before the calling process starts
+/// OpenMP threads: the children inherit only the forking thread.
+/// @return true if every child returned 0
+inline bool run_shm_processes(int size, const std::function<int(Transport&)>& fn,
+                              size_t channel_capacity = size_t{1} << 20) {
+    ShmWorld world(size, channel_capacity);
+    std::fflush(nullptr);
+    std::vector<pid_t> children;
+    for (int r = 0; r < size; ++r) {
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            throw std::runtime_error("run_shm_processes: fork failed");
+        }
+        if (pid == 0) {
+            int status = 1;
+            try {
+                ShmTransport transport(world, r);
+                status = fn(transport);
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "rank %d: %s\n", r, e.what());
+            }
+            std::fflush(nullptr);
+            ::_exit(status);
+        }
+        children.push_back(pid);
+    }
+    // A failed rank would leave its peers waiting forever: stop them
+    bool ok = true;
+    for (size_t remaining = children.size(); remaining > 0; --remaining) {
+        int status = 0;
+        const pid_t pid = ::waitpid(-1, &status, 0);
+        if (pid < 0) break;
+        children.erase(std::remove(children.begin(), children.end(), pid), children.end());
+        if (!(WIFEXITED(status) && WEXITSTATUS(status) == 0) && ok) {
+            ok = false;
+            for (pid_t other : children) ::kill(other, SIGKILL);
+        }
+    }
+    return ok;
+}
+
+} // namespace accessor
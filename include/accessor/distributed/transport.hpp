@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace accessor {
+
+/// @brief Message passing between the processes that share a distributed
+///        data structure
+///
+/// Point-to-point messages are posted without blocking and completed
+/// together by wait_all(); messages between the same pair of ranks are
+/// matched in posting order. Buffers must stay valid until wait_all()
+/// returns. Collectives must be called by every rank in the same order.
+/// Backends: MpiTransport (mpi_transport.hpp) and ShmTransport
+/// (shm_transport.hpp, processes of one node).
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    virtual int rank() const = 0;
+    virtual int size() const = 0;
+
+    virtual void post_send(int dest, const void* data, size_t bytes) = 0;
+    virtual void post_recv(int src, void* data, size_t bytes) = 0;
+
+    /// @brief Complete every posted send and receive
+    virtual void wait_all() = 0;
+
+    virtual void barrier() = 0;
+
+    /// @brief recv[r * bytes_per_rank ...] = send of rank r, on every rank
+    virtual void allgather(const void* send, void* recv, size_t bytes_per_rank) {
+        const int me = rank(), n = size();
+        char* out = static_cast<char*>(recv);
+        std::memcpy(out + static_cast<size_t>(me) * bytes_per_rank, send, bytes_per_rank);
+        for (int r = 0; r < n; ++r) {
+            if (r == me) continue;
+            post_recv(r, out + static_cast<size_t>(r) * bytes_per_rank, bytes_per_rank);
+            post_send(r, send, bytes_per_rank);
+        }
+        wait_all();
+    }
+
+    /// @brief Element-wise sum over all ranks, result on every rank
+    ///
+    /// The default implementation adds the contributions in rank order, so
+    /// every rank gets the same bits.
+    virtual void allreduce_sum(double* values, size_t count) {
+        std::vector<double> all(count * static_cast<size_t>(size()));
+        allgather(values, all.data(), count * sizeof(double));
+        for (size_t i = 0; i < count; ++i) {
+            double sum = 0;
+            for (int r = 0; r < size(); ++r) sum += all[static_cast<size_t>(r) * count + i];
+            values[i] = sum;
+        }
+    }
+};
+
+} // namespace accessor
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace IterateOver {
+
+/// @brief Consecutive rows [begin, end) of a CSR matrix
+struct CSRRowBlock {
+    size_t begin;
+    size_t end;
+
+    size_t num_rows() const { return end - begin; }
+};
+
+/// @brief League of row blocks for custom_team_parallel_for
+///
+/// Consecutive rows are packed into one block until it holds about
+/// target_nnz nonzeros, so a team gets a comparable amount of work per item:
+/// short rows are shared out among the team's members, while a row with
+/// target_nnz or more nonzeros forms a block of its own whose nonzeros the
+/// whole team splits. Works for any matrix with a row_ptr array.
+class CSRRowBlocks {
+public:
+    using ItemIDType = CSRRowBlock;
+    using DevicePodType = void; // 设备端暂不实现
+
+    template<typename MatrixT>
+    CSRRowBlocks(const MatrixT& mat, size_t target_nnz) {
+        const auto& row_ptr = mat.row_ptr;
+        const size_t rows = row_ptr.empty() ? 0 : row_ptr.size() - 1;
+        const size_t target = target_nnz ? target_nnz : 1;
+        size_t begin = 0;
+        for (size_t r = 0; r < rows; ++r) {
+            const size_t row_nnz = row_ptr[r + 1] - row_ptr[r];
+            // A long row closes the current block and takes one of its own
+            if (row_nnz >= target || row_ptr[r + 1] - row_ptr[begin] > target) {
+                if (r > begin) blocks_.push_back({begin, r});
+                begin = r;
+            }
+            if (row_nnz >= target) {
+                blocks_.push_back({r, r + 1});
+                begin = r + 1;
+            }
+        }
+        if (rows > begin) blocks_.push_back({begin, rows});
+    }
+
+    size_t size() const { return blocks_.size(); }
+    ItemIDType operator[](size_t global_idx) const { return blocks_[global_idx]; }
+
+    DevicePodType to_device_pod() const { return DevicePodType(); }
+private:
+    std::vector<CSRRowBlock> blocks_;
+};
+
+} // namespace IterateOver
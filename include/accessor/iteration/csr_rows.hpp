@@ -10,17 +10,18 @@ public:
     using ItemIDType = accessor::DataStructureTraits<CSRMatrix>::ItemIDType;
     using DevicePodType = void; // 设备端暂不实现
 
-    explicit CSRRows(const CSRMatrix& mat) : mat_(mat) {}
-    size_t size() const { return accessor::DataStructureTraits<CSRMatrix>::get_size_for_iteration(mat_, typename accessor::DataStructureTraits<CSRMatrix>::IterateOverRows_Tag{}); }
-    ItemIDType operator[](size_t global_idx) const { return accessor::DataStructureTraits<CSRMatrix>::get_item_id_from_global_index(mat_, global_idx, typename accessor::DataStructureTraits<CSRMatrix>::IterateOverRows_Tag{}); }
+    /// @brief Rows of a CSR matrix of any storage/compute precision, or of
+    ///        any other row-structured type whose traits define IterateOverRows_Tag
+    template<typename MatrixT>
+    explicit CSRRows(const MatrixT& mat)
+        : num_rows_(accessor::DataStructureTraits<MatrixT>::get_size_for_iteration(
+              mat, typename accessor::DataStructureTraits<MatrixT>::IterateOverRows_Tag{})) {}
+    size_t size() const { return num_rows_; }
+    ItemIDType operator[](size_t global_idx) const { return global_idx; }
     
-    DevicePodType to_device_pod() const {
-        if constexpr (!std::is_void_v<DevicePodType>) {
-            return {}; 
-        }
-    }
+    DevicePodType to_device_pod() const { return DevicePodType(); }
 private:
-    const CSRMatrix& mat_;
+    size_t num_rows_;
 };
 
-} // namespace IterateOver 
\ No newline at end of file
+} // namespace IterateOver 
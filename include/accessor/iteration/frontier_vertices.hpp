@@ -0,0 +1,83 @@
+#pragma once
+#include <accessor/core/frontier.hpp>
+#include <accessor/traits/frontier_traits.hpp>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace IterateOver {
+
+/// @brief Iteration space over the active vertices of a frontier
+///
+/// A sparse frontier is walked through its vertex list directly. A dense
+/// frontier is walked through a per-word rank index built once at
+/// construction, so operator[] selects the k-th set bit without a list.
+class FrontierVertices {
+public:
+    using ItemIDType = accessor::DataStructureTraits<accessor::DenseFrontier>::ItemIDType;
+    using DevicePodType = void; // 设备端暂不实现
+
+    explicit FrontierVertices(const accessor::SparseFrontier& f)
+        : list_(f.vertices.data()), count_(f.size()) {}
+
+    explicit FrontierVertices(const accessor::DenseFrontier& f)
+        : words_(f.words.data()) {
+        build_rank(f);
+    }
+
+    /// @brief Use whichever representation is materialized, preferring the list
+    explicit FrontierVertices(const accessor::Frontier& f) {
+        if (f.has_sparse()) {
+            list_ = f.sparse().vertices.data();
+            count_ = f.sparse().size();
+        } else {
+            words_ = f.dense().words.data();
+            build_rank(f.dense());
+        }
+    }
+
+    size_t size() const { return count_; }
+
+    ItemIDType operator[](size_t global_idx) const {
+        if (list_ != nullptr) {
+            return list_[global_idx];
+        }
+        const std::vector<size_t>& rank = *rank_;
+        // First word whose inclusive rank exceeds global_idx
+        size_t lo = 0, hi = rank.size() - 2;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (rank[mid + 1] <= global_idx) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        uint64_t bits = words_[lo];
+        for (size_t k = global_idx - rank[lo]; k > 0; --k) {
+            bits &= bits - 1;
+        }
+        return lo * accessor::DenseFrontier::bits_per_word + static_cast<size_t>(std::countr_zero(bits));
+    }
+
+    DevicePodType to_device_pod() const { return DevicePodType(); }
+
+private:
+    void build_rank(const accessor::DenseFrontier& f) {
+        auto rank = std::make_shared<std::vector<size_t>>(f.words.size() + 1, 0);
+        for (size_t w = 0; w < f.words.size(); ++w) {
+            (*rank)[w + 1] = (*rank)[w] + static_cast<size_t>(std::popcount(f.words[w]));
+        }
+        count_ = rank->back();
+        rank_ = std::move(rank);
+    }
+
+    const size_t* list_ = nullptr;
+    const uint64_t* words_ = nullptr;
+    std::shared_ptr<const std::vector<size_t>> rank_;
+    size_t count_ = 0;
+};
+
+} // namespace IterateOver
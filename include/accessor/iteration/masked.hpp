@@ -0,0 +1,62 @@
+#pragma once
+#include <accessor/core/parallel_compact.hpp>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace IterateOver {
+
+/// @brief Iteration space over an explicit list of item ids
+///
+/// The list is shared between copies, so passing the space by value into
+/// custom_parallel_for does not copy the ids.
+template<typename ItemID = size_t>
+class IndexList {
+public:
+    using ItemIDType = ItemID;
+    using DevicePodType = void; // 设备端暂不实现
+
+    IndexList() : ids_(std::make_shared<const std::vector<ItemIDType>>()) {}
+    explicit IndexList(std::vector<ItemIDType> ids)
+        : ids_(std::make_shared<const std::vector<ItemIDType>>(std::move(ids))) {}
+
+    size_t size() const { return ids_->size(); }
+    ItemIDType operator[](size_t global_idx) const { return (*ids_)[global_idx]; }
+
+    const std::vector<ItemIDType>& ids() const { return *ids_; }
+
+    DevicePodType to_device_pod() const { return DevicePodType(); }
+
+private:
+    std::shared_ptr<const std::vector<ItemIDType>> ids_;
+};
+
+/// @brief Items of a base iteration space that satisfy a predicate
+///
+/// The base space is compacted once at construction (predicate, prefix sum,
+/// scatter); the loop then runs over the dense list of selected ids, so
+/// threads split only the useful work instead of early-returning.
+/// The predicate is called as pred(id) or, when accessors are given, as
+/// pred(id, accessors...) like a custom_parallel_for kernel.
+template<typename BaseSpace>
+class Masked : public IndexList<std::decay_t<decltype(std::declval<const BaseSpace&>()[size_t{0}])>> {
+public:
+    using BaseType = IndexList<std::decay_t<decltype(std::declval<const BaseSpace&>()[size_t{0}])>>;
+    using typename BaseType::ItemIDType;
+
+    template<typename Predicate, typename... AccessorTypes>
+    Masked(const BaseSpace& base, Predicate&& pred, AccessorTypes&... accessors)
+        : BaseType(accessor::parallel_compact(base,
+              [&pred, &accessors...](const ItemIDType& id) { return pred(id, accessors...); })),
+          base_size_(base.size()) {}
+
+    /// @brief Size of the space before masking
+    size_t base_size() const { return base_size_; }
+
+private:
+    size_t base_size_;
+};
+
+} // namespace IterateOver
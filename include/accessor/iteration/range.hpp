@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+
+namespace IterateOver {
+
+/// @brief Iteration space over the ids [0, n)
+class Range1D {
+public:
+    using ItemIDType = size_t;
+    using DevicePodType = void; // 设备端暂不实现
+
+    explicit Range1D(size_t num_elements) : count_(num_elements) {}
+    size_t size() const { return count_; }
+    ItemIDType operator[](size_t global_idx) const { return global_idx; }
+
+    DevicePodType to_device_pod() const { return DevicePodType(); }
+private:
+    size_t count_;
+};
+
+/// @brief Iteration space over the ids [0, N) with the size fixed at compile time
+///
+/// custom_parallel_for runs spaces up to ACCESSOR_STATIC_UNROLL_LIMIT as one
+/// unrolled sequence on the calling thread, e.g. the components of a small
+/// vector inside a per-row kernel.
+template<size_t N>
+class StaticRange {
+public:
+    using ItemIDType = size_t;
+    using DevicePodType = void; // 设备端暂不实现
+
+    static constexpr size_t extent = N;
+
+    constexpr StaticRange() = default;
+    static constexpr size_t size() { return N; }
+    constexpr ItemIDType operator[](size_t global_idx) const { return global_idx; }
+
+    DevicePodType to_device_pod() const { return DevicePodType(); }
+};
+
+} // namespace IterateOver
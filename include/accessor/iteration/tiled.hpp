@@ -0,0 +1,247 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace IterateOver {
+
+/// @brief Order in which the tiles of a tiled space are visited
+enum class TileOrder {
+    RowMajor,   ///< Tile coordinates in row-major order
+    Morton,     ///< Z-order curve over tile coordinates
+    Wavefront   ///< Anti-diagonals (sum of tile coordinates), see Tiled::wavefront
+};
+
+/// @brief Box of a row-major N-D grid split into tiles
+///
+/// Yields linear indices into the full grid: tile by tile in the chosen
+/// order, row-major inside each tile. Tile layout is computed once and
+/// shared between copies. A global index is mapped to its tile with a
+/// binary search over the tile offsets (a small, cache-resident array).
+///
+/// With TileOrder::Wavefront the tiles of one anti-diagonal do not touch
+/// each other across a radius-1 star stencil when tiles are at least one
+/// point wide, so an in-place (Gauss-Seidel style) sweep can run
+/// wavefront(w).tiles() as one parallel loop over tiles, wavefronts in
+/// sequence. Each tile must then be swept serially by the thread that got
+/// it: the cells of a tile depend on each other, so a parallel loop over
+/// the cells of wavefront(w) itself would race.
+/// @tparam N Number of dimensions
+template<size_t N>
+class Tiled {
+public:
+    using ItemIDType = size_t;
+    using DevicePodType = void; // 设备端暂不实现
+    using Index = std::array<size_t, N>;
+
+    /// @brief Tiles covering the whole grid
+    Tiled(const Index& extents, const Index& tile, TileOrder order = TileOrder::RowMajor)
+        : Tiled(extents, Index{}, extents, tile, order) {}
+
+    /// @brief Tiles covering the box [lo, hi) of a grid with the given extents
+    Tiled(const Index& extents, const Index& lo, const Index& hi, const Index& tile,
+          TileOrder order = TileOrder::RowMajor)
+        : layout_(std::make_shared<const Layout>(build(extents, lo, hi, tile, order))),
+          first_tile_(0), last_tile_(layout_->tiles.size()) {}
+
+    size_t size() const { return layout_->tile_begin[last_tile_] - layout_->tile_begin[first_tile_]; }
+
+    ItemIDType operator[](size_t global_idx) const {
+        const Layout& l = *layout_;
+        const size_t g = global_idx + l.tile_begin[first_tile_];
+        const size_t t = static_cast<size_t>(
+            std::upper_bound(l.tile_begin.begin() + static_cast<std::ptrdiff_t>(first_tile_) + 1,
+                             l.tile_begin.begin() + static_cast<std::ptrdiff_t>(last_tile_) + 1, g) -
+            l.tile_begin.begin()) - 1;
+        const Tile& tile = l.tiles[t];
+        return tile_point(tile, g - l.tile_begin[t], l.strides);
+    }
+
+    size_t num_tiles() const { return last_tile_ - first_tile_; }
+
+    /// @brief Number of anti-diagonals (1 unless ordered by TileOrder::Wavefront)
+    size_t num_wavefronts() const { return layout_->wavefront_begin.size() - 1; }
+
+    /// @brief Sub-space holding the tiles of one anti-diagonal
+    Tiled wavefront(size_t w) const {
+        Tiled sub(*this);
+        sub.first_tile_ = layout_->wavefront_begin[w];
+        sub.last_tile_ = layout_->wavefront_begin[w + 1];
+        return sub;
+    }
+
+    class TileCells;
+    class Tiles;
+
+    /// @brief The same tiles as an iteration space with one tile per item
+    Tiles tiles() const { return Tiles(layout_, first_tile_, last_tile_); }
+
+    DevicePodType to_device_pod() const { return DevicePodType(); }
+
+private:
+    struct Tile {
+        Index origin;
+        Index shape;
+        Index coords;   ///< Tile coordinates
+        size_t first_id; ///< Linear id of the origin
+    };
+
+    struct Layout {
+        Index strides;
+        std::vector<Tile> tiles;
+        std::vector<size_t> tile_begin;        ///< Prefix sum of tile sizes (num_tiles + 1)
+        std::vector<size_t> wavefront_begin;   ///< First tile of each wavefront (+ end)
+    };
+
+    /// @brief Linear id of the local-th point (row-major) of a tile
+    static size_t tile_point(const Tile& tile, size_t local, const Index& strides) {
+        size_t id = tile.first_id;
+        if (local <= UINT32_MAX) {
+            // 32-bit division is several times cheaper
+            uint32_t rest = static_cast<uint32_t>(local);
+            for (size_t d = N; d-- > 1;) {
+                const uint32_t extent = static_cast<uint32_t>(tile.shape[d]);
+                const uint32_t q = rest / extent;
+                id += (rest - q * extent) * strides[d];
+                rest = q;
+            }
+            return id + rest * strides[0];
+        }
+        for (size_t d = N; d-- > 1;) {
+            id += (local % tile.shape[d]) * strides[d];
+            local /= tile.shape[d];
+        }
+        return id + local * strides[0];
+    }
+
+    /// @brief Interleave the bits of the tile coordinates
+    static uint64_t morton_key(const Index& c) {
+        uint64_t key = 0;
+        const size_t bits = 64 / N;
+        for (size_t b = 0; b < bits; ++b) {
+            for (size_t d = 0; d < N; ++d) {
+                key |= static_cast<uint64_t>((c[d] >> b) & 1u) << (b * N + (N - 1 - d));
+            }
+        }
+        return key;
+    }
+
+    static size_t diagonal(const Index& c) {
+        return std::accumulate(c.begin(), c.end(), size_t{0});
+    }
+
+    static Layout build(const Index& extents, const Index& lo, const Index& hi, const Index& tile, TileOrder order) {
+        Layout l;
+        size_t stride = 1;
+        for (size_t d = N; d-- > 0;) {
+            l.strides[d] = stride;
+            stride *= extents[d];
+        }
+
+        Index counts;
+        size_t total_tiles = 1;
+        for (size_t d = 0; d < N; ++d) {
+            const size_t len = hi[d] > lo[d] ? hi[d] - lo[d] : 0;
+            const size_t t = std::max<size_t>(tile[d], 1);
+            counts[d] = (len + t - 1) / t;
+            total_tiles *= counts[d];
+        }
+        l.tiles.resize(total_tiles);
+        for (size_t i = 0; i < total_tiles; ++i) {
+            Tile& tl = l.tiles[i];
+            size_t rest = i;
+            for (size_t d = N; d-- > 0;) {
+                const size_t t = std::max<size_t>(tile[d], 1);
+                tl.coords[d] = rest % counts[d];
+                rest /= counts[d];
+                tl.origin[d] = lo[d] + tl.coords[d] * t;
+                tl.shape[d] = std::min(t, hi[d] - tl.origin[d]);
+            }
+            tl.first_id = 0;
+            for (size_t d = 0; d < N; ++d) tl.first_id += tl.origin[d] * l.strides[d];
+        }
+
+        if (order == TileOrder::Morton) {
+            std::stable_sort(l.tiles.begin(), l.tiles.end(),
+                [](const Tile& a, const Tile& b) { return morton_key(a.coords) < morton_key(b.coords); });
+        } else if (order == TileOrder::Wavefront) {
+            std::stable_sort(l.tiles.begin(), l.tiles.end(),
+                [](const Tile& a, const Tile& b) { return diagonal(a.coords) < diagonal(b.coords); });
+        }
+
+        l.tile_begin.assign(total_tiles + 1, 0);
+        for (size_t i = 0; i < total_tiles; ++i) {
+            size_t points = 1;
+            for (size_t d = 0; d < N; ++d) points *= l.tiles[i].shape[d];
+            l.tile_begin[i + 1] = l.tile_begin[i] + points;
+        }
+
+        l.wavefront_begin.push_back(0);
+        if (order == TileOrder::Wavefront) {
+            for (size_t i = 1; i < total_tiles; ++i) {
+                if (diagonal(l.tiles[i].coords) != diagonal(l.tiles[i - 1].coords)) {
+                    l.wavefront_begin.push_back(i);
+                }
+            }
+        }
+        l.wavefront_begin.push_back(total_tiles);
+        return l;
+    }
+
+    std::shared_ptr<const Layout> layout_;
+    size_t first_tile_;
+    size_t last_tile_;
+};
+
+/// @brief Linear ids of the cells of one tile, row-major; valid while the
+///        Tiled space (or Tiles) it came from is alive
+template<size_t N>
+class Tiled<N>::TileCells {
+public:
+    size_t size() const { return layout_->tile_begin[tile_ + 1] - layout_->tile_begin[tile_]; }
+    size_t operator[](size_t local) const { return tile_point(layout_->tiles[tile_], local, layout_->strides); }
+    const Index& origin() const { return layout_->tiles[tile_].origin; }
+    const Index& shape() const { return layout_->tiles[tile_].shape; }
+
+private:
+    friend class Tiles;
+    TileCells(const Layout* layout, size_t tile) : layout_(layout), tile_(tile) {}
+
+    const Layout* layout_;
+    size_t tile_;
+};
+
+/// @brief Iteration space over the tiles of a Tiled space, in its tile order
+///
+/// Each item is a TileCells the kernel walks itself, so all cells of a tile
+/// run on one thread, in row-major order.
+template<size_t N>
+class Tiled<N>::Tiles {
+public:
+    using ItemIDType = TileCells;
+    using DevicePodType = void; // 设备端暂不实现
+
+    size_t size() const { return last_tile_ - first_tile_; }
+    ItemIDType operator[](size_t global_idx) const { return TileCells(layout_.get(), first_tile_ + global_idx); }
+
+    DevicePodType to_device_pod() const { return DevicePodType(); }
+
+private:
+    friend class Tiled;
+    Tiles(std::shared_ptr<const Layout> layout, size_t first_tile, size_t last_tile)
+        : layout_(std::move(layout)), first_tile_(first_tile), last_tile_(last_tile) {}
+
+    std::shared_ptr<const Layout> layout_;
+    size_t first_tile_;
+    size_t last_tile_;
+};
+
+using Tiled2D = Tiled<2>;
+using Tiled3D = Tiled<3>;
+
+} // namespace IterateOver
@@ -1,6 +1,7 @@
 #pragma once
 #include <accessor/traits/data_structure_traits.hpp>
 #include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/low_precision.hpp>
 #include <cstddef>
 #include <type_traits>
 #include <iostream>
@@ -8,12 +9,24 @@
 namespace accessor {
 
 // 行视图结构体
-struct CSRMatrixRowView {
-    const float* values_ptr;
+// values_ptr指向存储精度的数据；value()/load_values()按计算精度读取
+template <typename StorageT, typename ComputeT>
+struct CSRMatrixRowViewT {
+    const StorageT* values_ptr;
     const size_t* col_indices_ptr;
     size_t num_non_zeros;
+
+    /// @brief i-th nonzero of the row in compute precision
+    ACCESSOR_FORCE_INLINE ComputeT value(size_t i) const { return to_compute<ComputeT>(values_ptr[i]); }
+
+    /// @brief Convert count nonzeros starting at begin into dst
+    void load_values(ComputeT* ACCESSOR_RESTRICT dst, size_t begin, size_t count) const {
+        convert_n(values_ptr + begin, dst, count);
+    }
 };
 
+using CSRMatrixRowView = CSRMatrixRowViewT<float, float>;
+
 // View标签
 struct GetCSRRowViewTag {};
 
@@ -21,33 +34,36 @@ struct GetCSRRowViewTag {};
 // 你可以把ViewResultType定义在traits外部
 
 template <typename ViewTag, typename DS> struct ViewResultType;
-template <> struct ViewResultType<GetCSRRowViewTag, CSRMatrix> {
-    using type = CSRMatrixRowView;
+template <typename StorageT, typename ComputeT, typename Allocator>
+struct ViewResultType<GetCSRRowViewTag, CSRMatrixT<StorageT, ComputeT, Allocator>> {
+    using type = CSRMatrixRowViewT<StorageT, ComputeT>;
 };
 
 // Traits主特化
 
-template <>
-struct DataStructureTraits<CSRMatrix> {
+template <typename StorageT, typename ComputeT, typename Allocator>
+struct DataStructureTraits<CSRMatrixT<StorageT, ComputeT, Allocator>> {
+    using Matrix = CSRMatrixT<StorageT, ComputeT, Allocator>;
     using ItemIDType = size_t;
-    using ValueType = float;
-    using CSR_RowView = CSRMatrixRowView;
+    using StorageType = StorageT;
+    using ValueType = ComputeT;
+    using CSR_RowView = CSRMatrixRowViewT<StorageT, ComputeT>;
 
     template <typename ViewSpecifierTag>
     static constexpr bool supports_view = std::is_same_v<ViewSpecifierTag, GetCSRRowViewTag>;
 
     // 迭代支持
     struct IterateOverRows_Tag {};
-    static size_t get_size_for_iteration(const CSRMatrix& mat, IterateOverRows_Tag) {
+    static size_t get_size_for_iteration(const Matrix& mat, IterateOverRows_Tag) {
         return mat.num_rows();
     }
-    static ItemIDType get_item_id_from_global_index(const CSRMatrix& mat, size_t global_idx, IterateOverRows_Tag) {
+    static ItemIDType get_item_id_from_global_index(const Matrix& mat, size_t global_idx, IterateOverRows_Tag) {
         return global_idx;
     }
 
     // 行视图
     template <typename ViewSpecifierTag>
-    static CSR_RowView get_view_impl(const CSRMatrix& mat, ItemIDType row_idx, ViewSpecifierTag) {
+    ACCESSOR_FORCE_INLINE static CSR_RowView get_view_impl(const Matrix& mat, ItemIDType row_idx, ViewSpecifierTag) {
         static_assert(std::is_same_v<ViewSpecifierTag, GetCSRRowViewTag>, "Only GetCSRRowViewTag supported");
         size_t start = mat.row_ptr[row_idx];
         size_t end = mat.row_ptr[row_idx+1];
@@ -59,7 +75,7 @@ struct DataStructureTraits<CSRMatrix> {
     }
 
     // Implementation of copy_data_structure_impl for CSRMatrix (deep copy)
-    static void copy_data_structure_impl(CSRMatrix& dest, const CSRMatrix& src) {
+    static void copy_data_structure_impl(Matrix& dest, const Matrix& src) {
         if (&dest == &src) {
             return; // Handle self-assignment
         }
@@ -70,4 +86,4 @@ struct DataStructureTraits<CSRMatrix> {
     }
 }; 
 
-} // namespace accessor 
\ No newline at end of file
+} // namespace accessor 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <accessor/core/compiler_hints.hpp>
 #include <type_traits>
 #include <cstddef>
 #include <vector>
@@ -80,12 +81,15 @@ template <typename T>
 struct DataStructureTraits<std::vector<T>> {
     using ItemIDType = size_t;
     using ValueType = T;
-    static T get_value_by_id_impl(const std::vector<T>& vec, size_t id) {
+    ACCESSOR_FORCE_INLINE static T get_value_by_id_impl(const std::vector<T>& vec, size_t id) {
         return vec[id];
     }
-    static void set_value_by_id_impl(std::vector<T>& vec, size_t id, T val) {
+    ACCESSOR_FORCE_INLINE static void set_value_by_id_impl(std::vector<T>& vec, size_t id, T val) {
         vec[id] = val;
     }
+    ACCESSOR_FORCE_INLINE static T* contiguous_data(std::vector<T>& vec) requires (!std::is_same_v<T, bool>) {
+        return vec.data();
+    }
 
     // Implementation of copy_data_structure_impl for std::vector (uses std::vector's deep copy assignment)
     static void copy_data_structure_impl(std::vector<T>& dest, const std::vector<T>& src) {
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "data_structure_traits.hpp"
+#include "dense_array_traits.hpp"
+#include <accessor/core/low_precision.hpp>
+#include <accessor/core/static_extent.hpp>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace accessor {
+
+/// @brief Dense array of N elements stored inline (no heap allocation)
+///
+/// For small per-item data such as 3-vectors, 4x4 blocks or one row of a
+/// fixed-width SpMM. The extent is a compile-time constant, so loops over it
+/// (custom_parallel_for over StaticRange<N>, static_for<N>) unroll fully.
+/// @tparam T Storage type
+/// @tparam N Number of elements
+/// @tparam ComputeT Type accessors read and write
+template<typename T, size_t N, typename ComputeT = default_compute_type_t<T>>
+struct DenseArrayFixed {
+    std::array<T, N> data{};
+
+    static constexpr size_t extent = N;
+
+    constexpr T& operator[](size_t index) { return data[index]; }
+    constexpr const T& operator[](size_t index) const { return data[index]; }
+    static constexpr size_t size() { return N; }
+    static constexpr bool empty() { return N == 0; }
+};
+
+// DenseArrayFixed的特性：大小为编译期常量
+template<typename T, size_t N, typename ComputeT>
+struct DataStructureTraits<DenseArrayFixed<T, N, ComputeT>> {
+    using Array = DenseArrayFixed<T, N, ComputeT>;
+    using ItemIDType = size_t;
+    using StorageType = T;
+    using ValueType = ComputeT;
+
+    static constexpr size_t extent = N;
+
+    template<typename ViewSpecifierTag>
+    static constexpr bool supports_view = std::is_same_v<ViewSpecifierTag, GetDenseArrayBlockViewTag> ||
+                                          is_static_block_view_tag_v<ViewSpecifierTag>;
+
+    static constexpr size_t get_size_for_iteration(const Array&, IterateOverAll_Tag) { return N; }
+
+    static constexpr ItemIDType get_item_id_from_global_index(const Array&, size_t global_idx, IterateOverAll_Tag) {
+        return global_idx;
+    }
+
+    ACCESSOR_FORCE_INLINE static constexpr ValueType get_value_by_id_impl(const Array& arr, ItemIDType id) {
+        if constexpr (std::is_same_v<T, ComputeT>) {
+            return arr.data[id];
+        } else {
+            return to_compute<ComputeT>(arr.data[id]);
+        }
+    }
+
+    ACCESSOR_FORCE_INLINE static constexpr void set_value_by_id_impl(Array& arr, ItemIDType id, ValueType val) {
+        if constexpr (std::is_same_v<T, ComputeT>) {
+            arr.data[id] = val;
+        } else {
+            arr.data[id] = to_storage<T>(val);
+        }
+    }
+
+    ACCESSOR_FORCE_INLINE static constexpr T* contiguous_data(Array& arr) requires std::is_same_v<T, ComputeT> {
+        return arr.data.data();
+    }
+
+    ACCESSOR_FORCE_INLINE static DenseArrayBlockView<T, ComputeT> get_view_impl(const Array& arr, ItemIDType id, GetDenseArrayBlockViewTag tag) {
+        const size_t end = id + tag.size < N ? id + tag.size : N;
+        return DenseArrayBlockView<T, ComputeT>{arr.data.data() + id, end - id};
+    }
+
+    template<size_t M>
+    ACCESSOR_FORCE_INLINE static DenseArrayStaticBlockView<T, ComputeT, M> get_view_impl(
+            const Array& arr, ItemIDType id, GetDenseArrayStaticBlockViewTag<M>) {
+        static_assert(M <= N, "Static block view is larger than the array");
+        return DenseArrayStaticBlockView<T, ComputeT, M>{arr.data.data() + id};
+    }
+
+    static constexpr void copy_data_structure_impl(Array& dest, const Array& src) { dest.data = src.data; }
+};
+
+} // namespace accessor
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "data_structure_traits.hpp"
+#include <accessor/core/low_precision.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace accessor {
+
+/// @brief N-dimensional dense array, row-major (last index contiguous)
+///
+/// Items are linear indices, so any iteration space that yields linear
+/// ids (Range1D, IterateOver::Tiled2D/3D) can drive a loop over it.
+/// @tparam T Storage type
+/// @tparam N Number of dimensions
+/// @tparam ComputeT Type accessors read and write (see DenseArray1D)
+template<typename T, size_t N, typename ComputeT = default_compute_type_t<T>>
+struct DenseArrayND {
+    static_assert(N >= 1, "DenseArrayND needs at least one dimension");
+    static constexpr size_t rank = N;
+
+    std::array<size_t, N> extents{};
+    std::array<size_t, N> strides{};
+    std::vector<T> data;
+
+    DenseArrayND() = default;
+    explicit DenseArrayND(const std::array<size_t, N>& ext, const T& value = T{}) : extents(ext) {
+        size_t stride = 1;
+        for (size_t d = N; d-- > 0;) {
+            strides[d] = stride;
+            stride *= extents[d];
+        }
+        data.assign(stride, value);
+    }
+
+    size_t size() const { return data.size(); }
+    size_t extent(size_t d) const { return extents[d]; }
+
+    size_t linear_index(const std::array<size_t, N>& c) const {
+        size_t idx = 0;
+        for (size_t d = 0; d < N; ++d) idx += c[d] * strides[d];
+        return idx;
+    }
+
+    std::array<size_t, N> coords(size_t idx) const {
+        std::array<size_t, N> c;
+        if (data.size() <= UINT32_MAX) {
+            // 32-bit division is several times cheaper
+            uint32_t rest = static_cast<uint32_t>(idx);
+            for (size_t d = 0; d + 1 < N; ++d) {
+                uint32_t q = rest / static_cast<uint32_t>(strides[d]);
+                rest -= q * static_cast<uint32_t>(strides[d]);
+                c[d] = q;
+            }
+            c[N - 1] = rest;
+            return c;
+        }
+        for (size_t d = 0; d + 1 < N; ++d) {
+            c[d] = idx / strides[d];
+            idx -= c[d] * strides[d];
+        }
+        c[N - 1] = idx;
+        return c;
+    }
+
+    template<typename... Idx>
+    T& operator()(Idx... idx) {
+        static_assert(sizeof...(Idx) == N, "Wrong number of indices");
+        return data[linear_index({static_cast<size_t>(idx)...})];
+    }
+    template<typename... Idx>
+    const T& operator()(Idx... idx) const {
+        static_assert(sizeof...(Idx) == N, "Wrong number of indices");
+        return data[linear_index({static_cast<size_t>(idx)...})];
+    }
+
+    T& operator[](size_t idx) { return data[idx]; }
+    const T& operator[](size_t idx) const { return data[idx]; }
+};
+
+template<typename T> using DenseArray2D = DenseArrayND<T, 2>;
+template<typename T> using DenseArray3D = DenseArrayND<T, 3>;
+
+/// @brief Stencil shape: K neighbor offsets in N dimensions
+template<size_t N, size_t K>
+struct Stencil {
+    std::array<std::array<long long, N>, K> offsets;
+
+    /// @brief Largest |offset| in any dimension
+    size_t radius() const {
+        long long r = 0;
+        for (const auto& o : offsets) {
+            for (long long v : o) r = v < 0 ? (-v > r ? -v : r) : (v > r ? v : r);
+        }
+        return static_cast<size_t>(r);
+    }
+};
+
+/// @brief Star stencil of radius 1: center first, then -1/+1 along each dimension
+///        (5 points in 2D, 7 points in 3D)
+template<size_t N>
+Stencil<N, 2 * N + 1> star_stencil() {
+    Stencil<N, 2 * N + 1> s{};
+    for (size_t d = 0; d < N; ++d) {
+        s.offsets[1 + 2 * d][d] = -1;
+        s.offsets[2 + 2 * d][d] = 1;
+    }
+    return s;
+}
+
+/// @brief View tag: values of the stencil neighbors around an item
+/// @note The stencil is referenced, not copied; it must outlive the loop.
+template<size_t N, size_t K>
+struct GetStencilNeighborhoodTag {
+    const Stencil<N, K>* stencil;
+};
+
+/// @brief Neighbor values of one point; out-of-range neighbors read as zero
+template<typename ComputeT, size_t N, size_t K>
+struct StencilNeighborhoodView {
+    std::array<ComputeT, K> values;
+    uint64_t inside_mask;
+    const Stencil<N, K>* stencil;
+
+    static constexpr size_t size() { return K; }
+    ComputeT value(size_t k) const { return values[k]; }
+    const std::array<long long, N>& offset(size_t k) const { return stencil->offsets[k]; }
+    bool in_bounds(size_t k) const { return (inside_mask >> k) & 1u; }
+};
+
+template <typename ViewTag, typename DS> struct ViewResultType;
+template<typename T, size_t N, typename ComputeT, size_t K>
+struct ViewResultType<GetStencilNeighborhoodTag<N, K>, DenseArrayND<T, N, ComputeT>> {
+    using type = StencilNeighborhoodView<ComputeT, N, K>;
+};
+
+namespace detail {
+template<typename Tag, size_t N>
+struct is_stencil_tag_of_rank : std::false_type {};
+template<size_t N, size_t K>
+struct is_stencil_tag_of_rank<GetStencilNeighborhoodTag<N, K>, N> : std::true_type {};
+} // namespace detail
+
+/// @brief DataStructureTraits specialization for DenseArrayND
+template<typename T, size_t N, typename ComputeT>
+struct DataStructureTraits<DenseArrayND<T, N, ComputeT>> {
+    using Array = DenseArrayND<T, N, ComputeT>;
+    using ItemIDType = size_t;
+    using StorageType = T;
+    using ValueType = ComputeT;
+
+    template<typename ViewSpecifierTag>
+    static constexpr bool supports_view = detail::is_stencil_tag_of_rank<ViewSpecifierTag, N>::value;
+
+    static size_t get_size_for_iteration(const Array& arr, IterateOverAll_Tag) {
+        return arr.size();
+    }
+
+    static ItemIDType get_item_id_from_global_index(const Array&, size_t global_idx, IterateOverAll_Tag) {
+        return global_idx;
+    }
+
+    static ValueType get_value_by_id_impl(const Array& arr, ItemIDType id) {
+        return to_compute<ComputeT>(arr.data[id]);
+    }
+
+    static void set_value_by_id_impl(Array& arr, ItemIDType id, ValueType val) {
+        arr.data[id] = to_storage<T>(val);
+    }
+
+    /// @brief Stencil neighborhood; points at least one radius away from
+    ///        every face skip the per-neighbor bounds checks
+    template<size_t K>
+    static StencilNeighborhoodView<ComputeT, N, K> get_view_impl(const Array& arr, ItemIDType id,
+                                                                 GetStencilNeighborhoodTag<N, K> tag) {
+        static_assert(K <= 64, "Stencils are limited to 64 points");
+        StencilNeighborhoodView<ComputeT, N, K> view;
+        view.stencil = tag.stencil;
+        const auto c = arr.coords(id);
+        const long long r = static_cast<long long>(tag.stencil->radius());
+        bool interior = true;
+        for (size_t d = 0; d < N; ++d) {
+            long long x = static_cast<long long>(c[d]);
+            interior = interior && x >= r && x + r < static_cast<long long>(arr.extents[d]);
+        }
+        view.inside_mask = 0;
+        for (size_t k = 0; k < K; ++k) {
+            const auto& o = tag.stencil->offsets[k];
+            bool inside = interior;
+            if (!interior) {
+                inside = true;
+                for (size_t d = 0; d < N; ++d) {
+                    long long x = static_cast<long long>(c[d]) + o[d];
+                    inside = inside && x >= 0 && x < static_cast<long long>(arr.extents[d]);
+                }
+            }
+            if (inside) {
+                long long delta = 0;
+                for (size_t d = 0; d < N; ++d) delta += o[d] * static_cast<long long>(arr.strides[d]);
+                view.values[k] = to_compute<ComputeT>(arr.data[static_cast<size_t>(static_cast<long long>(id) + delta)]);
+                view.inside_mask |= uint64_t{1} << k;
+            } else {
+                view.values[k] = ComputeT{};
+            }
+        }
+        return view;
+    }
+
+    static void copy_data_structure_impl(Array& dest, const Array& src) {
+        if (&dest == &src) return;
+        dest.extents = src.extents;
+        dest.strides = src.strides;
+        dest.data = src.data;
+    }
+};
+
+} // namespace accessor
@@ -1,23 +1,47 @@
 #pragma once
 
 #include "data_structure_traits.hpp"
+#include <accessor/core/low_precision.hpp>
+#include <accessor/core/static_extent.hpp>
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <cstddef>
+#include <type_traits>
 
 namespace accessor {
 
 /// @brief Simple one-dimensional dense array data structure
 /// @tparam T The type of elements stored in the array
-template<typename T>
+/// @tparam ComputeT The type accessors read and write (defaults to T, or
+///         float for half/bfloat16 storage)
+/// @tparam Allocator Allocator of the elements (pmr::DenseArray1D uses
+///         std::pmr::polymorphic_allocator)
+template<typename T, typename ComputeT = default_compute_type_t<T>, typename Allocator = std::allocator<T>>
 struct DenseArray1D {
-    std::vector<T> data;
+    using allocator_type = Allocator;
+
+    std::vector<T, Allocator> data;
     size_t count;
 
     // Constructors
     DenseArray1D() : count(0) {}
     explicit DenseArray1D(size_t size) : data(size), count(size) {}
-    DenseArray1D(std::vector<T>&& vec) : data(std::move(vec)), count(data.size()) {}
-    DenseArray1D(const std::vector<T>& vec) : data(vec), count(vec.size()) {}
+    DenseArray1D(std::vector<T, Allocator>&& vec) : data(std::move(vec)), count(data.size()) {}
+    DenseArray1D(const std::vector<T, Allocator>& vec) : data(vec), count(vec.size()) {}
+
+    // Allocator-extended constructors
+    explicit DenseArray1D(const Allocator& alloc) : data(alloc), count(0) {}
+    DenseArray1D(size_t size, const Allocator& alloc) : data(size, alloc), count(size) {}
+    DenseArray1D(const DenseArray1D& other, const Allocator& alloc) : data(other.data, alloc), count(other.count) {}
+
+    DenseArray1D(const DenseArray1D&) = default;
+    DenseArray1D(DenseArray1D&&) = default;
+    DenseArray1D& operator=(const DenseArray1D&) = default;
+    DenseArray1D& operator=(DenseArray1D&&) = default;
+
+    allocator_type get_allocator() const { return data.get_allocator(); }
 
     // Access operators
     T& operator[](size_t index) { return data[index]; }
@@ -28,36 +52,113 @@ struct DenseArray1D {
     bool empty() const { return count == 0; }
 };
 
+/// @brief Contiguous block of a DenseArray1D
+///
+/// Reads convert from the storage type; load() converts the whole block at
+/// once so half/bfloat16 data is widened with vector instructions.
+template<typename T, typename ComputeT>
+struct DenseArrayBlockView {
+    const T* data_ptr;
+    size_t count;
+
+    ComputeT value(size_t i) const { return to_compute<ComputeT>(data_ptr[i]); }
+    void load(ComputeT* ACCESSOR_RESTRICT dst) const { convert_n(data_ptr, dst, count); }
+};
+
+/// @brief View tag: block of up to `size` elements starting at the given id
+struct GetDenseArrayBlockViewTag {
+    size_t size;
+};
+
+/// @brief Block of exactly M contiguous elements, M known at compile time
+///
+/// load() is unrolled; with M a multiple of the vector width the compiler
+/// emits straight-line vector loads.
+template<typename T, typename ComputeT, size_t M>
+struct DenseArrayStaticBlockView {
+    const T* data_ptr;
+
+    static constexpr size_t extent = M;
+    static constexpr size_t size() { return M; }
+
+    ComputeT value(size_t i) const { return to_compute<ComputeT>(data_ptr[i]); }
+    void load(ComputeT* ACCESSOR_RESTRICT dst) const {
+        static_for<M>([&](auto i) { dst[i] = to_compute<ComputeT>(data_ptr[i]); });
+    }
+};
+
+/// @brief View tag: block of M elements starting at the given id
+/// @note The block must lie inside the array (id + M <= size)
+template<size_t M>
+struct GetDenseArrayStaticBlockViewTag {};
+
+template<typename Tag>
+inline constexpr bool is_static_block_view_tag_v = false;
+template<size_t M>
+inline constexpr bool is_static_block_view_tag_v<GetDenseArrayStaticBlockViewTag<M>> = true;
+
 /// @brief DataStructureTraits specialization for DenseArray1D
 /// @tparam T The type of elements stored in the array
-template<typename T>
-struct DataStructureTraits<DenseArray1D<T>> {
+/// @tparam ComputeT The type values are converted to on access
+template<typename T, typename ComputeT, typename Allocator>
+struct DataStructureTraits<DenseArray1D<T, ComputeT, Allocator>> {
+    using Array = DenseArray1D<T, ComputeT, Allocator>;
     using ItemIDType = size_t;
-    using ValueType = T;
+    using StorageType = T;
+    using ValueType = ComputeT;
+
+    template<typename ViewSpecifierTag>
+    static constexpr bool supports_view = std::is_same_v<ViewSpecifierTag, GetDenseArrayBlockViewTag> ||
+                                          is_static_block_view_tag_v<ViewSpecifierTag>;
 
     // Required static member functions for iteration support
-    static size_t get_size_for_iteration(const DenseArray1D<T>& arr, IterateOverAll_Tag) {
+    static size_t get_size_for_iteration(const Array& arr, IterateOverAll_Tag) {
         return arr.count;
     }
 
     static ItemIDType get_item_id_from_global_index(
-        const DenseArray1D<T>& arr, 
+        const Array& arr, 
         size_t global_idx, 
         IterateOverAll_Tag) {
         return global_idx;
     }
 
     // Direct value access implementations
-    static ValueType get_value_by_id_impl(const DenseArray1D<T>& arr, ItemIDType id) {
-        return arr.data[id];
+    ACCESSOR_FORCE_INLINE static ValueType get_value_by_id_impl(const Array& arr, ItemIDType id) {
+        if constexpr (std::is_same_v<T, ComputeT>) {
+            return arr.data[id];
+        } else {
+            return to_compute<ComputeT>(arr.data[id]);
+        }
+    }
+
+    ACCESSOR_FORCE_INLINE static void set_value_by_id_impl(Array& arr, ItemIDType id, ValueType val) {
+        if constexpr (std::is_same_v<T, ComputeT>) {
+            arr.data[id] = val;
+        } else {
+            arr.data[id] = to_storage<T>(val);
+        }
     }
 
-    static void set_value_by_id_impl(DenseArray1D<T>& arr, ItemIDType id, ValueType val) {
-        arr.data[id] = val;
+    // Raw elements, only when no conversion happens on access
+    ACCESSOR_FORCE_INLINE static T* contiguous_data(Array& arr) requires std::is_same_v<T, ComputeT> {
+        return arr.data.data();
+    }
+
+    // Block view
+    ACCESSOR_FORCE_INLINE static DenseArrayBlockView<T, ComputeT> get_view_impl(const Array& arr, ItemIDType id, GetDenseArrayBlockViewTag tag) {
+        size_t end = std::min(arr.count, id + tag.size);
+        return DenseArrayBlockView<T, ComputeT>{arr.data.data() + id, end - id};
+    }
+
+    template<size_t M>
+    ACCESSOR_FORCE_INLINE static DenseArrayStaticBlockView<T, ComputeT, M> get_view_impl(
+            const Array& arr, ItemIDType id, GetDenseArrayStaticBlockViewTag<M>) {
+        return DenseArrayStaticBlockView<T, ComputeT, M>{arr.data.data() + id};
     }
 
     // Implementation of copy_data_structure_impl for DenseArray1D (deep copy)
-    static void copy_data_structure_impl(DenseArray1D<T>& dest, const DenseArray1D<T>& src) {
+    static void copy_data_structure_impl(Array& dest, const Array& src) {
         if (&dest == &src) return; // Handle self-assignment
 
         // Resize destination if needed
@@ -75,4 +176,12 @@ struct DataStructureTraits<DenseArray1D<T>> {
     }
 };
 
-} // namespace accessor 
\ No newline at end of file
+namespace pmr {
+
+/// @brief DenseArray1D whose elements come from a std::pmr::memory_resource
+template<typename T, typename ComputeT = default_compute_type_t<T>>
+using DenseArray1D = accessor::DenseArray1D<T, ComputeT, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace accessor 
@@ -0,0 +1,49 @@
+#pragma once
+#include <accessor/core/dynamic_csr.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/data_structure_traits.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace accessor {
+
+// 行视图与CSRMatrixT相同，现有的GetCSRRowViewTag内核无需修改
+template <typename StorageT, typename ComputeT, typename Allocator>
+struct ViewResultType<GetCSRRowViewTag, DynamicCSRMatrix<StorageT, ComputeT, Allocator>> {
+    using type = CSRMatrixRowViewT<StorageT, ComputeT>;
+};
+
+template <typename StorageT, typename ComputeT, typename Allocator>
+struct DataStructureTraits<DynamicCSRMatrix<StorageT, ComputeT, Allocator>> {
+    using Matrix = DynamicCSRMatrix<StorageT, ComputeT, Allocator>;
+    using ItemIDType = size_t;
+    using StorageType = StorageT;
+    using ValueType = ComputeT;
+    using CSR_RowView = CSRMatrixRowViewT<StorageT, ComputeT>;
+
+    template <typename ViewSpecifierTag>
+    static constexpr bool supports_view = std::is_same_v<ViewSpecifierTag, GetCSRRowViewTag>;
+
+    // 迭代支持
+    struct IterateOverRows_Tag {};
+    static size_t get_size_for_iteration(const Matrix& mat, IterateOverRows_Tag) {
+        return mat.num_rows();
+    }
+    static ItemIDType get_item_id_from_global_index(const Matrix&, size_t global_idx, IterateOverRows_Tag) {
+        return global_idx;
+    }
+
+    // 行视图：指向基矩阵或覆盖层中的当前行
+    template <typename ViewSpecifierTag>
+    static CSR_RowView get_view_impl(const Matrix& mat, ItemIDType row_idx, ViewSpecifierTag) {
+        static_assert(std::is_same_v<ViewSpecifierTag, GetCSRRowViewTag>, "Only GetCSRRowViewTag supported");
+        return mat.row_view(row_idx);
+    }
+
+    static void copy_data_structure_impl(Matrix& dest, const Matrix& src) {
+        if (&dest == &src) return;
+        dest = src;
+    }
+};
+
+} // namespace accessor
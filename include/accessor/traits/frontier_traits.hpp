@@ -0,0 +1,82 @@
+#pragma once
+
+#include "data_structure_traits.hpp"
+#include <accessor/core/frontier.hpp>
+#include <cstddef>
+
+namespace accessor {
+
+/// @brief DataStructureTraits specialization for SparseFrontier
+///
+/// Items are list positions; the value at a position is the vertex id.
+template<>
+struct DataStructureTraits<SparseFrontier> {
+    using ItemIDType = size_t;
+    using ValueType = size_t;
+
+    template<typename ViewSpecifierTag>
+    static constexpr bool supports_view = false;
+
+    static size_t get_size_for_iteration(const SparseFrontier& f, IterateOverAll_Tag) {
+        return f.size();
+    }
+
+    static ItemIDType get_item_id_from_global_index(const SparseFrontier&, size_t global_idx, IterateOverAll_Tag) {
+        return global_idx;
+    }
+
+    static ValueType get_value_by_id_impl(const SparseFrontier& f, ItemIDType id) {
+        return f.vertices[id];
+    }
+
+    static void set_value_by_id_impl(SparseFrontier& f, ItemIDType id, ValueType vertex) {
+        f.vertices[id] = vertex;
+    }
+
+    static void copy_data_structure_impl(SparseFrontier& dest, const SparseFrontier& src) {
+        if (&dest == &src) return;
+        dest.vertices = src.vertices;
+        dest.num_vertices = src.num_vertices;
+    }
+};
+
+/// @brief DataStructureTraits specialization for DenseFrontier
+///
+/// Items are vertex ids; the value is membership. Writes are atomic bit
+/// updates, so a Write accessor may be shared by all threads of a loop.
+template<>
+struct DataStructureTraits<DenseFrontier> {
+    using ItemIDType = size_t;
+    using ValueType = bool;
+
+    template<typename ViewSpecifierTag>
+    static constexpr bool supports_view = false;
+
+    static size_t get_size_for_iteration(const DenseFrontier& f, IterateOverAll_Tag) {
+        return f.num_vertices;
+    }
+
+    static ItemIDType get_item_id_from_global_index(const DenseFrontier&, size_t global_idx, IterateOverAll_Tag) {
+        return global_idx;
+    }
+
+    static ValueType get_value_by_id_impl(const DenseFrontier& f, ItemIDType v) {
+        return f.test(v);
+    }
+
+    static void set_value_by_id_impl(DenseFrontier& f, ItemIDType v, ValueType active) {
+        if (active) {
+            f.insert(v);
+        } else {
+            f.erase(v);
+        }
+    }
+
+    static void copy_data_structure_impl(DenseFrontier& dest, const DenseFrontier& src) {
+        if (&dest == &src) return;
+        dest.words = src.words;
+        dest.num_vertices = src.num_vertices;
+    }
+};
+
+} // namespace accessor
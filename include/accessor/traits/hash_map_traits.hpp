@@ -0,0 +1,64 @@
+#pragma once
+
+#include "data_structure_traits.hpp"
+#include <accessor/core/concurrent_hash_map.hpp>
+#include <accessor/core/reduce_policy.hpp>
+#include <cstddef>
+
+namespace accessor {
+
+/// @brief DataStructureTraits specialization for ConcurrentHashMap
+///
+/// Items are keys. Reading an absent key yields a value-initialized Value;
+/// writing inserts or overwrites. Reduce accessors combine into the entry
+/// with the strategy named by ReduceSemanticsPolicy, or the map's own
+/// reduce_strategy() when the policy leaves it Undefined.
+/// Iteration over all items walks the slot array (empty slots included);
+/// loops over entries should use IterateOver::IndexList(map.keys()).
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+struct DataStructureTraits<ConcurrentHashMap<Key, Value, Hash, KeyEqual>> {
+    using Map = ConcurrentHashMap<Key, Value, Hash, KeyEqual>;
+    using ItemIDType = Key;
+    using ValueType = Value;
+
+    template<typename ViewSpecifierTag>
+    static constexpr bool supports_view = false;
+
+    static size_t get_size_for_iteration(const Map& map, IterateOverAll_Tag) {
+        return map.capacity();
+    }
+
+    static ItemIDType get_item_id_from_global_index(const Map& map, size_t global_idx, IterateOverAll_Tag) {
+        return map.key_at(global_idx);
+    }
+
+    static ValueType get_value_by_id_impl(const Map& map, ItemIDType key) {
+        return map.value_or(key, Value{});
+    }
+
+    static void set_value_by_id_impl(Map& map, ItemIDType key, ValueType value) {
+        map.insert_or_assign(key, value);
+    }
+
+    template<typename ReduceOp>
+    static void apply_reduction_impl(Map& map, ItemIDType key, ValueType term, ReduceOp op, ReduceImplKind kind_hint) {
+        ReduceImplKind kind = kind_hint == ReduceImplKind::Undefined ? map.reduce_strategy() : kind_hint;
+        if (kind == ReduceImplKind::LocalBufferAndFinalReduce) {
+            map.reduce_local(key, term, op);
+        } else {
+            map.reduce(key, term, op);
+        }
+    }
+
+    /// @brief Merge per-thread partial tables (called by custom_parallel_for)
+    static void finalize_reduction_impl(Map& map) {
+        map.flush_partials();
+    }
+
+    static void copy_data_structure_impl(Map& dest, const Map& src) {
+        if (&dest == &src) return;
+        dest = src;
+    }
+};
+
+} // namespace accessor
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "data_structure_traits.hpp"
+#include <accessor/core/permutation.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace accessor {
+
+/// @brief Non-owning view of a data structure stored in the old numbering,
+///        addressed by ids in the new numbering
+///
+/// An Accessor over a PermutedView lets a kernel that iterates a reordered
+/// matrix read or write an original-order vector with new ids; the view
+/// maps each id through the permutation. Every access pays one extra load,
+/// so vectors touched many times should be permuted once with
+/// permute_vector instead.
+/// @note Writes go straight to the underlying structure; auto-buffering of
+///       custom_parallel_for copies only the view, not the data.
+template<typename DS_Type>
+struct PermutedView {
+    DS_Type* base;
+    const Permutation* perm;
+
+    PermutedView(DS_Type& ds, const Permutation& p) : base(&ds), perm(&p) {}
+
+    size_t size() const { return perm->size(); }
+};
+
+/// @brief Same as PermutedView, but for a structure stored in the new
+///        numbering that a kernel addresses with old ids
+template<typename DS_Type>
+struct InversePermutedView {
+    DS_Type* base;
+    const Permutation* perm;
+
+    InversePermutedView(DS_Type& ds, const Permutation& p) : base(&ds), perm(&p) {}
+
+    size_t size() const { return perm->size(); }
+};
+
+namespace detail {
+
+template<typename DS_Type, bool ToOld>
+struct PermutedTraitsBase {
+    using BaseTraits = DataStructureTraits<std::remove_const_t<DS_Type>>;
+    using ItemIDType = typename BaseTraits::ItemIDType;
+    using ValueType = typename BaseTraits::ValueType;
+
+    template<typename ViewSpecifierTag>
+    static constexpr bool supports_view = false;
+
+    template<typename View>
+    static ItemIDType map(const View& v, ItemIDType id) {
+        if constexpr (ToOld) {
+            return v.perm->new_to_old[id];
+        } else {
+            return v.perm->old_to_new[id];
+        }
+    }
+
+    template<typename View>
+    static size_t get_size_for_iteration(const View& v, IterateOverAll_Tag) {
+        return v.size();
+    }
+
+    template<typename View>
+    static ItemIDType get_item_id_from_global_index(const View&, size_t global_idx, IterateOverAll_Tag) {
+        return global_idx;
+    }
+
+    template<typename View>
+    static ValueType get_value_by_id_impl(const View& v, ItemIDType id) {
+        return BaseTraits::get_value_by_id_impl(*v.base, map(v, id));
+    }
+
+    template<typename View>
+    static void set_value_by_id_impl(View& v, ItemIDType id, ValueType val) {
+        BaseTraits::set_value_by_id_impl(*v.base, map(v, id), val);
+    }
+
+    template<typename View>
+    static void copy_data_structure_impl(View& dest, const View& src) {
+        dest = src;
+    }
+};
+
+} // namespace detail
+
+/// @brief DataStructureTraits specialization for PermutedView (new id -> old storage)
+template<typename DS_Type>
+struct DataStructureTraits<PermutedView<DS_Type>> : detail::PermutedTraitsBase<DS_Type, true> {};
+
+/// @brief DataStructureTraits specialization for InversePermutedView (old id -> new storage)
+template<typename DS_Type>
+struct DataStructureTraits<InversePermutedView<DS_Type>> : detail::PermutedTraitsBase<DS_Type, false> {};
+
+} // namespace accessor
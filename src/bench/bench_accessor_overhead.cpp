@@ -0,0 +1,123 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <omp.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace accessor;
+
+using Vec = DenseArray1D<float>;
+
+static CSRMatrix make_random(size_t n, size_t degree) {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> col(0, n - 1);
+    CSRMatrix a;
+    a.row_ptr.reserve(n + 1);
+    a.row_ptr.push_back(0);
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t k = 0; k < degree; ++k) {
+            a.col_indices.push_back(col(rng));
+            a.values.push_back(1.0f / static_cast<float>(k + 1));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+static void saxpy_accessor(float a, const Vec& x, Vec& y) {
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::ReadWrite> y_io(y);
+    custom_parallel_for(IterateOver::Range1D(x.count),
+        [a](size_t i, const auto& xv, auto& yv) {
+            yv.set_value_by_id(i, a * xv.get_value_by_id(i) + yv.get_value_by_id(i));
+        },
+        x_in, y_io);
+}
+
+static void saxpy_raw_data(float a, const Vec& x, Vec& y) {
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::ReadWrite> y_io(y);
+    custom_parallel_for(IterateOver::Range1D(x.count),
+        [a](size_t i, const auto& xv, auto& yv) { yv.raw_data()[i] = a * xv.raw_data()[i] + yv.raw_data()[i]; },
+        x_in, y_io);
+}
+
+static void saxpy_raw(float a, const float* x, float* y, size_t n) {
+    #pragma omp parallel for
+    for (long long i = 0; i < static_cast<long long>(n); ++i) y[i] = a * x[i] + y[i];
+}
+
+static void spmv_accessor(const CSRMatrix& m, const Vec& x, Vec& y) {
+    Accessor<CSRMatrix, AccessMode::Read> mat(m);
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_parallel_for(IterateOver::CSRRows(m),
+        [](size_t row, const auto& a, const auto& xv, auto& yv) {
+            auto view = a.get_view(row, GetCSRRowViewTag{});
+            float sum = 0;
+            for (size_t k = 0; k < view.num_non_zeros; ++k) sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+            yv.set_value_by_id(row, sum);
+        },
+        mat, x_in, y_out);
+}
+
+static void spmv_raw(const CSRMatrix& m, const float* x, float* y) {
+    const size_t* row_ptr = m.row_ptr.data();
+    const size_t* cols = m.col_indices.data();
+    const float* vals = m.values.data();
+    #pragma omp parallel for
+    for (long long row = 0; row < static_cast<long long>(m.num_rows()); ++row) {
+        float sum = 0;
+        for (size_t k = row_ptr[row]; k < row_ptr[row + 1]; ++k) sum += vals[k] * x[cols[k]];
+        y[row] = sum;
+    }
+}
+
+template<typename F>
+static double best_of(int reps, F&& f) {
+    double best = 1e30;
+    for (int rep = 0; rep < reps; ++rep) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return best;
+}
+
+static void report(const std::string& name, double t, double raw) {
+    std::cout << "  " << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(9) << t * 1e3 << " ms (" << std::setprecision(2) << t / raw << "x raw)"
+              << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 4000000;
+    std::cout << "threads " << omp_get_max_threads() << std::endl;
+
+    Vec x(std::vector<float>(n, 1.0f)), y(std::vector<float>(n, 2.0f));
+    std::cout << "SAXPY, " << n << " elements" << std::endl;
+    const double raw = best_of(10, [&] { saxpy_raw(0.5f, x.data.data(), y.data.data(), n); });
+    report("raw pointers", raw, raw);
+    report("accessor", best_of(10, [&] { saxpy_accessor(0.5f, x, y); }), raw);
+    report("raw_data()", best_of(10, [&] { saxpy_raw_data(0.5f, x, y); }), raw);
+
+    const size_t rows = n / 8;
+    const CSRMatrix a = make_random(rows, 16);
+    Vec xs(std::vector<float>(rows, 1.0f)), ys(rows);
+    std::cout << "SpMV, " << rows << " rows, " << a.num_nonzeros() << " nnz" << std::endl;
+    const double raw_spmv = best_of(10, [&] { spmv_raw(a, xs.data.data(), ys.data.data()); });
+    report("raw pointers", raw_spmv, raw_spmv);
+    report("accessor", best_of(10, [&] { spmv_accessor(a, xs, ys); }), raw_spmv);
+    return 0;
+}
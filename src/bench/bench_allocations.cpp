@@ -0,0 +1,155 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/custom_parallel_reduce.hpp>
+#include <accessor/core/custom_parallel_scan.hpp>
+#include <accessor/core/custom_team_parallel_for.hpp>
+#include <accessor/core/memory_resource.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <omp.h>
+#include <string>
+#include <vector>
+
+// 替换全局 operator new，统计每次调用的堆分配次数与字节数
+static std::atomic<size_t> g_heap_allocations{0};
+static std::atomic<size_t> g_heap_bytes{0};
+
+static void* counted_new(size_t bytes, size_t alignment) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_heap_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    void* p = alignment > alignof(std::max_align_t)
+                  ? std::aligned_alloc(alignment, (std::max<size_t>(bytes, 1) + alignment - 1) / alignment * alignment)
+                  : std::malloc(std::max<size_t>(bytes, 1));
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t bytes) { return counted_new(bytes, alignof(std::max_align_t)); }
+void* operator new[](size_t bytes) { return counted_new(bytes, alignof(std::max_align_t)); }
+void* operator new(size_t bytes, std::align_val_t al) { return counted_new(bytes, static_cast<size_t>(al)); }
+void* operator new[](size_t bytes, std::align_val_t al) { return counted_new(bytes, static_cast<size_t>(al)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+using namespace accessor;
+using IterateOver::Range1D;
+
+using Vec = DenseArray1D<float>;
+using PmrVec = pmr::DenseArray1D<float>;
+
+/// y[i] += y[n-1-i]: reading and writing y makes the loop buffer y
+template<typename V>
+static void mirror_add(const ExecutionContext& ctx, V& y) {
+    const size_t n = y.data.size();
+    Accessor<V, AccessMode::Read> in(y);
+    Accessor<V, AccessMode::Write> out(y);
+    custom_parallel_for(ctx, Range1D(n),
+        [n](size_t i, const auto& r, auto& w) { w.set_value_by_id(i, r.get_value_by_id(i) + r.get_value_by_id(n - 1 - i)); },
+        in, out);
+}
+
+static float reproducible_sum(const ExecutionContext& ctx, const Vec& x) {
+    Accessor<Vec, AccessMode::Read> in(x);
+    return custom_parallel_reduce(ctx, Range1D(x.count), reproducible_reduce(256),
+        [](size_t i, const auto& v) { return v.get_value_by_id(i); }, 0.0f, std::plus<>{}, in);
+}
+
+static float prefix_sum(const ExecutionContext& ctx, const Vec& x, Vec& y) {
+    Accessor<Vec, AccessMode::Read> in(x);
+    Accessor<Vec, AccessMode::Write> out(y);
+    return custom_parallel_scan(ctx, Range1D(x.count), ScanKind::Inclusive, 0.0f, std::plus<>{}, in, out);
+}
+
+static void team_row_sums(const ExecutionContext& ctx, const Vec& x, Vec& sums, size_t width) {
+    Accessor<Vec, AccessMode::Read> in(x);
+    Accessor<Vec, AccessMode::Write> out(sums);
+    TeamPolicy policy{0, width * sizeof(float), 0, {ScheduleKind::Dynamic, 4}};
+    custom_team_parallel_for(ctx, policy, Range1D(sums.count),
+        [width](TeamMember& team, size_t row, const auto& v, auto& s) {
+            float* staged = team.team_scratch<float>(width);
+            team.parallel_for(width, [&](size_t k) { staged[k] = v.get_value_by_id(row * width + k); });
+            team.team_barrier();
+            const float sum = team.parallel_reduce(width, [&](size_t k) { return staged[k]; }, 0.0f);
+            team.single([&] { s.set_value_by_id(row, sum); });
+            team.team_barrier();
+        },
+        in, out);
+}
+
+struct Measurement {
+    double seconds;
+    double allocations;
+    double bytes;
+};
+
+template<typename F>
+static Measurement measure(int reps, F&& f) {
+    f();   // 预热：区域在第一次调用时向系统申请内存块
+    double best = 1e30;
+    const size_t a0 = g_heap_allocations.load(), b0 = g_heap_bytes.load();
+    for (int rep = 0; rep < reps; ++rep) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return {best, static_cast<double>(g_heap_allocations.load() - a0) / reps,
+            static_cast<double>(g_heap_bytes.load() - b0) / reps};
+}
+
+static void report(const std::string& name, const Measurement& m) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(9) << m.seconds * 1e3 << " ms" << std::setprecision(1) << std::setw(10) << m.allocations
+              << " allocs/call" << std::setprecision(0) << std::setw(12) << m.bytes << " bytes/call"
+              << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 2000000;
+    const int reps = 10;
+    const ExecutionContext heap{std::pmr::new_delete_resource()};
+    const ExecutionContext arena{};   // 调用线程的区域
+    std::cout << "threads " << omp_get_max_threads() << ", n " << n << std::endl;
+
+    Vec y(std::vector<float>(n, 1.0f));
+    PmrVec py(n, std::pmr::new_delete_resource());
+    std::fill(py.data.begin(), py.data.end(), 1.0f);
+    Vec x(std::vector<float>(n, 0.5f)), out(n);
+    const size_t width = 256;
+    Vec sums(n / width);
+
+    std::cout << "buffered parallel_for (DenseArray1D):" << std::endl;
+    report("heap context", measure(reps, [&] { mirror_add(heap, y); }));
+    report("thread arena", measure(reps, [&] { mirror_add(arena, y); }));
+    std::cout << "buffered parallel_for (pmr::DenseArray1D):" << std::endl;
+    report("heap context", measure(reps, [&] { mirror_add(heap, py); }));
+    report("thread arena", measure(reps, [&] { mirror_add(arena, py); }));
+    std::cout << "reproducible reduce (block 256):" << std::endl;
+    float sink = 0;
+    report("heap context", measure(reps, [&] { sink += reproducible_sum(heap, x); }));
+    report("thread arena", measure(reps, [&] { sink += reproducible_sum(arena, x); }));
+    std::cout << "inclusive scan:" << std::endl;
+    report("heap context", measure(reps, [&] { sink += prefix_sum(heap, x, out); }));
+    report("thread arena", measure(reps, [&] { sink += prefix_sum(arena, x, out); }));
+    std::cout << "team loop with team scratch:" << std::endl;
+    report("heap context", measure(reps, [&] { team_row_sums(heap, x, sums, width); }));
+    report("thread arena", measure(reps, [&] { team_row_sums(arena, x, sums, width); }));
+
+    const ArenaResource& a = thread_arena();
+    std::cout << "thread arena: " << a.stats().system_allocations << " chunks, " << a.reserved_bytes()
+              << " bytes reserved (" << a.stats().allocations << " allocations served)" << std::endl;
+    return sink == -1.0f ? 1 : 0;
+}
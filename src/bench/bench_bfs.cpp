@@ -0,0 +1,95 @@
+#include <accessor/algorithms/bfs.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace accessor;
+
+// R-MAT generator (Graph500 parameters), symmetrized into a CSR adjacency
+static CSRMatrix make_rmat_graph(unsigned scale, size_t edge_factor, uint64_t seed) {
+    const size_t n = size_t{1} << scale;
+    const size_t m = n * edge_factor;
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    const double a = 0.57, b = 0.19, c = 0.19;
+
+    std::vector<std::pair<size_t, size_t>> edges;
+    edges.reserve(2 * m);
+    for (size_t e = 0; e < m; ++e) {
+        size_t u = 0, v = 0;
+        for (unsigned bit = 0; bit < scale; ++bit) {
+            double r = uni(rng);
+            size_t ub = (r > a + b) ? 1 : 0;
+            size_t vb = (r > a && r <= a + b) || r > a + b + c ? 1 : 0;
+            u |= ub << bit;
+            v |= vb << bit;
+        }
+        if (u == v) continue;
+        edges.emplace_back(u, v);
+        edges.emplace_back(v, u);
+    }
+
+    CSRMatrix g;
+    g.row_ptr.assign(n + 1, 0);
+    for (auto& [u, v] : edges) g.row_ptr[u + 1]++;
+    for (size_t i = 0; i < n; ++i) g.row_ptr[i + 1] += g.row_ptr[i];
+    g.col_indices.resize(edges.size());
+    std::vector<size_t> fill(g.row_ptr.begin(), g.row_ptr.end() - 1);
+    for (auto& [u, v] : edges) g.col_indices[fill[u]++] = v;
+    g.values.assign(edges.size(), 1.0f);
+    return g;
+}
+
+static double run_bfs(const CSRMatrix& g, size_t source, BFSDirection dir, BFSResult& out) {
+    BFSOptions opts;
+    opts.direction = dir;
+    auto t0 = std::chrono::steady_clock::now();
+    out = direction_optimizing_bfs(g, source, opts);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char** argv) {
+    unsigned scale = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 18;
+    size_t edge_factor = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 16;
+    int trials = argc > 3 ? std::atoi(argv[3]) : 4;
+
+    CSRMatrix g = make_rmat_graph(scale, edge_factor, 42);
+    std::cout << "R-MAT scale " << scale << ": " << g.num_rows() << " vertices, "
+              << g.num_nonzeros() << " directed edges, threads " << omp_get_max_threads() << std::endl;
+
+    const char* names[] = {"push-only", "pull-only", "direction-optimizing"};
+    const BFSDirection dirs[] = {BFSDirection::PushOnly, BFSDirection::PullOnly, BFSDirection::Auto};
+
+    for (int d = 0; d < 3; ++d) {
+        double total = 0.0;
+        size_t edges_traversed = 0;
+        size_t push = 0, pull = 0;
+        std::mt19937_64 pick(7);
+        for (int t = 0; t < trials; ++t) {
+            size_t source;
+            do {
+                source = pick() % g.num_rows();
+            } while (g.row_ptr[source + 1] == g.row_ptr[source]);
+
+            BFSResult res;
+            total += run_bfs(g, source, dirs[d], res);
+            for (size_t v = 0; v < g.num_rows(); ++v) {
+                if (res.depth[v] != BFSResult::unreached) {
+                    edges_traversed += g.row_ptr[v + 1] - g.row_ptr[v];
+                }
+            }
+            push += res.push_steps;
+            pull += res.pull_steps;
+        }
+        std::cout << names[d] << ": " << (total / trials) * 1e3 << " ms/search, "
+                  << (static_cast<double>(edges_traversed) / total) / 1e6 << " MTEPS"
+                  << " (push steps " << push << ", pull steps " << pull << ")" << std::endl;
+    }
+    return 0;
+}
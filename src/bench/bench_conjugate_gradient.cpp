@@ -0,0 +1,109 @@
+#include <accessor/algorithms/conjugate_gradient.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<double>;
+using Vec = DenseArray1D<double>;
+
+/// 5-point (2D) or 7-point (3D) Laplacian on an n^d grid, Dirichlet boundary
+static Matrix make_poisson(size_t n, size_t dims) {
+    const size_t rows = dims == 2 ? n * n : n * n * n;
+    const size_t strides[3] = {1, n, n * n};
+    Matrix a;
+    a.row_ptr.reserve(rows + 1);
+    a.col_indices.reserve(rows * (2 * dims + 1));
+    a.values.reserve(rows * (2 * dims + 1));
+    a.row_ptr.push_back(0);
+    for (size_t row = 0; row < rows; ++row) {
+        size_t c[3] = {row % n, (row / n) % n, row / (n * n)};
+        for (size_t d = dims; d-- > 0;) {
+            if (c[d] > 0) { a.col_indices.push_back(row - strides[d]); a.values.push_back(-1.0); }
+        }
+        a.col_indices.push_back(row);
+        a.values.push_back(2.0 * static_cast<double>(dims));
+        for (size_t d = 0; d < dims; ++d) {
+            if (c[d] + 1 < n) { a.col_indices.push_back(row + strides[d]); a.values.push_back(-1.0); }
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+/// Triad a = b + s c over arrays well beyond the last-level cache, in GB/s
+static double triad_bandwidth(size_t n) {
+    std::vector<double> a(n), b(n, 1.0), c(n, 2.0);
+    const long long len = static_cast<long long>(n);
+    double best = 1e30;
+    for (int t = 0; t < 5; ++t) {
+        auto t0 = std::chrono::steady_clock::now();
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < len; ++i) a[i] = b[i] + 3.0 * c[i];
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return 3.0 * static_cast<double>(n * sizeof(double)) / best / 1e9;
+}
+
+static void run(const std::string& name, const Matrix& a, double bandwidth, size_t iterations) {
+    const size_t n = a.num_rows();
+    Vec b(n);
+    for (size_t i = 0; i < n; ++i) b.data[i] = 1.0 + static_cast<double>(i % 11) * 0.1;
+    const double matrix_bytes = static_cast<double>(a.num_nonzeros() * (sizeof(double) + sizeof(size_t)) +
+                                                   (n + 1) * sizeof(size_t));
+    std::cout << name << ": " << n << " rows, " << a.num_nonzeros() << " nonzeros" << std::endl;
+
+    struct Variant { const char* name; CGVariant variant; double vector_passes; };
+    // Vector reads + writes per iteration (gathered vectors counted once)
+    const Variant variants[] = {{"standard", CGVariant::Standard, 12}, {"pipelined", CGVariant::Pipelined, 23}};
+    for (const Variant& v : variants) {
+        CGOptions opts;
+        opts.variant = v.variant;
+        opts.tolerance = 0;   // Fixed iteration count for timing
+        opts.max_iterations = iterations;
+        ConjugateGradient<double, double> solver(a, opts);
+        Vec x(n);
+        solver.solve(b, x);   // Warm-up
+        std::fill(x.data.begin(), x.data.end(), 0.0);
+        auto t0 = std::chrono::steady_clock::now();
+        CGResult res = solver.solve(b, x);
+        auto t1 = std::chrono::steady_clock::now();
+        const double per_iter = std::chrono::duration<double>(t1 - t0).count() / static_cast<double>(res.iterations);
+        const double bytes = matrix_bytes + v.vector_passes * static_cast<double>(n * sizeof(double));
+        const double bound = bytes / (bandwidth * 1e9);
+
+        opts.tolerance = 1e-6;
+        opts.max_iterations = 100000;
+        solver.options() = opts;
+        std::fill(x.data.begin(), x.data.end(), 0.0);
+        auto c0 = std::chrono::steady_clock::now();
+        CGResult conv = solver.solve(b, x);
+        auto c1 = std::chrono::steady_clock::now();
+
+        std::cout << "  " << std::left << std::setw(10) << v.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(9) << per_iter * 1e3 << " ms/iter" << std::setprecision(2) << std::setw(8)
+                  << bytes / per_iter / 1e9 << " GB/s" << std::setprecision(3) << "  bound " << bound * 1e3
+                  << " ms/iter (" << std::setprecision(0) << 100.0 * bound / per_iter << "% of bound)"
+                  << std::setprecision(3) << "  to 1e-6: " << conv.iterations << " iters, "
+                  << std::chrono::duration<double>(c1 - c0).count() << " s" << std::defaultfloat << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n2 = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1000;
+    size_t n3 = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 100;
+    size_t iterations = argc > 3 ? static_cast<size_t>(std::atoll(argv[3])) : 50;
+
+    const double bandwidth = triad_bandwidth(size_t{1} << 24);
+    std::cout << "threads " << omp_get_max_threads() << ", triad bandwidth " << std::setprecision(3) << bandwidth
+              << " GB/s" << std::endl;
+    run("Poisson 2D " + std::to_string(n2) + "^2", make_poisson(n2, 2), bandwidth, iterations);
+    run("Poisson 3D " + std::to_string(n3) + "^3", make_poisson(n3, 3), bandwidth, iterations);
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <accessor/core/coo_matrix.hpp>
+#include <accessor/core/csr_builder.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace accessor;
+
+// Q1 finite elements on an nx x ny quad mesh: 16 triplets per element, each
+// interior node pair is hit by up to 4 elements
+static COOMatrix make_fem_triplets(size_t nx, size_t ny) {
+    const size_t nodes_x = nx + 1;
+    COOMatrix coo;
+    coo.num_rows = coo.num_cols = nodes_x * (ny + 1);
+    coo.row_indices.reserve(16 * nx * ny);
+    coo.col_indices.reserve(16 * nx * ny);
+    coo.values.reserve(16 * nx * ny);
+    for (size_t ey = 0; ey < ny; ++ey) {
+        for (size_t ex = 0; ex < nx; ++ex) {
+            size_t nodes[4] = {ey * nodes_x + ex, ey * nodes_x + ex + 1,
+                               (ey + 1) * nodes_x + ex, (ey + 1) * nodes_x + ex + 1};
+            for (int a = 0; a < 4; ++a) {
+                for (int b = 0; b < 4; ++b) {
+                    coo.add(nodes[a], nodes[b], a == b ? 4.0f / 6.0f : -1.0f / 6.0f);
+                }
+            }
+        }
+    }
+    return coo;
+}
+
+// Serial reference: sort triplet permutation by (row, col), then merge
+static CSRMatrix serial_coo_to_csr(const COOMatrix& coo) {
+    std::vector<size_t> perm(coo.num_entries());
+    std::iota(perm.begin(), perm.end(), size_t{0});
+    std::sort(perm.begin(), perm.end(), [&](size_t a, size_t b) {
+        return coo.row_indices[a] != coo.row_indices[b] ? coo.row_indices[a] < coo.row_indices[b]
+                                                        : coo.col_indices[a] < coo.col_indices[b];
+    });
+    CSRMatrix mat;
+    mat.row_ptr.assign(coo.num_rows + 1, 0);
+    for (size_t i = 0; i < perm.size(); ++i) {
+        size_t k = perm[i];
+        if (i > 0 && coo.row_indices[k] == coo.row_indices[perm[i - 1]] && coo.col_indices[k] == coo.col_indices[perm[i - 1]]) {
+            mat.values.back() += coo.values[k];
+        } else {
+            mat.values.push_back(coo.values[k]);
+            mat.col_indices.push_back(coo.col_indices[k]);
+            mat.row_ptr[coo.row_indices[k] + 1]++;
+        }
+    }
+    for (size_t r = 0; r < coo.num_rows; ++r) mat.row_ptr[r + 1] += mat.row_ptr[r];
+    return mat;
+}
+
+template<typename F>
+static double time_it(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char** argv) {
+    size_t nx = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1000;
+    int trials = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    COOMatrix coo = make_fem_triplets(nx, nx);
+    const double triplets = static_cast<double>(coo.num_entries());
+    std::cout << "Q1 mesh " << nx << "x" << nx << ": " << coo.num_entries() << " triplets, "
+              << coo.num_rows << " rows, threads " << omp_get_max_threads() << std::endl;
+
+    CSRMatrix ref;
+    double t_serial = time_it([&] { ref = serial_coo_to_csr(coo); });
+    std::cout << "serial sort+merge:      " << t_serial * 1e3 << " ms, "
+              << triplets / t_serial / 1e6 << " M triplets/s" << std::endl;
+
+    CSRAssemblyPattern pattern;
+    CSRMatrix mat;
+    double t_full = 1e30, t_reuse = 1e30;
+    for (int t = 0; t < trials; ++t) {
+        t_full = std::min(t_full, time_it([&] { mat = coo_to_csr(coo, pattern); }));
+    }
+    for (int t = 0; t < trials; ++t) {
+        t_reuse = std::min(t_reuse, time_it([&] { assemble_csr_values(coo, pattern, mat); }));
+    }
+    std::cout << "parallel build:         " << t_full * 1e3 << " ms, "
+              << triplets / t_full / 1e6 << " M triplets/s" << std::endl;
+    std::cout << "pattern reuse (values): " << t_reuse * 1e3 << " ms, "
+              << triplets / t_reuse / 1e6 << " M triplets/s" << std::endl;
+
+    if (mat.row_ptr != ref.row_ptr || mat.col_indices != ref.col_indices || mat.num_nonzeros() != ref.num_nonzeros()) {
+        std::cerr << "structure mismatch against serial reference" << std::endl;
+        return 1;
+    }
+    std::cout << "nnz " << mat.num_nonzeros() << " (structure matches serial reference)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <accessor/distributed/distributed_csr.hpp>
+#ifdef ACCESSOR_WITH_MPI
+#include <accessor/distributed/mpi_transport.hpp>
+#else
+#include <accessor/distributed/shm_transport.hpp>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<double>;
+
+/// 7-point Laplacian on an n^3 grid, Dirichlet boundary
+static Matrix make_poisson_3d(size_t n) {
+    const size_t rows = n * n * n;
+    const size_t strides[3] = {1, n, n * n};
+    Matrix a;
+    a.row_ptr.reserve(rows + 1);
+    a.col_indices.reserve(rows * 7);
+    a.values.reserve(rows * 7);
+    a.row_ptr.push_back(0);
+    for (size_t row = 0; row < rows; ++row) {
+        size_t c[3] = {row % n, (row / n) % n, row / (n * n)};
+        for (size_t d = 3; d-- > 0;) {
+            if (c[d] > 0) { a.col_indices.push_back(row - strides[d]); a.values.push_back(-1.0); }
+        }
+        a.col_indices.push_back(row);
+        a.values.push_back(6.0);
+        for (size_t d = 0; d < 3; ++d) {
+            if (c[d] + 1 < n) { a.col_indices.push_back(row + strides[d]); a.values.push_back(-1.0); }
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+/// Slowest rank's best time per SpMV, in seconds
+static double time_spmv(Transport& t, const DistributedCSRMatrix<double, double>& a, DistributedVector<double>& x,
+                        DistributedVector<double>& y, bool overlap, int repeats) {
+    distributed_spmv(a, x, y, overlap);   // Warm-up
+    double best = 1e30;
+    for (int rep = 0; rep < 5; ++rep) {
+        t.barrier();
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; ++i) distributed_spmv(a, x, y, overlap);
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count() / repeats);
+    }
+    std::vector<double> all(static_cast<size_t>(t.size()));
+    t.allgather(&best, all.data(), sizeof(double));
+    return *std::max_element(all.begin(), all.end());
+}
+
+static int run(Transport& t, const Matrix& global, int repeats) {
+    const RowPartition part = RowPartition::uniform(global.num_rows(), t.size());
+    auto setup0 = std::chrono::steady_clock::now();
+    auto a = DistributedCSRMatrix<double, double>::from_global(t, part, global);
+    auto setup1 = std::chrono::steady_clock::now();
+    DistributedVector<double> x(a), y(a);
+    for (size_t i = 0; i < x.local_size(); ++i) x[i] = 1.0 + static_cast<double>(a.global_row(i) % 7);
+
+    const double plain = time_spmv(t, a, x, y, false, repeats);
+    const double overlapped = time_spmv(t, a, x, y, true, repeats);
+    double halo[2] = {static_cast<double>(a.num_ghosts()), static_cast<double>(a.boundary_rows().size())};
+    t.allreduce_sum(halo, 2);
+    if (t.rank() == 0) {
+        const double gflops = 2.0 * static_cast<double>(global.num_nonzeros()) / 1e9;
+        std::cout << "  " << std::setw(2) << t.size() << " ranks: setup " << std::fixed << std::setprecision(3)
+                  << std::chrono::duration<double>(setup1 - setup0).count() * 1e3 << " ms, ghosts "
+                  << std::setprecision(0) << halo[0] << ", boundary rows " << halo[1] << std::setprecision(3)
+                  << " | blocking " << plain * 1e3 << " ms (" << std::setprecision(2) << gflops / plain
+                  << " GFLOP/s)" << std::setprecision(3) << " | overlapped " << overlapped * 1e3 << " ms ("
+                  << std::setprecision(2) << gflops / overlapped << " GFLOP/s)" << std::defaultfloat << std::endl;
+    }
+    return 0;
+}
+
+#ifdef ACCESSOR_WITH_MPI
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    {
+        size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100;
+        int repeats = argc > 2 ? std::atoi(argv[2]) : 20;
+        MpiTransport t;
+        Matrix global = make_poisson_3d(n);
+        if (t.rank() == 0) std::cout << "Poisson 3D " << n << "^3 over MPI" << std::endl;
+        run(t, global, repeats);
+    }
+    MPI_Finalize();
+    return 0;
+}
+
+#else
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 20;
+    int max_ranks = argc > 3 ? std::atoi(argv[3]) : 4;
+
+    // Built once before fork; the ranks share the pages copy-on-write
+    Matrix global = make_poisson_3d(n);
+    std::cout << "Poisson 3D " << n << "^3 (" << global.num_nonzeros()
+              << " nonzeros) over shared-memory processes" << std::endl;
+    for (int p = 1; p <= max_ranks; p *= 2) {
+        // Ranks split the cores between them
+        const bool ok = run_shm_processes(p, [&](Transport& t) {
+            omp_set_num_threads(std::max(1, omp_get_num_procs() / t.size()));
+            return run(t, global, repeats);
+        });
+        if (!ok) return 1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/dynamic_csr.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <accessor/traits/dynamic_csr_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <omp.h>
+#include <random>
+#include <vector>
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<float>;
+using Dynamic = DynamicCSRMatrix<float>;
+using Vec = DenseArray1D<float>;
+
+// Random graph with sorted unique neighbours
+static Matrix make_graph(size_t n, size_t degree) {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> col(0, n - 1);
+    Matrix a;
+    a.row_ptr.reserve(n + 1);
+    a.row_ptr.push_back(0);
+    std::vector<size_t> cols;
+    for (size_t r = 0; r < n; ++r) {
+        cols.clear();
+        for (size_t k = 0; k < degree; ++k) cols.push_back(col(rng));
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        for (size_t c : cols) {
+            a.col_indices.push_back(c);
+            a.values.push_back(1.0f);
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+// 80% inserts, 20% deletes of random edges, rows drawn from [0, row_range)
+static std::vector<CSRUpdate<float>> make_batch(size_t n, size_t row_range, size_t size, std::mt19937& rng) {
+    std::uniform_int_distribution<size_t> row(0, row_range - 1), col(0, n - 1);
+    std::uniform_int_distribution<int> kind(0, 9);
+    std::vector<CSRUpdate<float>> batch(size);
+    for (auto& u : batch) {
+        u = {row(rng), col(rng), 0.5f, kind(rng) < 8 ? CSRUpdateKind::Insert : CSRUpdateKind::Erase};
+    }
+    return batch;
+}
+
+template<typename MatrixT>
+static double time_spmv(MatrixT& m, Vec& x, Vec& y) {
+    Accessor<MatrixT, AccessMode::Read> mat(m);
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    double best = 1e30;
+    for (int rep = 0; rep < 5; ++rep) {
+        auto t0 = std::chrono::steady_clock::now();
+        custom_parallel_for(IterateOver::CSRRows(m),
+            [](size_t row, const auto& a, const auto& xv, auto& yv) {
+                auto view = a.get_view(row, GetCSRRowViewTag{});
+                float sum = 0;
+                for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                    sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+                }
+                yv.set_value_by_id(row, sum);
+            },
+            mat, x_in, y_out);
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1000000;
+    size_t degree = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 16;
+    const Matrix graph = make_graph(n, degree);
+    std::cout << "threads " << omp_get_max_threads() << ", " << n << " rows, " << graph.num_nonzeros()
+              << " nonzeros" << std::endl;
+    std::mt19937 rng(2);
+
+    // Update throughput, no compaction
+    std::cout << "update throughput (overlay only):" << std::endl;
+    for (size_t batch_size : {size_t{10000}, size_t{100000}, size_t{1000000}}) {
+        DynamicCSROptions opts;
+        opts.compaction_threshold = 0;
+        Dynamic m(graph, opts);
+        auto batch = make_batch(n, n, batch_size, rng);
+        m.apply_updates(batch);   // Warm-up
+        batch = make_batch(n, n, batch_size, rng);
+        auto t0 = std::chrono::steady_clock::now();
+        m.apply_updates(batch);
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "  batch " << std::setw(8) << batch_size << ": " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(batch_size) / s / 1e6 << " M updates/s" << std::defaultfloat << std::endl;
+    }
+
+    // Sustained stream with periodic compaction
+    for (bool background : {false, true}) {
+        DynamicCSROptions opts;
+        opts.background_compaction = background;
+        Dynamic m(graph, opts);
+        const size_t batch_size = 200000, batches = 30;
+        std::vector<std::vector<CSRUpdate<float>>> stream;
+        for (size_t b = 0; b < batches; ++b) stream.push_back(make_batch(n, n, batch_size, rng));
+        auto t0 = std::chrono::steady_clock::now();
+        for (const auto& batch : stream) m.apply_updates(batch);
+        m.wait_for_compaction();
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "stream of " << batches << " x " << batch_size << " with " << (background ? "background" : "inline")
+                  << " compaction: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(batch_size * batches) / s / 1e6 << " M updates/s, " << m.compactions()
+                  << " compactions" << std::defaultfloat << std::endl;
+    }
+
+    // Query slowdown by overlay size
+    Vec x(std::vector<float>(n, 1.0f)), y(n);
+    Matrix plain = graph;
+    const double base_time = time_spmv(plain, x, y);
+    std::cout << "SpMV, static CSR: " << std::fixed << std::setprecision(3) << base_time * 1e3 << " ms"
+              << std::defaultfloat << std::endl;
+    for (double fraction : {0.0, 0.01, 0.1, 0.5, 1.0}) {
+        DynamicCSROptions opts;
+        opts.compaction_threshold = 0;
+        Dynamic m(graph, opts);
+        // One update per touched row, spread over the whole matrix
+        const size_t touched = static_cast<size_t>(fraction * static_cast<double>(n));
+        if (touched > 0) {
+            std::vector<size_t> rows(n);
+            for (size_t i = 0; i < n; ++i) rows[i] = i;
+            std::shuffle(rows.begin(), rows.end(), rng);
+            std::vector<CSRUpdate<float>> batch(touched);
+            for (size_t i = 0; i < touched; ++i) batch[i] = {rows[i], rows[i], 1.0f, CSRUpdateKind::Insert};
+            m.apply_updates(batch);
+        }
+        const double t = time_spmv(m, x, y);
+        m.compact();
+        const double compacted = time_spmv(m, x, y);
+        std::cout << "  " << std::setw(5) << std::fixed << std::setprecision(0) << fraction * 100 << "% rows in overlay: "
+                  << std::setprecision(3) << t * 1e3 << " ms (" << std::setprecision(2) << t / base_time
+                  << "x static), after compaction " << std::setprecision(3) << compacted * 1e3 << " ms"
+                  << std::defaultfloat << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/concurrent_hash_map.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <accessor/traits/hash_map_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace accessor;
+
+using SumMap = ConcurrentHashMap<uint64_t, double>;
+
+// Keys drawn from Zipf(s) over [0, num_keys), scrambled so hot keys are not adjacent
+static std::vector<uint64_t> zipf_keys(size_t n, size_t num_keys, double s, unsigned seed) {
+    std::vector<double> cdf(num_keys);
+    double total = 0.0;
+    for (size_t k = 0; k < num_keys; ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), s);
+        cdf[k] = total;
+    }
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> u(0.0, total);
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t rank = static_cast<size_t>(std::lower_bound(cdf.begin(), cdf.end(), u(rng)) - cdf.begin());
+        keys[i] = static_cast<uint64_t>(std::min(rank, num_keys - 1)) * 0x9e3779b97f4a7c15ULL;
+    }
+    return keys;
+}
+
+static double aggregate(DenseArray1D<uint64_t>& keys, DenseArray1D<double>& values, SumMap& map, ReduceImplKind kind) {
+    map.clear();
+    map.set_reduce_strategy(kind);
+    Accessor<DenseArray1D<uint64_t>, AccessMode::Read> k_acc(keys);
+    Accessor<DenseArray1D<double>, AccessMode::Read> v_acc(values);
+    Accessor<SumMap, AccessMode::Reduce> m_acc(map);
+    auto t0 = std::chrono::steady_clock::now();
+    custom_parallel_for(IterateOver::Range1D(keys.size()),
+        [](size_t i, const Accessor<DenseArray1D<uint64_t>, AccessMode::Read>& k,
+           const Accessor<DenseArray1D<double>, AccessMode::Read>& v, Accessor<SumMap, AccessMode::Reduce>& m) {
+            m.reduce_value_by_id(k.get_value_by_id(i), v.get_value_by_id(i));
+        },
+        k_acc, v_acc, m_acc);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 10000000;
+    size_t num_keys = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 1000000;
+    int reps = argc > 3 ? std::atoi(argv[3]) : 3;
+
+    std::cout << n << " records, " << num_keys << " possible keys, threads " << omp_get_max_threads() << std::endl;
+    std::cout << std::setw(6) << "zipf s" << std::setw(10) << "groups" << std::setw(16) << "unordered_map"
+              << std::setw(16) << "CAS" << std::setw(16) << "per-thread" << "   (M records/s)" << std::endl;
+
+    for (double s : {0.0, 0.8, 1.0, 1.2, 1.5}) {
+        DenseArray1D<uint64_t> keys(zipf_keys(n, num_keys, s, 17));
+        DenseArray1D<double> values(n);
+        for (size_t i = 0; i < n; ++i) values[i] = static_cast<double>(i % 100) * 0.25;
+
+        // Serial baseline
+        auto t0 = std::chrono::steady_clock::now();
+        std::unordered_map<uint64_t, double> reference;
+        for (size_t i = 0; i < n; ++i) reference[keys[i]] += values[i];
+        auto t1 = std::chrono::steady_clock::now();
+        double serial = std::chrono::duration<double>(t1 - t0).count();
+
+        SumMap map(reference.size());
+        double best[2] = {1e30, 1e30};
+        const ReduceImplKind kinds[2] = {ReduceImplKind::DeviceAtomic, ReduceImplKind::LocalBufferAndFinalReduce};
+        for (int k = 0; k < 2; ++k) {
+            for (int r = 0; r < reps; ++r) best[k] = std::min(best[k], aggregate(keys, values, map, kinds[k]));
+            // Values are multiples of 0.25 with small sums, so every order is exact
+            bool valid = map.size() == reference.size();
+            for (const auto& [key, sum] : reference) valid = valid && map.value_or(key, -1.0) == sum;
+            if (!valid) {
+                std::cerr << "Aggregation mismatch (s = " << s << ", strategy " << k << ")" << std::endl;
+                return 1;
+            }
+        }
+
+        auto rate = [n](double seconds) { return static_cast<double>(n) / seconds * 1e-6; };
+        std::cout << std::fixed << std::setprecision(1) << std::setw(6) << s << std::setw(10) << reference.size()
+                  << std::setw(16) << rate(serial) << std::setw(16) << rate(best[0]) << std::setw(16)
+                  << rate(best[1]) << std::defaultfloat << std::endl;
+    }
+    return 0;
+}
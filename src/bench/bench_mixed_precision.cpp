@@ -0,0 +1,170 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/low_precision.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace accessor;
+
+// Banded random matrix: nnz_per_row entries within +-band of the diagonal
+static CSRMatrixT<double> make_banded(size_t n, size_t nnz_per_row, size_t band, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    std::uniform_int_distribution<long long> offset(-static_cast<long long>(band), static_cast<long long>(band));
+    CSRMatrixT<double> a;
+    a.row_ptr.reserve(n + 1);
+    a.row_ptr.push_back(0);
+    std::vector<size_t> cols;
+    for (size_t r = 0; r < n; ++r) {
+        cols.clear();
+        for (size_t k = 0; k < nnz_per_row; ++k) {
+            long long c = static_cast<long long>(r) + offset(rng);
+            cols.push_back(static_cast<size_t>(std::clamp(c, 0LL, static_cast<long long>(n) - 1)));
+        }
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        for (size_t c : cols) {
+            a.col_indices.push_back(c);
+            a.values.push_back(value(rng));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+template<typename S, typename C>
+static DenseArray1D<S, C> convert_array(const std::vector<double>& v) {
+    DenseArray1D<S, C> out(v.size());
+    for (size_t i = 0; i < v.size(); ++i) out[i] = to_storage<S>(v[i]);
+    return out;
+}
+
+template<typename C, typename S>
+static double relative_error(const DenseArray1D<S, C>& y, const std::vector<double>& ref) {
+    double diff = 0.0, norm = 0.0;
+    for (size_t i = 0; i < ref.size(); ++i) {
+        diff = std::max(diff, std::abs(to_compute<double>(y.data[i]) - ref[i]));
+        norm = std::max(norm, std::abs(ref[i]));
+    }
+    return diff / norm;
+}
+
+static void print_row(const std::string& kernel, const std::string& pair, double seconds, double bytes, double error) {
+    std::cout << std::left << std::setw(6) << kernel << std::setw(12) << pair << std::right << std::fixed
+              << std::setprecision(3) << std::setw(10) << seconds * 1e3 << " ms" << std::setw(9)
+              << std::setprecision(2) << bytes / seconds * 1e-9 << " GB/s" << std::scientific
+              << std::setprecision(2) << std::setw(12) << error << std::defaultfloat << std::endl;
+}
+
+template<typename S, typename C>
+static void run_spmv(const std::string& pair, const CSRMatrixT<double>& a64, const std::vector<double>& x64,
+                     const std::vector<double>& y_ref, int reps) {
+    using Matrix = CSRMatrixT<S, C>;
+    using Vec = DenseArray1D<S, C>;
+    using Out = DenseArray1D<C>;
+    Matrix a = convert_precision<S, C>(a64);
+    Vec x = convert_array<S, C>(x64);
+    Out y(a.num_rows());
+
+    Accessor<Matrix, AccessMode::Read> a_acc(a);
+    Accessor<Vec, AccessMode::Read> x_acc(x);
+    Accessor<Out, AccessMode::Write> y_acc(y);
+    auto kernel = [](size_t row_idx, const Accessor<Matrix, AccessMode::Read>& m,
+                     const Accessor<Vec, AccessMode::Read>& xa, Accessor<Out, AccessMode::Write>& ya) {
+        auto row = m.get_view(row_idx, GetCSRRowViewTag{});
+        C sum = 0;
+        for (size_t i = 0; i < row.num_non_zeros; ++i) {
+            sum += row.value(i) * xa.get_value_by_id(row.col_indices_ptr[i]);
+        }
+        ya.set_value_by_id(row_idx, sum);
+    };
+    custom_parallel_for(IterateOver::CSRRows(a), kernel, a_acc, x_acc, y_acc);
+    double error = relative_error(y, y_ref);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        custom_parallel_for(IterateOver::CSRRows(a), kernel, a_acc, x_acc, y_acc);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count() / reps;
+    double bytes = static_cast<double>(a.num_nonzeros()) * (sizeof(S) + sizeof(size_t))
+                 + static_cast<double>(a.num_rows()) * (2 * sizeof(size_t) + sizeof(S) + sizeof(C));
+    print_row("SpMV", pair, seconds, bytes, error);
+}
+
+template<typename S, typename C>
+static void run_saxpy(const std::string& pair, const std::vector<double>& x64, const std::vector<double>& y64,
+                      double alpha, int reps) {
+    using Vec = DenseArray1D<S, C>;
+    const size_t n = x64.size();
+    std::vector<double> ref(n);
+    for (size_t i = 0; i < n; ++i) {
+        ref[i] = alpha * to_compute<double>(to_storage<S>(x64[i])) + to_compute<double>(to_storage<S>(y64[i]));
+    }
+
+    Vec x = convert_array<S, C>(x64), y = convert_array<S, C>(y64);
+    Accessor<Vec, AccessMode::Read> x_acc(x);
+    Accessor<Vec, AccessMode::ReadWrite> y_acc(y);
+    const C a = static_cast<C>(alpha);
+    auto kernel = [a](size_t i, const Accessor<Vec, AccessMode::Read>& xa, Accessor<Vec, AccessMode::ReadWrite>& ya) {
+        ya.set_value_by_id(i, a * xa.get_value_by_id(i) + ya.get_value_by_id(i));
+    };
+    custom_parallel_for(IterateOver::Range1D(n), kernel, x_acc, y_acc);
+    // Error of one update, relative to the exact result on the stored inputs
+    double error = relative_error<C>(y, ref);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        custom_parallel_for(IterateOver::Range1D(n), kernel, x_acc, y_acc);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count() / reps;
+    print_row("SAXPY", pair, seconds, 3.0 * static_cast<double>(n) * sizeof(S), error);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1 << 20;
+    int reps = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    CSRMatrixT<double> a = make_banded(n, 16, 64, 5);
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> x(n), y(n);
+    for (size_t i = 0; i < n; ++i) { x[i] = dist(rng); y[i] = dist(rng); }
+
+    // Reference: fp64 storage and compute
+    std::vector<double> y_ref(n);
+    for (size_t r = 0; r < n; ++r) {
+        double sum = 0.0;
+        for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) sum += a.values[k] * x[a.col_indices[k]];
+        y_ref[r] = sum;
+    }
+
+    std::cout << "n = " << n << ", nnz = " << a.num_nonzeros() << ", threads " << omp_get_max_threads() << std::endl;
+    std::cout << "Errors are max-norm relative errors against fp64 (SpMV) or the exact update of the stored inputs (SAXPY)" << std::endl;
+    run_spmv<double, double>("fp64/fp64", a, x, y_ref, reps);
+    run_spmv<float, double>("fp32/fp64", a, x, y_ref, reps);
+    run_spmv<float, float>("fp32/fp32", a, x, y_ref, reps);
+    run_spmv<half, float>("fp16/fp32", a, x, y_ref, reps);
+    run_spmv<bfloat16, float>("bf16/fp32", a, x, y_ref, reps);
+    run_spmv<bfloat16, double>("bf16/fp64", a, x, y_ref, reps);
+
+    run_saxpy<double, double>("fp64/fp64", x, y, 0.75, reps);
+    run_saxpy<float, double>("fp32/fp64", x, y, 0.75, reps);
+    run_saxpy<float, float>("fp32/fp32", x, y, 0.75, reps);
+    run_saxpy<half, float>("fp16/fp32", x, y, 0.75, reps);
+    run_saxpy<bfloat16, float>("bf16/fp32", x, y, 0.75, reps);
+    return 0;
+}
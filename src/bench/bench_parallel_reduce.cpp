@@ -0,0 +1,106 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_reduce.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace accessor;
+using IterateOver::Range1D;
+
+using Vec = DenseArray1D<double>;
+using ReadAcc = Accessor<Vec, AccessMode::Read>;
+
+template<typename F>
+static double best_of(int trials, F&& f) {
+    double best = 1e30;
+    for (int t = 0; t < trials; ++t) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+static uint64_t bits(double v) {
+    uint64_t b;
+    std::memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : (size_t{1} << 24);
+    int trials = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    Vec x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x.data[i] = std::sin(static_cast<double>(i)) * 1e3;
+        y.data[i] = std::cos(static_cast<double>(i) * 0.37);
+    }
+    long double exact = 0;
+    for (size_t i = 0; i < n; ++i) exact += static_cast<long double>(x.data[i]) * y.data[i];
+
+    ReadAcc xa(x), ya(y);
+    auto dot = [](size_t i, const ReadAcc& a, const ReadAcc& b) { return a.get_value_by_id(i) * b.get_value_by_id(i); };
+    const double gb = 2.0 * static_cast<double>(n * sizeof(double)) / 1e9;
+
+    struct Variant {
+        std::string name;
+        std::function<double()> run;
+    };
+    const double* xp = x.data.data();
+    const double* yp = y.data.data();
+    const long long n_ll = static_cast<long long>(n);
+    const std::vector<Variant> variants = {
+        {"omp reduction(+)", [&] {
+            double sum = 0;
+            #pragma omp parallel for reduction(+:sum) schedule(static)
+            for (long long i = 0; i < n_ll; ++i) sum += xp[i] * yp[i];
+            return sum;
+        }},
+        {"custom_parallel_reduce fast", [&] { return custom_parallel_reduce(Range1D(n), dot, 0.0, std::plus<>{}, xa, ya); }},
+        {"reproducible", [&] {
+            return custom_parallel_reduce(Range1D(n), reproducible_reduce(), dot, 0.0, std::plus<>{}, xa, ya);
+        }},
+        {"reproducible compensated", [&] {
+            return custom_parallel_reduce(Range1D(n), reproducible_reduce(2048, true), dot, 0.0, std::plus<>{}, xa, ya);
+        }},
+    };
+
+    // At least up to 8 threads (oversubscribed if need be) so the determinism check means something
+    const int max_threads = omp_get_max_threads();
+    const int top = std::max(max_threads, 8);
+    std::vector<int> thread_counts;
+    for (int threads = 1; threads < top; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(top);
+
+    std::cout << "dot product, n = " << n << " doubles" << std::endl;
+    for (const Variant& v : variants) {
+        std::vector<uint64_t> results;
+        for (int threads : thread_counts) {
+            omp_set_num_threads(threads);
+            double result = 0;
+            double t = best_of(trials, [&] { result = v.run(); });
+            results.push_back(bits(result));
+            std::cout << std::left << std::setw(30) << v.name << std::right << " threads " << std::setw(3) << threads
+                      << std::fixed << std::setprecision(3) << std::setw(9) << t * 1e3 << " ms" << std::setprecision(2)
+                      << std::setw(8) << gb / t << " GB/s" << std::defaultfloat << std::setprecision(3)
+                      << "  rel. error " << std::abs(static_cast<long double>(result) - exact) / std::abs(exact)
+                      << std::endl;
+        }
+        const bool identical = std::all_of(results.begin(), results.end(), [&](uint64_t b) { return b == results[0]; });
+        std::cout << std::left << std::setw(30) << v.name << " bit-identical across thread counts: "
+                  << (identical ? "yes" : "no") << std::endl;
+    }
+    omp_set_num_threads(max_threads);
+    return 0;
+}
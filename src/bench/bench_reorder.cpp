@@ -0,0 +1,114 @@
+#include <accessor/algorithms/reordering.hpp>
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/permutation.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <accessor/traits/permuted_view_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace accessor;
+
+// 7-point Laplacian on an n^3 grid with randomly shuffled vertex numbering
+static CSRMatrix make_shuffled_laplacian_3d(size_t n, unsigned seed) {
+    const size_t N = n * n * n;
+    CSRMatrix grid;
+    grid.row_ptr.reserve(N + 1);
+    grid.row_ptr.push_back(0);
+    for (size_t z = 0; z < n; ++z) {
+        for (size_t y = 0; y < n; ++y) {
+            for (size_t x = 0; x < n; ++x) {
+                size_t v = (z * n + y) * n + x;
+                auto add = [&](size_t c, float val) { grid.col_indices.push_back(c); grid.values.push_back(val); };
+                if (z > 0) add(v - n * n, -1.0f);
+                if (y > 0) add(v - n, -1.0f);
+                if (x > 0) add(v - 1, -1.0f);
+                add(v, 6.0f);
+                if (x + 1 < n) add(v + 1, -1.0f);
+                if (y + 1 < n) add(v + n, -1.0f);
+                if (z + 1 < n) add(v + n * n, -1.0f);
+                grid.row_ptr.push_back(grid.col_indices.size());
+            }
+        }
+    }
+    std::vector<size_t> label(N);
+    std::iota(label.begin(), label.end(), size_t{0});
+    std::shuffle(label.begin(), label.end(), std::mt19937(seed));
+    return permute_matrix(grid, Permutation(std::move(label)));
+}
+
+template<typename XAcc>
+static double time_spmv(const CSRMatrix& a, XAcc& x_acc, DenseArray1D<float>& y, int reps) {
+    Accessor<CSRMatrix, AccessMode::Read> a_acc(a);
+    Accessor<DenseArray1D<float>, AccessMode::Write> y_acc(y);
+    auto kernel = [](size_t row_idx, const Accessor<CSRMatrix, AccessMode::Read>& m, const XAcc& xa,
+                     Accessor<DenseArray1D<float>, AccessMode::Write>& ya) {
+        auto row = m.get_view(row_idx, GetCSRRowViewTag{});
+        float sum = 0.0f;
+        for (size_t i = 0; i < row.num_non_zeros; ++i) {
+            sum += row.values_ptr[i] * xa.get_value_by_id(row.col_indices_ptr[i]);
+        }
+        ya.set_value_by_id(row_idx, sum);
+    };
+    custom_parallel_for(IterateOver::CSRRows(a), kernel, a_acc, x_acc, y_acc);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        custom_parallel_for(IterateOver::CSRRows(a), kernel, a_acc, x_acc, y_acc);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count() / reps;
+}
+
+static void report(const std::string& name, const CSRMatrix& a, double reorder_seconds, double spmv_seconds) {
+    std::cout << name << ": bandwidth " << matrix_bandwidth(a) << ", profile " << matrix_profile(a)
+              << ", reorder " << reorder_seconds * 1e3 << " ms, SpMV " << spmv_seconds * 1e3 << " ms" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 64;
+    int reps = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    CSRMatrix a = make_shuffled_laplacian_3d(n, 11);
+    const size_t N = a.num_rows();
+    std::cout << "Shuffled 3D Laplacian " << n << "^3: " << N << " rows, " << a.num_nonzeros()
+              << " nnz, threads " << omp_get_max_threads() << std::endl;
+
+    DenseArray1D<float> x(N), y(N);
+    for (size_t i = 0; i < N; ++i) x[i] = 1.0f + static_cast<float>(i % 7);
+    Accessor<DenseArray1D<float>, AccessMode::Read> x_acc(x);
+    report("original", a, 0.0, time_spmv(a, x_acc, y, reps));
+
+    struct Candidate { const char* name; Permutation (*make)(const CSRMatrix&); };
+    const Candidate candidates[] = {
+        {"RCM", [](const CSRMatrix& m) { return reverse_cuthill_mckee(m); }},
+        {"degree sort", [](const CSRMatrix& m) { return degree_sort(m); }},
+        {"hub sort", [](const CSRMatrix& m) { return hub_sort(m); }},
+    };
+    for (const Candidate& c : candidates) {
+        auto t0 = std::chrono::steady_clock::now();
+        Permutation p = c.make(a);
+        CSRMatrix b = permute_matrix(a, p);
+        auto t1 = std::chrono::steady_clock::now();
+
+        DenseArray1D<float> px;
+        permute_vector(x, p, px);
+        Accessor<DenseArray1D<float>, AccessMode::Read> px_acc(px);
+        report(c.name, b, std::chrono::duration<double>(t1 - t0).count(), time_spmv(b, px_acc, y, reps));
+
+        if (std::string(c.name) == "RCM") {
+            // Same kernel, x left in original order and read through the permutation
+            PermutedView<DenseArray1D<float>> view(x, p);
+            Accessor<PermutedView<DenseArray1D<float>>, AccessMode::Read> view_acc(view);
+            std::cout << "RCM, x via PermutedView: SpMV " << time_spmv(b, view_acc, y, reps) * 1e3 << " ms" << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_scan.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <execution>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace accessor;
+
+struct SimpleRange {
+    size_t count;
+    size_t size() const { return count; }
+    size_t operator[](size_t idx) const { return idx; }
+};
+
+template<typename F>
+static double best_of(int trials, F&& f) {
+    double best = 1e30;
+    for (int t = 0; t < trials; ++t) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : (size_t{1} << 25);
+    int trials = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    DenseArray1D<double> in(n), out(n);
+    for (size_t i = 0; i < n; ++i) in[i] = static_cast<double>(i % 7);
+    std::vector<double> ref(n);
+
+    // Two-pass scan streams read n + read n + write n (one pass with one thread);
+    // std scans stream read n + write n
+    const double gb = static_cast<double>(n * sizeof(double)) / 1e9;
+    std::cout << "n = " << n << " doubles" << std::endl;
+
+    double t_seq = best_of(trials, [&] { std::inclusive_scan(std::execution::seq, in.data.begin(), in.data.end(), ref.begin()); });
+    double t_par = best_of(trials, [&] { std::inclusive_scan(std::execution::par, in.data.begin(), in.data.end(), ref.begin()); });
+    std::cout << "std::inclusive_scan seq: " << t_seq * 1e3 << " ms (" << 2 * gb / t_seq << " GB/s)" << std::endl;
+    std::cout << "std::inclusive_scan par: " << t_par * 1e3 << " ms (" << 2 * gb / t_par << " GB/s)" << std::endl;
+
+    Accessor<DenseArray1D<double>, AccessMode::Read> in_acc(in);
+    Accessor<DenseArray1D<double>, AccessMode::Write> out_acc(out);
+    Accessor<DenseArray1D<double>, AccessMode::Write> in_place_acc(in);
+
+    const int max_threads = omp_get_max_threads();
+    std::vector<int> thread_counts;
+    for (int threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    for (int threads : thread_counts) {
+        omp_set_num_threads(threads);
+        double t = best_of(trials, [&] {
+            custom_parallel_scan(SimpleRange{n}, ScanKind::Inclusive, 0.0, std::plus<>{}, in_acc, out_acc);
+        });
+        std::cout << "custom_parallel_scan threads " << threads << ": " << t * 1e3 << " ms ("
+                  << (threads == 1 ? 2 : 3) * gb / t << " GB/s, speedup vs seq " << t_seq / t << "x)" << std::endl;
+    }
+    omp_set_num_threads(max_threads);
+
+    if (out.data != ref) {
+        std::cerr << "custom_parallel_scan result mismatch" << std::endl;
+        return 1;
+    }
+
+    // In place: x = scan(x), no copy of x is made
+    double t_ip = best_of(trials, [&] {
+        custom_parallel_scan(SimpleRange{n}, ScanKind::Inclusive, 0.0, std::plus<>{}, in_acc, in_place_acc);
+    });
+    std::cout << "custom_parallel_scan in place, threads " << max_threads << ": " << t_ip * 1e3 << " ms" << std::endl;
+    return 0;
+}
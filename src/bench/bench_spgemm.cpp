@@ -0,0 +1,131 @@
+#include <accessor/core/spgemm.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <omp.h>
+#include <string>
+#include <vector>
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<double>;
+
+/// 7-point Laplacian on an n^3 grid, Dirichlet boundary
+static Matrix make_poisson_3d(size_t n) {
+    const size_t rows = n * n * n;
+    const size_t strides[3] = {1, n, n * n};
+    Matrix a;
+    a.row_ptr.reserve(rows + 1);
+    a.row_ptr.push_back(0);
+    for (size_t row = 0; row < rows; ++row) {
+        size_t c[3] = {row % n, (row / n) % n, row / (n * n)};
+        for (size_t d = 3; d-- > 0;) {
+            if (c[d] > 0) { a.col_indices.push_back(row - strides[d]); a.values.push_back(-1.0); }
+        }
+        a.col_indices.push_back(row);
+        a.values.push_back(6.0);
+        for (size_t d = 0; d < 3; ++d) {
+            if (c[d] + 1 < n) { a.col_indices.push_back(row + strides[d]); a.values.push_back(-1.0); }
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+/// Smoothed-aggregation prolongator: 2x2x2 aggregates, P = (I - w D^-1 A) P_tent
+static Matrix make_prolongator(const Matrix& a, size_t n) {
+    const size_t nc = (n + 1) / 2;
+    Matrix tent;
+    tent.row_ptr.push_back(0);
+    for (size_t row = 0; row < n * n * n; ++row) {
+        const size_t x = row % n / 2, y = row / n % n / 2, z = row / (n * n) / 2;
+        tent.col_indices.push_back(x + nc * (y + nc * z));
+        tent.values.push_back(1.0);
+        tent.row_ptr.push_back(tent.col_indices.size());
+    }
+    Matrix smoother = a;   // I - w D^-1 A with w = 2/3
+    for (size_t r = 0; r < smoother.num_rows(); ++r) {
+        for (size_t k = smoother.row_ptr[r]; k < smoother.row_ptr[r + 1]; ++k) {
+            const double scaled = -(2.0 / 3.0) * smoother.values[k] / 6.0;
+            smoother.values[k] = smoother.col_indices[k] == r ? 1.0 + scaled : scaled;
+        }
+    }
+    return spgemm(smoother, tent);
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void run(const char* name, const Matrix& a, const Matrix& p, const Matrix& r, SpGEMMOptions opts) {
+    double best_symbolic = 1e30, best_numeric = 1e30, best_full = 1e30;
+    SpGEMMPattern ap_pattern, rap_pattern;
+    Matrix ap, rap;
+    // R (A P) needs the values of A P, so the phases alternate: symbolic A P,
+    // numeric A P, symbolic R (A P), numeric R (A P)
+    for (int rep = 0; rep < 3; ++rep) {
+        auto t0 = std::chrono::steady_clock::now();
+        ap_pattern = spgemm_symbolic(a, p, r.num_rows(), opts);
+        const double s0 = seconds_since(t0);
+        auto t1 = std::chrono::steady_clock::now();
+        ap = Matrix{};
+        spgemm_numeric(ap_pattern, a, p, ap);
+        const double n0 = seconds_since(t1);
+        auto t2 = std::chrono::steady_clock::now();
+        rap_pattern = spgemm_symbolic(r, ap, r.num_rows(), opts);
+        const double s1 = seconds_since(t2);
+        auto t3 = std::chrono::steady_clock::now();
+        rap = Matrix{};
+        spgemm_numeric(rap_pattern, r, ap, rap);
+        const double n1 = seconds_since(t3);
+        best_full = std::min(best_full, seconds_since(t0));
+        best_symbolic = std::min(best_symbolic, s0 + s1);
+        best_numeric = std::min(best_numeric, n0 + n1);
+    }
+
+    // Reuse: new values in A (e.g. a new time step), same structure
+    Matrix a2 = a;
+    for (double& v : a2.values) v *= 1.5;
+    double best_reuse = 1e30;
+    for (int rep = 0; rep < 3; ++rep) {
+        auto t0 = std::chrono::steady_clock::now();
+        spgemm_numeric(ap_pattern, a2, p, ap);
+        spgemm_numeric(rap_pattern, r, ap, rap);
+        best_reuse = std::min(best_reuse, seconds_since(t0));
+    }
+
+    const double flops = 2.0 * static_cast<double>(ap_pattern.flops + rap_pattern.flops);
+    std::cout << "  " << std::left << std::setw(6) << name << std::right << std::fixed << std::setprecision(2)
+              << " full " << std::setw(8) << best_full * 1e3 << " ms (symbolic " << std::setw(7)
+              << best_symbolic * 1e3 << ", numeric " << std::setw(7) << best_numeric * 1e3 << ")  reuse "
+              << std::setw(7) << best_reuse * 1e3 << " ms, " << std::setw(5) << flops / best_reuse / 1e9
+              << " GFLOP/s  (" << std::setprecision(1) << best_full / best_reuse << "x)  dense rows "
+              << ap_pattern.dense_rows + rap_pattern.dense_rows << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 64;
+    Matrix a = make_poisson_3d(n);
+    Matrix p = make_prolongator(a, n);
+    const size_t coarse = ((n + 1) / 2) * ((n + 1) / 2) * ((n + 1) / 2);
+    Matrix r = transpose_csr(p, coarse);
+    SpGEMMPattern ap = spgemm_symbolic(a, p, coarse);
+    Matrix ap_values;
+    spgemm_numeric(ap, a, p, ap_values);
+    Matrix rap = spgemm(r, ap_values);
+    std::cout << "threads " << omp_get_max_threads() << ", Galerkin R A P on Poisson 3D " << n << "^3: A "
+              << a.num_rows() << " rows / " << a.num_nonzeros() << " nnz, P " << p.num_nonzeros() << " nnz, A P "
+              << ap_values.num_nonzeros() << " nnz, R A P " << rap.num_rows() << " rows / " << rap.num_nonzeros()
+              << " nnz" << std::endl;
+
+    struct Variant { const char* name; SpGEMMAccumulator accumulator; };
+    const Variant variants[] = {
+        {"auto", SpGEMMAccumulator::Auto}, {"hash", SpGEMMAccumulator::Hash}, {"dense", SpGEMMAccumulator::Dense}};
+    for (const Variant& v : variants) {
+        SpGEMMOptions opts;
+        opts.accumulator = v.accumulator;
+        run(v.name, a, p, r, opts);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <accessor/algorithms/spmv_autotune.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <omp.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace accessor;
+
+/// 5-point Laplacian on an n x n grid with randomly shuffled unknowns (large bandwidth)
+static CSRMatrix make_shuffled_poisson(size_t n) {
+    CSRMatrix a;
+    a.row_ptr.push_back(0);
+    for (size_t row = 0; row < n * n; ++row) {
+        const size_t x = row % n, y = row / n;
+        if (y > 0) { a.col_indices.push_back(row - n); a.values.push_back(-1.0f); }
+        if (x > 0) { a.col_indices.push_back(row - 1); a.values.push_back(-1.0f); }
+        a.col_indices.push_back(row);
+        a.values.push_back(4.0f);
+        if (x + 1 < n) { a.col_indices.push_back(row + 1); a.values.push_back(-1.0f); }
+        if (y + 1 < n) { a.col_indices.push_back(row + n); a.values.push_back(-1.0f); }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    std::vector<size_t> order(n * n);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+    return permute_matrix(a, Permutation(std::move(order)));
+}
+
+/// Power-law row lengths (Zipf-like), random columns
+static CSRMatrix make_power_law(size_t n, size_t mean_degree) {
+    std::mt19937 rng(2);
+    std::uniform_int_distribution<size_t> col(0, n - 1);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    CSRMatrix a;
+    a.row_ptr.push_back(0);
+    std::vector<size_t> cols;
+    for (size_t r = 0; r < n; ++r) {
+        const double len = static_cast<double>(mean_degree) / 4.0 / std::pow(std::max(u(rng), 1e-6), 0.75);
+        cols.clear();
+        for (size_t k = 0; k < std::min(n, static_cast<size_t>(len)); ++k) cols.push_back(col(rng));
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        for (size_t c : cols) {
+            a.col_indices.push_back(c);
+            a.values.push_back(1.0f);
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+/// Banded matrix with uniform rows
+static CSRMatrix make_banded(size_t n, size_t half_width) {
+    CSRMatrix a;
+    a.row_ptr.push_back(0);
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t c = r > half_width ? r - half_width : 0; c <= std::min(n - 1, r + half_width); ++c) {
+            a.col_indices.push_back(c);
+            a.values.push_back(c == r ? 2.0f : -0.1f);
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static double time_plan(SpMVPlan& plan, size_t n) {
+    DenseArray1D<float> x(std::vector<float>(n, 1.0f)), y(n);
+    plan.apply(x, y);
+    double best = 1e30;
+    for (int rep = 0; rep < 10; ++rep) {
+        auto t0 = std::chrono::steady_clock::now();
+        plan.apply(x, y);
+        best = std::min(best, seconds_since(t0));
+    }
+    return best;
+}
+
+static void run(const char* name, const CSRMatrix& a, const std::string& cache) {
+    SpMVAutotuneOptions opts;
+    opts.cache_path = cache;
+    SpMVAutotuner tuner(opts);
+    auto t0 = std::chrono::steady_clock::now();
+    SpMVPlan tuned = tuner.tune(a);
+    const double tune_time = seconds_since(t0);
+    const MatrixFeatures& f = tuner.last_features();
+
+    // A second tuner stands in for a later run reading the cache
+    SpMVAutotuner later(opts);
+    auto t1 = std::chrono::steady_clock::now();
+    SpMVPlan cached = later.tune(a);
+    const double cached_time = seconds_since(t1);
+
+    SpMVPlan baseline(a, SpMVPlanConfig{});
+    const double base = time_plan(baseline, a.num_rows()), best = time_plan(tuned, a.num_rows());
+    std::cout << name << ": " << f.rows << " rows, " << f.nonzeros << " nnz, row cv " << std::fixed
+              << std::setprecision(2) << f.row_length_cv() << ", bandwidth " << f.bandwidth << std::endl;
+    for (const SpMVTrial& t : tuner.last_trials()) {
+        std::cout << "    " << std::left << std::setw(32) << to_string(t.config) << std::right << std::setprecision(3)
+                  << std::setw(9) << t.seconds * 1e3 << " ms" << std::endl;
+    }
+    std::cout << "  chosen " << to_string(tuned.config()) << ": " << std::setprecision(3) << best * 1e3 << " ms vs "
+              << base * 1e3 << " ms default (" << std::setprecision(2) << base / best << "x); tuning "
+              << std::setprecision(1) << tune_time * 1e3 << " ms, cached plan " << cached_time * 1e3 << " ms"
+              << (later.last_from_cache() && cached.config() == tuned.config() ? "" : " (cache miss!)")
+              << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const size_t scale = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1;
+    const std::string cache =
+        (std::filesystem::temp_directory_path() / "accessor_bench_spmv_autotune.cache").string();
+    std::filesystem::remove(cache);
+    std::cout << "threads " << omp_get_max_threads() << std::endl;
+    run("shuffled poisson", make_shuffled_poisson(700 * scale), cache);
+    run("power law", make_power_law(400000 * scale, 16), cache);
+    run("banded", make_banded(500000 * scale, 4), cache);
+    std::filesystem::remove(cache);
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/static_extent.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_fixed_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <omp.h>
+#include <random>
+#include <vector>
+
+using namespace accessor;
+
+using Vec = DenseArray1D<float>;
+
+static CSRMatrix make_random(size_t n, size_t degree) {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> col(0, n - 1);
+    CSRMatrix a;
+    a.row_ptr.reserve(n + 1);
+    a.row_ptr.push_back(0);
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t k = 0; k < degree; ++k) {
+            a.col_indices.push_back(col(rng));
+            a.values.push_back(1.0f / static_cast<float>(k + 1));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+/// Y = A X with row-major X and Y of K columns, K fixed at compile time
+template<size_t K>
+static void spmm_fixed(const CSRMatrix& a, const Vec& x, Vec& y) {
+    Accessor<CSRMatrix, AccessMode::Read> mat(a);
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_parallel_for(IterateOver::CSRRows(a),
+        [](size_t row, const auto& m, const auto& xv, auto& yv) {
+            auto view = m.get_view(row, GetCSRRowViewTag{});
+            DenseArrayFixed<float, K> acc;
+            for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                const float value = view.value(k);
+                auto x_row = xv.get_view(view.col_indices_ptr[k] * K, GetDenseArrayStaticBlockViewTag<K>{});
+                static_for<K>([&](auto j) { acc[j] += value * x_row.value(j); });
+            }
+            static_for<K>([&](auto j) { yv.set_value_by_id(row * K + j, acc[j]); });
+        },
+        mat, x_in, y_out);
+}
+
+/// Same product with the width known only at run time
+static void spmm_dynamic(const CSRMatrix& a, const Vec& x, Vec& y, size_t width) {
+    Accessor<CSRMatrix, AccessMode::Read> mat(a);
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_parallel_for(IterateOver::CSRRows(a),
+        [width](size_t row, const auto& m, const auto& xv, auto& yv) {
+            auto view = m.get_view(row, GetCSRRowViewTag{});
+            std::vector<float> acc(width, 0.0f);
+            for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                const float value = view.value(k);
+                auto x_row = xv.get_view(view.col_indices_ptr[k] * width, GetDenseArrayBlockViewTag{width});
+                for (size_t j = 0; j < width; ++j) acc[j] += value * x_row.value(j);
+            }
+            for (size_t j = 0; j < width; ++j) yv.set_value_by_id(row * width + j, acc[j]);
+        },
+        mat, x_in, y_out);
+}
+
+/// y_i = B_i x_i for a batch of B x B blocks, B fixed at compile time
+template<size_t B>
+static void block_matvec_fixed(size_t items, const Vec& blocks, const Vec& x, Vec& y) {
+    Accessor<Vec, AccessMode::Read> b_in(blocks), x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_parallel_for(IterateOver::Range1D(items),
+        [](size_t item, const auto& bv, const auto& xv, auto& yv) {
+            auto xi = xv.get_view(item * B, GetDenseArrayStaticBlockViewTag<B>{});
+            static_for<B>([&](auto r) {
+                auto row = bv.get_view((item * B + r) * B, GetDenseArrayStaticBlockViewTag<B>{});
+                float sum = 0;
+                static_for<B>([&](auto c) { sum += row.value(c) * xi.value(c); });
+                yv.set_value_by_id(item * B + r, sum);
+            });
+        },
+        b_in, x_in, y_out);
+}
+
+static void block_matvec_dynamic(size_t items, size_t bs, const Vec& blocks, const Vec& x, Vec& y) {
+    Accessor<Vec, AccessMode::Read> b_in(blocks), x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_parallel_for(IterateOver::Range1D(items),
+        [bs](size_t item, const auto& bv, const auto& xv, auto& yv) {
+            for (size_t r = 0; r < bs; ++r) {
+                float sum = 0;
+                for (size_t c = 0; c < bs; ++c) {
+                    sum += bv.get_value_by_id((item * bs + r) * bs + c) * xv.get_value_by_id(item * bs + c);
+                }
+                yv.set_value_by_id(item * bs + r, sum);
+            }
+        },
+        b_in, x_in, y_out);
+}
+
+template<typename F>
+static double best_of(int reps, F&& f) {
+    double best = 1e30;
+    for (int rep = 0; rep < reps; ++rep) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 200000;
+    const CSRMatrix a = make_random(n, 12);
+    std::cout << "threads " << omp_get_max_threads() << ", SpMM " << n << " rows, " << a.num_nonzeros()
+              << " nnz" << std::endl;
+    for (size_t width : {2, 4, 8, 16}) {
+        Vec x(std::vector<float>(n * width, 1.0f)), y(n * width);
+        const double dynamic = best_of(5, [&] { spmm_dynamic(a, x, y, width); });
+        const double fixed = best_of(5, [&] {
+            dispatch_common_extent(width, [&](auto k) { spmm_fixed<decltype(k)::value>(a, x, y); },
+                                   [&](size_t w) { spmm_dynamic(a, x, y, w); });
+        });
+        std::cout << "  width " << std::setw(2) << width << ": run-time " << std::fixed << std::setprecision(2)
+                  << std::setw(8) << dynamic * 1e3 << " ms, static " << std::setw(8) << fixed * 1e3 << " ms ("
+                  << dynamic / fixed << "x)" << std::defaultfloat << std::endl;
+    }
+
+    const size_t items = 4 * n;
+    std::cout << "batched block mat-vec, " << items << " blocks" << std::endl;
+    for (size_t bs : {3, 4}) {
+        Vec blocks(std::vector<float>(items * bs * bs, 0.5f)), x(std::vector<float>(items * bs, 1.0f)), y(items * bs);
+        const double dynamic = best_of(5, [&] { block_matvec_dynamic(items, bs, blocks, x, y); });
+        const double fixed = best_of(5, [&] {
+            dispatch_static_extent<3, 4>(bs, [&](auto b) { block_matvec_fixed<decltype(b)::value>(items, blocks, x, y); },
+                                         [&](size_t m) { block_matvec_dynamic(items, m, blocks, x, y); });
+        });
+        std::cout << "  " << bs << "x" << bs << ": run-time " << std::fixed << std::setprecision(2) << std::setw(8)
+                  << dynamic * 1e3 << " ms, static " << std::setw(8) << fixed * 1e3 << " ms (" << dynamic / fixed
+                  << "x)" << std::defaultfloat << std::endl;
+    }
+    return 0;
+}
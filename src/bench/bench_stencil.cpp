@@ -0,0 +1,89 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/ping_pong.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/iteration/tiled.hpp>
+#include <accessor/traits/dense_array_nd_traits.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace accessor;
+using IterateOver::TileOrder;
+
+using Grid3D = DenseArray3D<double>;
+using ReadAcc = Accessor<Grid3D, AccessMode::Read>;
+using WriteAcc = Accessor<Grid3D, AccessMode::Write>;
+
+static void report(const std::string& name, double seconds, size_t points, size_t steps) {
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << seconds / static_cast<double>(steps) * 1e3 << " ms/sweep" << std::setw(10)
+              << static_cast<double>(points * steps) / seconds * 1e-6 << " MLUP/s" << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 160;
+    size_t steps = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 10;
+    size_t tile = argc > 3 ? static_cast<size_t>(std::atoll(argv[3])) : 16;
+
+    Grid3D initial({n, n, n});
+    for (size_t i = 0; i < initial.size(); ++i) initial[i] = static_cast<double>(i % 17);
+    const size_t interior_points = (n - 2) * (n - 2) * (n - 2);
+    const Stencil<3, 7> star = star_stencil<3>();
+    const std::array<size_t, 3> ext{n, n, n}, lo{1, 1, 1}, hi{n - 1, n - 1, n - 1};
+
+    std::cout << "7-point Jacobi on " << n << "^3, " << steps << " sweeps, tile " << tile
+              << ", threads " << omp_get_max_threads() << std::endl;
+
+    auto stencil_kernel = [&star](size_t id, const ReadAcc& in, WriteAcc& out) {
+        auto nb = in.get_view(id, GetStencilNeighborhoodTag<3, 7>{&star});
+        out.set_value_by_id(id, (nb.value(1) + nb.value(2) + nb.value(3) + nb.value(4) + nb.value(5) + nb.value(6)) / 6.0);
+    };
+    const size_t plane = n * n;
+    auto manual_kernel = [n, plane](size_t id, const ReadAcc& in, WriteAcc& out) {
+        const double* u = in.data_ref.data.data();
+        out.set_value_by_id(id, (u[id - plane] + u[id + plane] + u[id - n] + u[id + n] + u[id - 1] + u[id + 1]) / 6.0);
+    };
+
+    // 1. Single grid, linear order: auto-buffer copies the whole grid every sweep
+    {
+        Grid3D g = initial;
+        ReadAcc in(g);
+        WriteAcc out(g);
+        IterateOver::Tiled3D interior(ext, lo, hi, ext);
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t s = 0; s < steps; ++s) custom_parallel_for(interior, stencil_kernel, in, out);
+        auto t1 = std::chrono::steady_clock::now();
+        report("auto-buffer, linear", std::chrono::duration<double>(t1 - t0).count(), interior_points, steps);
+    }
+
+    // 2. Ping-pong with different iteration orders
+    struct Variant { const char* name; std::array<size_t, 3> tile; TileOrder order; };
+    const Variant variants[] = {
+        {"ping-pong, linear", ext, TileOrder::RowMajor},
+        {"ping-pong, tiled", {tile, tile, n}, TileOrder::RowMajor},
+        {"ping-pong, tiled Morton", {tile, tile, n}, TileOrder::Morton},
+        {"ping-pong, cube tiles Morton", {tile, tile, tile}, TileOrder::Morton},
+    };
+    for (const Variant& v : variants) {
+        PingPong<Grid3D> grids(initial);
+        IterateOver::Tiled3D interior(ext, lo, hi, v.tile, v.order);
+        auto t0 = std::chrono::steady_clock::now();
+        ping_pong_sweeps(interior, grids, steps, stencil_kernel);
+        auto t1 = std::chrono::steady_clock::now();
+        report(v.name, std::chrono::duration<double>(t1 - t0).count(), interior_points, steps);
+    }
+
+    // 3. Same sweep with hand-written index arithmetic, for reference
+    {
+        PingPong<Grid3D> grids(initial);
+        IterateOver::Tiled3D interior(ext, lo, hi, {tile, tile, n});
+        auto t0 = std::chrono::steady_clock::now();
+        ping_pong_sweeps(interior, grids, steps, manual_kernel);
+        auto t1 = std::chrono::steady_clock::now();
+        report("ping-pong, tiled, manual indexing", std::chrono::duration<double>(t1 - t0).count(), interior_points, steps);
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <accessor/core/streaming_csr.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<double>;
+using Vec = DenseArray1D<double>;
+
+// Banded random matrix: nnz_per_row entries within +-band of the diagonal
+static Matrix make_banded(size_t n, size_t nnz_per_row, size_t band) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<long long> offset(-static_cast<long long>(band), static_cast<long long>(band));
+    Matrix a;
+    a.row_ptr.reserve(n + 1);
+    a.col_indices.reserve(n * nnz_per_row);
+    a.values.reserve(n * nnz_per_row);
+    a.row_ptr.push_back(0);
+    std::vector<size_t> cols;
+    for (size_t r = 0; r < n; ++r) {
+        cols.clear();
+        for (size_t k = 0; k < nnz_per_row; ++k) {
+            long long c = static_cast<long long>(r) + offset(rng);
+            cols.push_back(static_cast<size_t>(std::clamp(c, 0LL, static_cast<long long>(n) - 1)));
+        }
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        for (size_t c : cols) {
+            a.col_indices.push_back(c);
+            a.values.push_back(1.0 / static_cast<double>(1 + c % 5));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+/// Evict the file from the page cache so buffered reads hit the disk
+static void drop_cache(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+static void report(const char* name, const StreamingStats& s, double in_memory_gbps) {
+    const double bound = std::min(s.disk_gbps(), in_memory_gbps);
+    std::cout << "  " << std::left << std::setw(26) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(8) << s.total_seconds << " s  disk " << std::setprecision(2) << std::setw(6)
+              << s.disk_gbps() << " GB/s  compute " << std::setw(6) << s.compute_gbps() << " GB/s  achieved "
+              << std::setw(6) << s.achieved_gbps() << " GB/s (" << std::setprecision(0)
+              << 100.0 * s.achieved_gbps() / bound << "% of min(disk, in-memory))  stall " << std::setprecision(3)
+              << s.stall_seconds << " s" << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 2000000;
+    size_t nnz_per_row = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 16;
+    std::string dir = argc > 3 ? argv[3] : std::filesystem::temp_directory_path().string();
+    size_t block_nonzeros = argc > 4 ? static_cast<size_t>(std::atoll(argv[4])) : size_t{1} << 22;
+    const std::string path = dir + "/accessor_bench_stream_" + std::to_string(::getpid()) + ".csr";
+
+    Matrix a = make_banded(n, nnz_per_row, 2000);
+    write_csr_file(path, a);
+    const double file_gb = static_cast<double>(a.num_nonzeros() * (sizeof(size_t) + sizeof(double))) / 1e9;
+    std::cout << "threads " << omp_get_max_threads() << ", " << n << " rows, " << a.num_nonzeros() << " nonzeros, "
+              << std::setprecision(3) << file_gb << " GB streamed per SpMV, file " << path << std::endl;
+
+    Vec x(std::vector<double>(n, 1.0)), y(n);
+
+    // In-memory SpMV: what the compute side can sustain
+    double in_memory = 1e30;
+    {
+        Accessor<Matrix, AccessMode::Read> mat(a);
+        Accessor<Vec, AccessMode::Read> x_in(x);
+        Accessor<Vec, AccessMode::Write> y_out(y);
+        for (int rep = 0; rep < 3; ++rep) {
+            auto t0 = std::chrono::steady_clock::now();
+            custom_parallel_for(IterateOver::CSRRows(a),
+                [](size_t row, const auto& m, const auto& xv, auto& yv) {
+                    auto view = m.get_view(row, GetCSRRowViewTag{});
+                    double sum = 0;
+                    for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                        sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+                    }
+                    yv.set_value_by_id(row, sum);
+                },
+                mat, x_in, y_out);
+            in_memory = std::min(in_memory, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+        }
+    }
+    const double in_memory_gbps = file_gb / in_memory;
+    std::cout << "  in-memory SpMV            " << std::fixed << std::setprecision(3) << in_memory << " s  "
+              << std::setprecision(2) << in_memory_gbps << " GB/s of matrix data" << std::defaultfloat << std::endl;
+    a = Matrix{};   // Streaming runs only hold a few blocks
+
+    struct Config { const char* name; size_t depth; bool direct; bool cold; };
+    const Config configs[] = {
+        {"page cache, depth 1", 1, false, false},
+        {"page cache, depth 2", 2, false, false},
+        {"page cache, depth 3", 3, false, false},
+        {"cold buffered, depth 1", 1, false, true},
+        {"cold buffered, depth 2", 2, false, true},
+        {"cold buffered, depth 3", 3, false, true},
+        {"O_DIRECT, depth 2", 2, true, false},
+        {"O_DIRECT, depth 3", 3, true, false},
+    };
+    for (const Config& c : configs) {
+        StreamingOptions opts;
+        opts.block_nonzeros = block_nonzeros;
+        opts.pipeline_depth = c.depth;
+        opts.direct_io = c.direct;
+        StreamingCSRReader<double> reader(path, opts);
+        if (c.direct && !reader.direct_io_active()) {
+            std::cout << "  " << c.name << ": O_DIRECT not supported here, skipped" << std::endl;
+            continue;
+        }
+        if (c.cold) drop_cache(path);
+        report(c.name, streaming_spmv(reader, x, y), in_memory_gbps);
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/custom_team_parallel_for.hpp>
+#include <accessor/iteration/csr_row_blocks.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <omp.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace accessor;
+using IterateOver::CSRRowBlock;
+
+using Vec = DenseArray1D<float>;
+
+/// n rows of `degree` nonzeros plus `long_rows` rows holding `long_nnz` each
+static CSRMatrix make_skewed(size_t n, size_t degree, size_t long_rows, size_t long_nnz) {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> col(0, n - 1);
+    CSRMatrix a;
+    a.row_ptr.reserve(n + 1);
+    a.row_ptr.push_back(0);
+    const size_t stride = long_rows ? n / long_rows : n + 1;
+    for (size_t r = 0; r < n; ++r) {
+        const size_t len = long_rows && r % stride == 0 ? long_nnz : degree;
+        for (size_t k = 0; k < len; ++k) {
+            a.col_indices.push_back(col(rng));
+            a.values.push_back(1.0f / static_cast<float>(k % 16 + 1));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+static void spmv_rows(const CSRMatrix& a, const Vec& x, Vec& y, const LoopSchedule& schedule) {
+    Accessor<CSRMatrix, AccessMode::Read> mat(a);
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_parallel_for(schedule, IterateOver::CSRRows(a),
+        [](size_t row, const auto& m, const auto& xv, auto& yv) {
+            auto view = m.get_view(row, GetCSRRowViewTag{});
+            float sum = 0;
+            for (size_t k = 0; k < view.num_non_zeros; ++k) sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+            yv.set_value_by_id(row, sum);
+        },
+        mat, x_in, y_out);
+}
+
+static void spmv_team(const CSRMatrix& a, const Vec& x, Vec& y, const TeamPolicy& policy,
+                      const IterateOver::CSRRowBlocks& blocks) {
+    Accessor<CSRMatrix, AccessMode::Read> mat(a);
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_team_parallel_for(policy, blocks,
+        [](TeamMember& team, CSRRowBlock block, const auto& m, const auto& xv, auto& yv) {
+            if (block.num_rows() == 1) {
+                auto view = m.get_view(block.begin, GetCSRRowViewTag{});
+                const float sum = team.parallel_reduce(view.num_non_zeros, [&](size_t k) {
+                    return view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+                }, 0.0f);
+                team.single([&] { yv.set_value_by_id(block.begin, sum); });
+            } else {
+                team.parallel_for(block.num_rows(), [&](size_t i) {
+                    auto view = m.get_view(block.begin + i, GetCSRRowViewTag{});
+                    float sum = 0;
+                    for (size_t k = 0; k < view.num_non_zeros; ++k) sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+                    yv.set_value_by_id(block.begin + i, sum);
+                });
+            }
+        },
+        mat, x_in, y_out);
+}
+
+template<typename F>
+static double best_of(int reps, F&& f) {
+    double best = 1e30;
+    for (int rep = 0; rep < reps; ++rep) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return best;
+}
+
+static void report(const std::string& name, double t, double base) {
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(9) << t * 1e3 << " ms (" << std::setprecision(2) << base / t << "x)"
+              << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 400000;
+    const size_t threads = static_cast<size_t>(omp_get_max_threads());
+    std::cout << "threads " << threads << std::endl;
+    struct Case {
+        const char* name;
+        size_t long_rows;
+        size_t long_nnz;
+    };
+    for (const Case& c : {Case{"uniform", 0, 0}, Case{"8 long rows", 8, n}, Case{"1 very long row", 1, 4 * n}}) {
+        const CSRMatrix a = make_skewed(n, 8, c.long_rows, c.long_nnz);
+        Vec x(std::vector<float>(n, 1.0f)), y(n);
+        std::cout << c.name << ": " << n << " rows, " << a.num_nonzeros() << " nnz" << std::endl;
+        const double base = best_of(5, [&] { spmv_rows(a, x, y, {}); });
+        report("rows, static", base, base);
+        report("rows, dynamic 64", best_of(5, [&] { spmv_rows(a, x, y, {ScheduleKind::Dynamic, 64}); }), base);
+        // 每块约为每线程平均非零元的1/16
+        const size_t target = std::max<size_t>(256, a.num_nonzeros() / (16 * threads));
+        const IterateOver::CSRRowBlocks blocks(a, target);
+        std::vector<size_t> team_sizes{1};
+        for (size_t t : {size_t{4}, threads})
+            if (t <= threads && t != team_sizes.back()) team_sizes.push_back(t);
+        for (size_t team_size : team_sizes) {
+            TeamPolicy policy{team_size, 0, 0, {ScheduleKind::Dynamic, 1}};
+            report("teams of " + std::to_string(team_size) + ", " + std::to_string(blocks.size()) + " blocks",
+                   best_of(5, [&] { spmv_team(a, x, y, policy, blocks); }), base);
+        }
+    }
+    return 0;
+}
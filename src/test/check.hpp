@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+/// @brief Test assertion that stays active under NDEBUG: prints the failed condition and exits with status 1
+#define CHECK(cond)                                                                              \
+    do {                                                                                         \
+        if (!(cond)) {                                                                           \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " << #cond << std::endl; \
+            std::exit(1);                                                                        \
+        }                                                                                        \
+    } while (0)
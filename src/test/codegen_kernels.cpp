@@ -0,0 +1,69 @@
+// test_codegen 的输入：只编译成汇编（-O3 -DNDEBUG -S），不链接
+// 每个 *_accessor 内核都有一个手写裸指针的 *_raw 对照，算法与循环形式相同
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <cstddef>
+
+using namespace accessor;
+using Vec = DenseArray1D<float>;
+
+extern "C" void codegen_saxpy_accessor(float a, const Vec* x, Vec* y) {
+    Accessor<Vec, AccessMode::Read> x_in(*x);
+    Accessor<Vec, AccessMode::ReadWrite> y_io(*y);
+    custom_parallel_for(IterateOver::Range1D(x->count),
+        [a](size_t i, const auto& xv, auto& yv) {
+            yv.set_value_by_id(i, a * xv.get_value_by_id(i) + yv.get_value_by_id(i));
+        },
+        x_in, y_io);
+}
+
+// 内核里通过 raw_data() 取指针
+extern "C" void codegen_saxpy_raw_data(float a, const Vec* x, Vec* y) {
+    Accessor<Vec, AccessMode::Read> x_in(*x);
+    Accessor<Vec, AccessMode::ReadWrite> y_io(*y);
+    custom_parallel_for(IterateOver::Range1D(x->count),
+        [a](size_t i, const auto& xv, auto& yv) {
+            const float* xp = xv.raw_data();
+            float* yp = yv.raw_data();
+            yp[i] = a * xp[i] + yp[i];
+        },
+        x_in, y_io);
+}
+
+extern "C" void codegen_saxpy_raw(float a, const float* x, float* y, size_t n) {
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) y[i] = a * x[i] + y[i];
+}
+
+extern "C" void codegen_spmv_accessor(const CSRMatrix* m, const Vec* x, Vec* y) {
+    Accessor<CSRMatrix, AccessMode::Read> mat(*m);
+    Accessor<Vec, AccessMode::Read> x_in(*x);
+    Accessor<Vec, AccessMode::Write> y_out(*y);
+    custom_parallel_for(IterateOver::CSRRows(*m),
+        [](size_t row, const auto& a, const auto& xv, auto& yv) {
+            auto view = a.get_view(row, GetCSRRowViewTag{});
+            float sum = 0;
+            for (size_t k = 0; k < view.num_non_zeros; ++k) sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+            yv.set_value_by_id(row, sum);
+        },
+        mat, x_in, y_out);
+}
+
+// 与行视图相同的形式：行首指针加非零元个数
+extern "C" void codegen_spmv_raw(const size_t* row_ptr, const size_t* cols, const float* vals,
+                                 const float* x, float* y, size_t n) {
+    #pragma omp parallel for
+    for (size_t row = 0; row < n; ++row) {
+        const size_t* row_cols = cols + row_ptr[row];
+        const float* row_vals = vals + row_ptr[row];
+        const size_t nnz = row_ptr[row + 1] - row_ptr[row];
+        float sum = 0;
+        for (size_t k = 0; k < nnz; ++k) sum += row_vals[k] * x[row_cols[k]];
+        y[row] = sum;
+    }
+}
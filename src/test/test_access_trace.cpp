@@ -0,0 +1,348 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/access_trace.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <omp.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+using IterateOver::Range1D;
+
+using Vec = DenseArray1D<float>;
+using ReadAcc = Accessor<Vec, AccessMode::Read>;
+using WriteAcc = Accessor<Vec, AccessMode::Write>;
+
+static Vec make_vector(size_t n) {
+    Vec v(n);
+    for (size_t i = 0; i < n; ++i) v.data[i] = static_cast<float>(i);
+    return v;
+}
+
+// y[i] = 2*x[i] + y[i]：同一下标读写，缓冲是多余的
+static const Vec* saxpy_target = nullptr;
+static auto saxpy_kernel = [](size_t i, const ReadAcc& x, const ReadAcc& y_in, WriteAcc& y_out) {
+    if (i == 0) saxpy_target = &y_out.data_ref;
+    y_out.set_value_by_id(i, 2.0f * x.get_value_by_id(i) + y_in.get_value_by_id(i));
+};
+
+void test_saxpy_footprint() {
+    const size_t n = 1000;
+    Vec x = make_vector(n), y = make_vector(n);
+    ReadAcc xa(x), ya(y);
+    WriteAcc yo(y);
+
+    AccessTraceSession session;
+    custom_parallel_for(Range1D(n), saxpy_kernel, xa, ya, yo);
+    CHECK(y.data[10] == 30.0f);
+
+    CHECK(session.loops().size() == 1);
+    const LoopTrace& loop = session.loops()[0];
+    CHECK(loop.iterations == n && loop.buffered && !loop.buffering_needed && !loop.truncated);
+    CHECK(loop.shared_written_ids == 0);
+    CHECK(loop.accessors.size() == 3);
+    const AccessorFootprint& fx = loop.accessors[0];
+    CHECK(fx.reads == n && fx.distinct_read_ids == n && fx.writes == 0);
+    CHECK(fx.pattern == AccessPattern::Sequential);
+    CHECK(!fx.buffered && loop.accessors[2].buffered);
+    CHECK(loop.accessors[2].writes == n && loop.accessors[2].distinct_write_ids == n);
+
+    std::ostringstream report;
+    session.print_report(report);
+    CHECK(report.str().find("buffering needed no") != std::string::npos);
+    std::cout << "SAXPY footprint test passed!" << std::endl;
+}
+
+void test_shift_needs_buffering() {
+    const size_t n = 500;
+    Vec y = make_vector(n);
+    ReadAcc in(y);
+    WriteAcc out(y);
+
+    AccessTraceSession session;
+    custom_parallel_for(Range1D(n - 2),
+        [](size_t i, const ReadAcc& a, WriteAcc& b) {
+            b.set_value_by_id(i + 1, a.get_value_by_id(i) + a.get_value_by_id(i + 2));
+        },
+        in, out);
+    const LoopTrace& loop = session.loops()[0];
+    CHECK(loop.buffered && loop.buffering_needed);
+    // 读取步长交替为 +2/-1
+    CHECK(loop.accessors[0].pattern == AccessPattern::Strided);
+    CHECK(loop.accessors[0].reads == 2 * (n - 2) && loop.accessors[0].distinct_read_ids == n);
+    std::cout << "Shift stencil buffering test passed!" << std::endl;
+}
+
+void test_patterns() {
+    const size_t n = 4096;
+    Vec src = make_vector(n), dst(n);
+    ReadAcc s(src);
+    WriteAcc d(dst);
+
+    AccessTraceSession session;
+    custom_parallel_for(Range1D(n / 8),
+        [](size_t i, const ReadAcc& a, WriteAcc& b) { b.set_value_by_id(i, a.get_value_by_id(i * 8)); },
+        s, d);
+    std::vector<size_t> perm(n);
+    std::iota(perm.begin(), perm.end(), size_t{0});
+    std::shuffle(perm.begin(), perm.end(), std::mt19937(42));
+    custom_parallel_for(Range1D(n),
+        [&perm](size_t i, const ReadAcc& a, WriteAcc& b) { b.set_value_by_id(i, a.get_value_by_id(perm[i])); },
+        s, d);
+    CHECK(session.loops().size() == 2);
+    const LoopTrace& strided = session.loops()[0];
+    const LoopTrace& gather = session.loops()[1];
+    CHECK(!strided.buffered && !strided.buffering_needed);
+    CHECK(strided.accessors[0].pattern == AccessPattern::Strided);
+    CHECK(strided.accessors[0].stride_histogram.count(8) == 1);
+    CHECK(strided.accessors[1].pattern == AccessPattern::Sequential);
+    CHECK(gather.accessors[0].pattern == AccessPattern::Random);
+
+    // 会话之外的访问不记录
+    ReadAcc outside(src);
+    (void)outside.get_value_by_id(3);
+    CHECK(session.loops().size() == 2);
+    std::cout << "Access pattern test passed!" << std::endl;
+}
+
+// 同一个调用点：样本运行与之后的运行都经过这里
+static void saxpy_site(ReadAcc& xa, ReadAcc& ya, WriteAcc& yo) {
+    custom_parallel_for(ExecutionContext{}, Range1D(xa.data_ref.count), saxpy_kernel, xa, ya, yo);
+}
+
+// 具名函数对象：类型相同，是否需要缓冲取决于调用点传入的偏移
+struct ShiftedCopy {
+    size_t offset;
+    void operator()(size_t i, const ReadAcc& in, WriteAcc& out) const {
+        out.set_value_by_id(i + offset, in.get_value_by_id(i));
+    }
+};
+
+// 调用点是调用者构造上下文的位置
+static void shifted_copy(const ExecutionContext& ctx, Vec& y, size_t offset) {
+    ReadAcc in(y);
+    WriteAcc out(y);
+    custom_parallel_for(ctx, Range1D(y.count - offset), ShiftedCopy{offset}, in, out);
+}
+
+void test_buffering_hints() {
+    const size_t n = 256;
+    const std::string path = "test_access_trace_hints.txt";
+    BufferingHints::global().clear();
+
+    {
+        Vec x = make_vector(n), y = make_vector(n);
+        ReadAcc xa(x), ya(y);
+        WriteAcc yo(y);
+        AccessTraceSession session;
+        saxpy_site(xa, ya, yo);
+        // 不带上下文的调用没有调用点，不记录提示
+        custom_parallel_for(Range1D(n), saxpy_kernel, xa, ya, yo);
+        CHECK(session.loops().size() == 2);
+        BufferingHints recorded;
+        session.record_hints(recorded);
+        CHECK(recorded.size() == 1);
+        CHECK(recorded.save(path));
+    }
+
+    // 新的一次运行：加载提示后同一调用点直接写原数组
+    CHECK(BufferingHints::global().load(path));
+    Vec x = make_vector(n), y = make_vector(n);
+    ReadAcc xa(x), ya(y);
+    WriteAcc yo(y);
+    saxpy_site(xa, ya, yo);
+    CHECK(saxpy_target == &y);
+    CHECK(y.data[7] == 2.0f * 7 + 7.0f);
+
+    // 同一 kernel 的其他调用点没有样本，仍然缓冲
+    custom_parallel_for(ExecutionContext{}, Range1D(n), saxpy_kernel, xa, ya, yo);
+    CHECK(saxpy_target != &y);
+    custom_parallel_for(Range1D(n), saxpy_kernel, xa, ya, yo);
+    CHECK(saxpy_target != &y);
+    CHECK(y.data[7] == 3 * 2.0f * 7 + 7.0f);
+
+    // 需要缓冲的结论不会被之后的样本覆盖
+    BufferingHints hints;
+    hints.set("site", true);
+    hints.set("site", false);
+    CHECK(!hints.can_skip("site") && !hints.can_skip("unknown"));
+
+    BufferingHints::global().clear();
+    std::remove(path.c_str());
+    std::cout << "Buffering hints test passed!" << std::endl;
+}
+
+void test_hints_per_call_site() {
+    const size_t n = 512;
+    BufferingHints::global().clear();
+    {
+        // 偏移 0 的调用点：样本显示缓冲多余
+        Vec y = make_vector(n);
+        AccessTraceSession session;
+        shifted_copy(ExecutionContext{}, y, 0);
+        CHECK(!session.loops()[0].buffering_needed);
+        session.record_hints();
+        CHECK(BufferingHints::global().size() == 1);
+    }
+    // 类型与别名关系相同、但从未采样的调用点读到别的迭代写的值，必须保留缓冲
+    Vec y = make_vector(n);
+    shifted_copy(ExecutionContext{}, y, 1);
+    for (size_t i = 0; i + 1 < n; ++i) CHECK(y.data[i + 1] == static_cast<float>(i));
+    BufferingHints::global().clear();
+    std::cout << "Per-call-site hints test passed!" << std::endl;
+}
+
+// 同一迭代先写后读：缓冲时读到旧值
+static auto rewrite_kernel = [](size_t i, const ReadAcc& in, WriteAcc& out) {
+    out.set_value_by_id(i, 100.0f);
+    out.set_value_by_id(i, in.get_value_by_id(i) + 1.0f);
+};
+// 迭代0写下标0，迭代1读取并重写它：最后写者与读者是同一迭代
+static auto handoff_kernel = [](size_t i, const ReadAcc& in, WriteAcc& out) {
+    if (i == 0) out.set_value_by_id(0, 5.0f);
+    if (i == 1) out.set_value_by_id(0, in.get_value_by_id(0) + 1.0f);
+};
+
+template<typename Kernel>
+static void run_two_iterations(const Kernel& kernel, Vec& y) {
+    const LoopSchedule one_chunk{ScheduleKind::Static, 2};   // 两个迭代按顺序在同一线程执行
+    ReadAcc in(y);
+    WriteAcc out(y);
+    custom_parallel_for(ExecutionContext{}, one_chunk, Range1D(2), kernel, in, out);
+}
+
+template<typename Kernel>
+static float run_with_recorded_hints(const Kernel& kernel) {
+    BufferingHints::global().clear();
+    {
+        Vec y = make_vector(4);
+        AccessTraceSession session;
+        run_two_iterations(kernel, y);
+        CHECK(y.data[0] == 1.0f);
+        const LoopTrace& loop = session.loops()[0];
+        CHECK(loop.buffered && loop.buffering_needed);
+        session.record_hints();
+        CHECK(BufferingHints::global().size() == 1);
+    }
+    // 提示不允许跳过缓冲，结果保持不变
+    Vec y = make_vector(4);
+    run_two_iterations(kernel, y);
+    BufferingHints::global().clear();
+    return y.data[0];
+}
+
+void test_same_iteration_hazards() {
+    CHECK(run_with_recorded_hints(rewrite_kernel) == 1.0f);
+    CHECK(run_with_recorded_hints(handoff_kernel) == 1.0f);
+    std::cout << "Same-iteration hazard test passed!" << std::endl;
+}
+
+void test_raw_pointer_opaque() {
+    const size_t n = 128;
+    Vec x = make_vector(n), y = make_vector(n);
+    ReadAcc xa(x), ya(y);
+    WriteAcc yo(y);
+    AccessTraceSession session;
+    auto kernel = [](size_t i, const ReadAcc& a, const ReadAcc& b, WriteAcc& c) {
+        c.raw_data()[i] = 2.0f * a.get_value_by_id(i) + b.get_value_by_id(i);
+    };
+    custom_parallel_for(ExecutionContext{}, Range1D(n), kernel, xa, ya, yo);
+    CHECK(y.data[5] == 15.0f);
+
+    // 裸指针写入看不到，样本不能证明缓冲多余
+    const LoopTrace& loop = session.loops()[0];
+    CHECK(loop.opaque && loop.accessors[2].writes == 0);
+    BufferingHints recorded;
+    session.record_hints(recorded);
+    CHECK(recorded.size() == 1);
+    CHECK(recorded.save("test_access_trace_opaque.txt"));
+    std::ifstream saved("test_access_trace_opaque.txt");
+    std::string line;
+    std::getline(saved, line);
+    std::getline(saved, line);
+    CHECK(line.rfind("1 ", 0) == 0);
+    std::remove("test_access_trace_opaque.txt");
+    std::ostringstream report;
+    session.print_report(report);
+    CHECK(report.str().find("partly unseen") != std::string::npos);
+    std::cout << "Raw pointer opaque test passed!" << std::endl;
+}
+
+// 外层迭代把读访问器交给内层循环：内层循环不单独追踪，其访问计入外层迭代
+static void run_nested_sums(const ReadAcc& xa, WriteAcc& yo) {
+    custom_parallel_for(Range1D(xa.data_ref.count),
+        [](size_t i, const ReadAcc& a, WriteAcc& b) {
+            float sum = 0.0f;
+            ReadAcc inner = a;
+            custom_parallel_for(Range1D(a.data_ref.count),
+                [&sum](size_t j, const ReadAcc& r) {
+                    const float v = r.get_value_by_id(j);
+                    #pragma omp atomic
+                    sum += v;
+                },
+                inner);
+            b.set_value_by_id(i, sum);
+        },
+        xa, yo);
+}
+
+void test_nested_loop() {
+    const size_t n = 64;
+    Vec x = make_vector(n), y(n);
+    ReadAcc xa(x);
+    WriteAcc yo(y);
+    const int saved_levels = omp_get_max_active_levels();
+    const int saved_threads = omp_get_max_threads();
+
+    // 内层并行区域不活跃：由外层线程独自执行，照常记录
+    omp_set_max_active_levels(1);
+    {
+        AccessTraceSession session;
+        run_nested_sums(xa, yo);
+        CHECK(session.loops().size() == 1);
+        const LoopTrace& loop = session.loops()[0];
+        CHECK(!loop.opaque && !loop.buffering_needed);
+        CHECK(loop.accessors[0].reads == n * n && loop.accessors[0].distinct_read_ids == n);
+        CHECK(loop.accessors[1].writes == n);
+    }
+    for (size_t i = 0; i < n; ++i) CHECK(y.data[i] == static_cast<float>(n * (n - 1) / 2));
+
+    // 活跃的内层区域多个线程共用一份日志，访问不记录，样本视为不透明
+    omp_set_max_active_levels(2);
+    omp_set_num_threads(std::max(saved_threads, 2));
+    {
+        AccessTraceSession session;
+        run_nested_sums(xa, yo);
+        const LoopTrace& loop = session.loops()[0];
+        CHECK(loop.opaque && loop.accessors[1].writes == n);
+    }
+    for (size_t i = 0; i < n; ++i) CHECK(y.data[i] == static_cast<float>(n * (n - 1) / 2));
+    omp_set_max_active_levels(saved_levels);
+    omp_set_num_threads(saved_threads);
+    std::cout << "Nested loop trace test passed!" << std::endl;
+}
+
+int main() {
+    if (!AccessTraceSession::enabled()) {
+        std::cout << "Access tracing compiled out, skipping" << std::endl;
+        return 0;
+    }
+    test_saxpy_footprint();
+    test_shift_needs_buffering();
+    test_patterns();
+    test_buffering_hints();
+    test_hints_per_call_site();
+    test_same_iteration_hazards();
+    test_raw_pointer_opaque();
+    test_nested_loop();
+    return 0;
+}
@@ -1,8 +1,19 @@
 #include <accessor/core/accessor.hpp>
+#include <accessor/core/concepts.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/iteration/frontier_vertices.hpp>
+#include <accessor/iteration/masked.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/iteration/tiled.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_fixed_traits.hpp>
 #include <accessor/traits/dense_array_traits.hpp>
-#include <cassert>
 #include <iostream>
+#include <type_traits>
+#include <vector>
 #include <accessor/core/custom_parallel_for.hpp>
+#include "check.hpp"
 
 using namespace accessor;
 
@@ -20,22 +31,22 @@ void test_dense_array_accessor() {
 
     // Test read access
     for (size_t i = 0; i < arr.size(); ++i) {
-        assert(read_acc.get_value_by_id(i) == static_cast<float>(i));
+        CHECK(read_acc.get_value_by_id(i) == static_cast<float>(i));
     }
 
     // Test write access
     write_acc.set_value_by_id(2, 42.0f);
-    assert(arr[2] == 42.0f);
+    CHECK(arr[2] == 42.0f);
 
     // Test read-write access
     float val = rw_acc.get_value_by_id(3);
     rw_acc.set_value_by_id(3, val * 2.0f);
-    assert(arr[3] == 6.0f);  // 3 * 2 = 6
+    CHECK(arr[3] == 6.0f);  // 3 * 2 = 6
 
     // Test iteration support
-    assert(DataStructureTraits<DenseArray1D<float>>::get_size_for_iteration(arr, IterateOverAll_Tag{}) == 5);
+    CHECK(DataStructureTraits<DenseArray1D<float>>::get_size_for_iteration(arr, IterateOverAll_Tag{}) == 5);
     for (size_t i = 0; i < arr.size(); ++i) {
-        assert(DataStructureTraits<DenseArray1D<float>>::get_item_id_from_global_index(
+        CHECK(DataStructureTraits<DenseArray1D<float>>::get_item_id_from_global_index(
             arr, i, IterateOverAll_Tag{}) == i);
     }
 
@@ -241,6 +252,47 @@ void test_nested_parallel_for() {
     if (valid) std::cout << "Nested parallel for test passed!" << std::endl;
 }
 
+// 库中的迭代空间都满足完整接口，测试里的最小范围类型只满足 IterationSpace
+struct MinimalRange {
+    size_t size() const { return 1; }
+    size_t operator[](size_t idx) const { return idx; }
+};
+static_assert(DeviceIterationSpace<IterateOver::Range1D> && DeviceIterationSpace<IterateOver::StaticRange<4>>);
+static_assert(DeviceIterationSpace<IterateOver::CSRRows> && DeviceIterationSpace<IterateOver::FrontierVertices>);
+static_assert(DeviceIterationSpace<IterateOver::IndexList<>> && DeviceIterationSpace<IterateOver::Masked<IterateOver::Range1D>>);
+static_assert(DeviceIterationSpace<IterateOver::Tiled<2>>);
+static_assert(IterationSpace<MinimalRange> && !DeviceIterationSpace<MinimalRange> && !IterationSpace<int>);
+static_assert(ValueReadableStructure<DenseArray1D<float>> && ValueWritableStructure<DenseArray1D<float>>);
+static_assert(ContiguousStructure<DenseArray1D<float>> && ContiguousStructure<std::vector<int>>);
+static_assert(ContiguousStructure<DenseArrayFixed<double, 3>>);
+static_assert(!ContiguousStructure<DenseArray1D<float, double>> && !ContiguousStructure<std::vector<bool>>);
+static_assert(HasDataStructureTraits<CSRMatrix> && !ContiguousStructure<CSRMatrix> && !HasDataStructureTraits<int>);
+
+void test_raw_data() {
+    const size_t N = 64;
+    DenseArray1D<float> X(N), Y(N);
+    for (size_t i = 0; i < N; ++i) {
+        X[i] = float(i);
+        Y[i] = 1.0f;
+    }
+    Accessor<DenseArray1D<float>, AccessMode::Read> x_acc(X);
+    Accessor<DenseArray1D<float>, AccessMode::ReadWrite> y_acc(Y);
+    static_assert(std::is_same_v<decltype(x_acc.raw_data()), const float*>);
+    static_assert(std::is_same_v<decltype(y_acc.raw_data()), float*>);
+    CHECK(x_acc.raw_data() == X.data.data());
+
+    // 内核中用裸指针写内层循环
+    const float a = 2.0f;
+    accessor::custom_parallel_for(IterateOver::Range1D(N),
+        [a](size_t i, const auto& x, auto& y) {
+            float* y_ptr = y.raw_data();
+            y_ptr[i] = a * x.raw_data()[i] + y_ptr[i];
+        },
+        x_acc, y_acc);
+    for (size_t i = 0; i < N; ++i) CHECK(Y[i] == a * float(i) + 1.0f);
+    std::cout << "Raw data test passed!" << std::endl;
+}
+
 int main() {
     test_dense_array_accessor();
     test_saxpy_auto_buffer();
@@ -248,5 +300,6 @@ int main() {
     test_mixed_data_structures();
     test_read_write_mixed_modes();
     test_nested_parallel_for();
+    test_raw_data();
     return 0;
 }
@@ -0,0 +1,148 @@
+// 检查 codegen_kernels.cpp 生成的汇编：访问器内核的最内层循环与裸指针版本逐条指令一致
+// 用法: test_codegen <codegen_kernels.s>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+using Lines = std::vector<std::string>;
+
+static std::string trim(const std::string& s) {
+    const size_t b = s.find_first_not_of(" \t");
+    if (b == std::string::npos) return "";
+    return s.substr(b, s.find_last_not_of(" \t") + 1 - b);
+}
+
+static bool is_label(const std::string& line) { return !line.empty() && line.back() == ':'; }
+
+// 读入汇编，只保留标号与指令（去掉 .cfi/.p2align 等伪指令和注释）
+static Lines read_assembly(const std::string& path) {
+    std::ifstream in(path);
+    Lines lines;
+    if (!in) {
+        std::cerr << "cannot open assembly file " << path << std::endl;
+        return lines;
+    }
+    std::string raw;
+    while (std::getline(in, raw)) {
+        std::string line = trim(raw.substr(0, raw.find('#')));
+        if (line.empty()) continue;
+        if (line[0] == '.' && !is_label(line) && line.rfind(".size", 0) != 0) continue;
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// 名字满足 pred 的各个函数体（标号行到 .size 行之间）
+template<typename Pred>
+static std::vector<Lines> functions_where(const Lines& lines, Pred pred) {
+    std::vector<Lines> out;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (!is_label(lines[i]) || lines[i][0] == '.') continue;
+        const std::string name = lines[i].substr(0, lines[i].size() - 1);
+        if (!pred(name)) continue;
+        Lines body;
+        for (size_t j = i + 1; j < lines.size() && lines[j].rfind(".size", 0) != 0; ++j) body.push_back(lines[j]);
+        out.push_back(body);
+    }
+    return out;
+}
+
+// 寄存器按首次出现顺序重命名，标号统一，使比较与寄存器分配无关
+static std::string normalize(const std::string& insn, std::map<std::string, std::string>& regs) {
+    static const std::regex reg_re("%[a-z0-9]+");
+    static const std::regex label_re("\\.L[0-9]+");
+    std::string out;
+    auto begin = std::sregex_iterator(insn.begin(), insn.end(), reg_re);
+    size_t last = 0;
+    for (auto it = begin; it != std::sregex_iterator(); ++it) {
+        out += insn.substr(last, it->position() - last);
+        auto [pos, inserted] = regs.try_emplace(it->str(), "%r" + std::to_string(regs.size()));
+        out += pos->second;
+        last = it->position() + it->length();
+    }
+    out += insn.substr(last);
+    std::string compact;
+    for (char c : std::regex_replace(out, label_re, ".L")) {
+        if (c == '\t') c = ' ';
+        if (c != ' ' || (!compact.empty() && compact.back() != ' ')) compact += c;
+    }
+    return compact;
+}
+
+// 最内层循环：标号到跳回它的指令之间没有其他标号
+static std::vector<std::string> innermost_loops(const Lines& body) {
+    std::vector<std::string> loops;
+    for (size_t i = 0; i < body.size(); ++i) {
+        if (!is_label(body[i])) continue;
+        const std::string label = body[i].substr(0, body[i].size() - 1);
+        for (size_t j = i + 1; j < body.size() && !is_label(body[j]); ++j) {
+            const std::string& insn = body[j];
+            if (insn[0] != 'j' || insn.size() < label.size() ||
+                insn.compare(insn.size() - label.size(), label.size(), label) != 0) continue;
+            std::map<std::string, std::string> regs;
+            std::string loop;
+            for (size_t k = i + 1; k <= j; ++k) loop += normalize(body[k], regs) + "\n";
+            loops.push_back(loop);
+            break;
+        }
+    }
+    std::sort(loops.begin(), loops.end());
+    return loops;
+}
+
+static void print_loops(const char* what, const std::vector<std::string>& loops) {
+    std::cerr << what << ":\n";
+    for (const auto& l : loops) std::cerr << l << "--\n";
+}
+
+// accessor_fn 经 custom_parallel_for 直接执行路径、默认调度生成的并行区域
+// （该函数的第一个 omp 区域 _omp_fn.0），其最内层循环要与 raw_fn 的并行区域相同
+static bool check_kernel(const Lines& lines, const std::string& accessor_fn, const std::string& raw_fn) {
+    const std::string mangled = std::to_string(accessor_fn.size()) + accessor_fn;
+    auto raw = functions_where(lines, [&](const std::string& n) { return n == raw_fn + "._omp_fn.0"; });
+    auto acc = functions_where(lines, [&](const std::string& n) {
+        return n.find("execute_parallel_kernel_directly") != std::string::npos &&
+               n.find(mangled) != std::string::npos && n.ends_with("._omp_fn.0");
+    });
+    if (raw.size() != 1 || acc.size() != 1) {
+        std::cerr << accessor_fn << ": found " << acc.size() << " accessor region(s) and " << raw.size() << " "
+                  << raw_fn << " region(s), expected one of each" << std::endl;
+        return false;
+    }
+    const auto expected = innermost_loops(raw[0]);
+    if (expected.empty()) {
+        std::cerr << raw_fn << ": no inner loop found" << std::endl;
+        return false;
+    }
+    const auto loops = innermost_loops(acc[0]);
+    if (loops != expected) {
+        std::cerr << accessor_fn << ": inner loops differ from " << raw_fn << std::endl;
+        print_loops(raw_fn.c_str(), expected);
+        print_loops(accessor_fn.c_str(), loops);
+        return false;
+    }
+    std::cout << accessor_fn << ": " << expected.size() << " inner loop(s) match " << raw_fn << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <codegen_kernels.s>" << std::endl;
+        return 1;
+    }
+    const Lines lines = read_assembly(argv[1]);
+    if (lines.empty()) return 1;
+    bool valid = check_kernel(lines, "codegen_saxpy_accessor", "codegen_saxpy_raw");
+    valid &= check_kernel(lines, "codegen_saxpy_raw_data", "codegen_saxpy_raw");
+    valid &= check_kernel(lines, "codegen_spmv_accessor", "codegen_spmv_raw");
+    if (!valid) {
+        std::cerr << "Codegen test failed" << std::endl;
+        return 1;
+    }
+    std::cout << "Codegen test passed!" << std::endl;
+    return 0;
+}
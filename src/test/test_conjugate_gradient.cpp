@@ -0,0 +1,169 @@
+#include <accessor/algorithms/conjugate_gradient.hpp>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<double>;
+using Vec = DenseArray1D<double>;
+
+// 2D 五点 Poisson 矩阵，行缩放 D A D（scale 非空时）使对角线变化很大
+static Matrix poisson_2d(size_t n, const std::vector<double>* scale = nullptr) {
+    Matrix a;
+    a.row_ptr.push_back(0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const size_t row = i * n + j;
+            auto add = [&](size_t col, double v) {
+                if (scale) v *= (*scale)[row] * (*scale)[col];
+                a.col_indices.push_back(col);
+                a.values.push_back(v);
+            };
+            if (i > 0) add(row - n, -1.0);
+            if (j > 0) add(row - 1, -1.0);
+            add(row, 4.0);
+            if (j + 1 < n) add(row + 1, -1.0);
+            if (i + 1 < n) add(row + n, -1.0);
+            a.row_ptr.push_back(a.col_indices.size());
+        }
+    }
+    return a;
+}
+
+static Vec multiply(const Matrix& a, const Vec& x) {
+    Vec y(a.num_rows());
+    for (size_t r = 0; r < a.num_rows(); ++r)
+        for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) y.data[r] += a.values[k] * x.data[a.col_indices[k]];
+    return y;
+}
+
+static double max_error(const Vec& x, const Vec& ref) {
+    double e = 0;
+    for (size_t i = 0; i < x.size(); ++i) e = std::max(e, std::abs(x.data[i] - ref.data[i]));
+    return e;
+}
+
+void test_cg_variants() {
+    const size_t n = 24;
+    Matrix a = poisson_2d(n);
+    Vec x_true(n * n);
+    for (size_t i = 0; i < x_true.size(); ++i) x_true.data[i] = std::sin(0.1 * static_cast<double>(i));
+    Vec b = multiply(a, x_true);
+
+    for (CGVariant variant : {CGVariant::Standard, CGVariant::Pipelined}) {
+        for (CGPreconditioner pre : {CGPreconditioner::None, CGPreconditioner::Jacobi}) {
+            CGOptions opts;
+            opts.variant = variant;
+            opts.preconditioner = pre;
+            opts.tolerance = 1e-10;
+            Vec x(n * n);
+            CGResult res = conjugate_gradient(a, b, x, opts);
+            if (!res.converged || max_error(x, x_true) > 1e-7) {
+                std::cerr << "CG failed: variant " << static_cast<int>(variant) << " iterations " << res.iterations
+                          << " residual " << res.relative_residual << " error " << max_error(x, x_true) << std::endl;
+                CHECK(false);
+            }
+            CHECK(res.iterations > 10 && res.iterations < n * n);
+        }
+    }
+    std::cout << "CG variants test passed!" << std::endl;
+}
+
+void test_jacobi_helps_scaled_matrix() {
+    const size_t n = 16;
+    std::vector<double> scale(n * n);
+    for (size_t i = 0; i < scale.size(); ++i) scale[i] = std::pow(10.0, static_cast<double>(i % 7) / 2.0);
+    Matrix a = poisson_2d(n, &scale);
+    Vec x_true(n * n);
+    for (size_t i = 0; i < x_true.size(); ++i) x_true.data[i] = 1.0 + static_cast<double>(i % 3);
+    Vec b = multiply(a, x_true);
+
+    CGOptions opts;
+    opts.tolerance = 1e-10;
+    opts.max_iterations = 5000;
+    Vec x_jacobi(n * n), x_plain(n * n);
+    CGResult jacobi = conjugate_gradient(a, b, x_jacobi, opts);
+    opts.preconditioner = CGPreconditioner::None;
+    CGResult plain = conjugate_gradient(a, b, x_plain, opts);
+    CHECK(jacobi.converged);
+    CHECK(jacobi.iterations * 3 < plain.iterations);
+    std::cout << "Jacobi preconditioner test passed!" << std::endl;
+}
+
+void test_solver_reuse_and_limits() {
+    const size_t n = 12;
+    Matrix a = poisson_2d(n);
+    CGOptions opts;
+    opts.tolerance = 1e-12;
+    ConjugateGradient<double, double> solver(a, opts);
+
+    // 零右端项直接返回零解
+    Vec zero(n * n), x(n * n);
+    x.data.assign(n * n, 3.0);
+    CGResult res = solver.solve(zero, x);
+    CHECK(res.converged && res.iterations == 0 && x.data[5] == 0.0);
+
+    // 同一求解器多次求解；迭代上限生效
+    Vec b(n * n);
+    b.data.assign(n * n, 1.0);
+    Vec x1(n * n), x2(n * n);
+    CGResult full = solver.solve(b, x1);
+    solver.options().max_iterations = 3;
+    CGResult limited = solver.solve(b, x2);
+    CHECK(full.converged && !limited.converged && limited.iterations == 3);
+
+    // 从已收敛的解出发不需要迭代
+    solver.options().max_iterations = 1000;
+    solver.options().tolerance = 1e-8;
+    CHECK(solver.solve(b, x1).iterations == 0);
+
+    // 零对角线无法使用 Jacobi
+    Matrix bad = a;
+    for (size_t k = bad.row_ptr[4]; k < bad.row_ptr[5]; ++k) {
+        if (bad.col_indices[k] == 4) bad.values[k] = 0.0;
+    }
+    bool threw = false;
+    try {
+        ConjugateGradient<double, double> s(bad);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::cout << "Solver reuse and limits test passed!" << std::endl;
+}
+
+void test_reproducible_solve() {
+    const size_t n = 40;
+    Matrix a = poisson_2d(n);
+    Vec b(n * n);
+    for (size_t i = 0; i < b.size(); ++i) b.data[i] = std::cos(static_cast<double>(i));
+    CGOptions opts;
+    opts.reproducible = true;
+    opts.max_iterations = 50;
+
+    const int saved = omp_get_max_threads();
+    std::vector<Vec> solutions;
+    for (int threads : {1, 3, 4}) {
+        omp_set_num_threads(threads);
+        Vec x(n * n);
+        conjugate_gradient(a, b, x, opts);
+        solutions.push_back(x);
+    }
+    omp_set_num_threads(saved);
+    for (const Vec& x : solutions) {
+        CHECK(std::memcmp(x.data.data(), solutions[0].data.data(), x.size() * sizeof(double)) == 0);
+    }
+    std::cout << "Reproducible CG test passed!" << std::endl;
+}
+
+int main() {
+    test_cg_variants();
+    test_jacobi_helps_scaled_matrix();
+    test_solver_reuse_and_limits();
+    test_reproducible_solve();
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <accessor/core/coo_matrix.hpp>
+#include <accessor/core/csr_builder.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+void test_coo_to_csr_small() {
+    // [1 0 2]
+    // [0 0 0]
+    // [3 4 0]
+    // 乱序且含重复: (0,2)=0.5+1.5, (2,0)=1+2
+    COOMatrix coo;
+    coo.num_rows = 3;
+    coo.num_cols = 3;
+    coo.add(2, 1, 4.0f);
+    coo.add(0, 2, 0.5f);
+    coo.add(2, 0, 1.0f);
+    coo.add(0, 0, 1.0f);
+    coo.add(0, 2, 1.5f);
+    coo.add(2, 0, 2.0f);
+
+    CSRMatrix mat = coo_to_csr(coo);
+    CHECK((mat.row_ptr == std::vector<size_t>{0, 2, 2, 4}));
+    CHECK((mat.col_indices == std::vector<size_t>{0, 2, 0, 1}));
+    CHECK((mat.values == std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f}));
+    std::cout << "COO to CSR small test passed!" << std::endl;
+}
+
+void test_coo_to_csr_random_with_reuse() {
+    const size_t N = 500, M = 300, T = 20000;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> row_dist(0, N - 1), col_dist(0, M - 1);
+    std::uniform_int_distribution<int> val_dist(-4, 4);
+
+    COOMatrix coo;
+    coo.num_rows = N;
+    coo.num_cols = M;
+    std::map<std::pair<size_t, size_t>, float> expected;
+    for (size_t k = 0; k < T; ++k) {
+        size_t r = row_dist(rng), c = col_dist(rng) % 40;  // 少量列，制造大量重复
+        float v = static_cast<float>(val_dist(rng));
+        coo.add(r, c, v);
+        expected[{r, c}] += v;
+    }
+
+    CSRAssemblyPattern pattern;
+    CSRMatrix mat = coo_to_csr(coo, pattern);
+    CHECK(mat.num_rows() == N);
+    CHECK(mat.num_nonzeros() == expected.size());
+
+    auto check = [&](const CSRMatrix& m, float scale) {
+        size_t j = 0;
+        for (auto& [rc, v] : expected) {
+            if (m.col_indices[j] != rc.second || m.values[j] != scale * v) return false;
+            if (!(m.row_ptr[rc.first] <= j && j < m.row_ptr[rc.first + 1])) return false;
+            ++j;
+        }
+        return true;
+    };
+    bool valid = check(mat, 1.0f);
+
+    // 相同结构、新值：只重跑数值阶段
+    for (float& v : coo.values) v *= 2.0f;
+    assemble_csr_values(coo, pattern, mat);
+    valid = valid && check(mat, 2.0f);
+
+    if (valid) {
+        std::cout << "COO to CSR random/reuse test passed!" << std::endl;
+    } else {
+        std::cerr << "COO to CSR random/reuse test failed" << std::endl;
+        std::exit(1);
+    }
+}
+
+void test_coo_to_csr_empty() {
+    COOMatrix coo;
+    coo.num_rows = 4;
+    coo.num_cols = 4;
+    CSRMatrix mat = coo_to_csr(coo);
+    CHECK(mat.num_rows() == 4 && mat.num_nonzeros() == 0);
+    CHECK((mat.row_ptr == std::vector<size_t>{0, 0, 0, 0, 0}));
+    std::cout << "COO to CSR empty test passed!" << std::endl;
+}
+
+static COOMatrix permutation_coo(size_t n, bool anti_diagonal) {
+    COOMatrix coo;
+    coo.num_rows = n;
+    coo.num_cols = n;
+    for (size_t r = 0; r < n; ++r) {
+        coo.row_indices.push_back(r);
+        coo.col_indices.push_back(anti_diagonal ? n - 1 - r : r);
+        coo.values.push_back(static_cast<float>(r + 1));
+    }
+    return coo;
+}
+
+void test_assemble_into_other_structure() {
+    // 行数与非零元数相同但结构不同：输出结构必须换成模式的结构
+    CSRMatrix mat = coo_to_csr(permutation_coo(2, false));
+    CSRAssemblyPattern anti;
+    const COOMatrix anti_coo = permutation_coo(2, true);
+    coo_to_csr(anti_coo, anti);
+    assemble_csr_values(anti_coo, anti, mat);
+    CHECK((mat.col_indices == std::vector<size_t>{1, 0}));
+    CHECK((mat.values == std::vector<float>{1.0f, 2.0f}));
+
+    // 三元组数与模式不符时报错
+    COOMatrix shorter = anti_coo;
+    shorter.row_indices.pop_back();
+    shorter.col_indices.pop_back();
+    shorter.values.pop_back();
+    bool threw = false;
+    try {
+        assemble_csr_values(shorter, anti, mat);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::cout << "COO to CSR pattern mismatch test passed!" << std::endl;
+}
+
+int main() {
+    test_coo_to_csr_small();
+    test_coo_to_csr_random_with_reuse();
+    test_coo_to_csr_empty();
+    test_assemble_into_other_structure();
+    return 0;
+}
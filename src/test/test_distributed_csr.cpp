@@ -0,0 +1,203 @@
+#include <accessor/distributed/distributed_csr.hpp>
+#include <accessor/distributed/shm_transport.hpp>
+#ifdef ACCESSOR_WITH_MPI
+#include <accessor/distributed/mpi_transport.hpp>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<double>;
+
+// 2D 五点 Poisson 矩阵
+static Matrix poisson_2d(size_t n) {
+    Matrix a;
+    a.row_ptr.push_back(0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const size_t row = i * n + j;
+            auto add = [&](size_t col, double v) {
+                a.col_indices.push_back(col);
+                a.values.push_back(v);
+            };
+            if (i > 0) add(row - n, -1.0);
+            if (j > 0) add(row - 1, -1.0);
+            add(row, 4.0);
+            if (j + 1 < n) add(row + 1, -1.0);
+            if (i + 1 < n) add(row + n, -1.0);
+            a.row_ptr.push_back(a.col_indices.size());
+        }
+    }
+    return a;
+}
+
+// 非对称随机矩阵，列号任意，固定种子使各进程得到同一矩阵
+static Matrix random_matrix(size_t n, size_t per_row) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> col(0, n - 1);
+    std::uniform_real_distribution<double> val(-1.0, 1.0);
+    Matrix a;
+    a.row_ptr.push_back(0);
+    for (size_t r = 0; r < n; ++r) {
+        std::vector<size_t> cols;
+        for (size_t k = 0; k < per_row; ++k) cols.push_back(col(rng));
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        for (size_t c : cols) {
+            a.col_indices.push_back(c);
+            a.values.push_back(val(rng));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+static double x_of(size_t global) { return std::sin(0.01 * static_cast<double>(global)) + 1.0; }
+
+// 每个进程检查自己那一块 y 与串行结果一致
+static int check_spmv(Transport& t, const Matrix& global) {
+    const RowPartition part = RowPartition::uniform(global.num_rows(), t.size());
+    auto a = DistributedCSRMatrix<double, double>::from_global(t, part, global);
+    CHECK(a.interior_rows().size() + a.boundary_rows().size() == a.local_rows());
+    for (size_t g : a.ghost_columns()) CHECK(part.owner(g) != t.rank());
+
+    // 所有进程发送量之和等于接收量之和
+    double volumes[2] = {double(a.halo_plan().send_volume()), double(a.halo_plan().recv_volume())};
+    t.allreduce_sum(volumes, 2);
+    CHECK(volumes[0] == volumes[1]);
+    CHECK(a.halo_plan().recv_volume() == a.num_ghosts());
+
+    DistributedVector<double> x(a), y(a);
+    for (size_t i = 0; i < x.local_size(); ++i) x[i] = x_of(a.global_row(i));
+    for (bool overlap : {true, false}) {
+        y.values.data.assign(y.values.size(), 0.0);
+        distributed_spmv(a, x, y, overlap);
+        for (size_t i = 0; i < y.local_size(); ++i) {
+            const size_t row = a.global_row(i);
+            double ref = 0;
+            for (size_t k = global.row_ptr[row]; k < global.row_ptr[row + 1]; ++k) {
+                ref += global.values[k] * x_of(global.col_indices[k]);
+            }
+            if (std::abs(y[i] - ref) > 1e-12) {
+                std::cerr << "rank " << t.rank() << " row " << row << ": " << y[i] << " vs " << ref << std::endl;
+                CHECK(false);
+            }
+        }
+        // 重影值来自所有者
+        for (size_t g = 0; g < a.num_ghosts(); ++g) CHECK(x[x.local_size() + g] == x_of(a.ghost_columns()[g]));
+    }
+
+    double dot = distributed_dot(x, x, t), ref = 0;
+    for (size_t r = 0; r < global.num_rows(); ++r) ref += x_of(r) * x_of(r);
+    CHECK(std::abs(dot - ref) < 1e-9 * ref);
+    return 0;
+}
+
+static int check_poisson_halo(Transport& t) {
+    const size_t n = 24;
+    Matrix global = poisson_2d(n);
+    check_spmv(t, global);
+    // 每块至少 n 行时，中间的进程各需要上下各 n 个重影
+    auto a = DistributedCSRMatrix<double, double>::from_global(t, RowPartition::uniform(n * n, t.size()), global);
+    const bool first = t.rank() == 0, last = t.rank() == t.size() - 1;
+    CHECK(a.num_ghosts() == (first ? 0 : n) + (last ? 0 : n));
+    CHECK(a.boundary_rows().size() == a.num_ghosts());
+    return 0;
+}
+
+static int check_collectives(Transport& t) {
+    const int p = t.size(), me = t.rank();
+    std::vector<int> all(static_cast<size_t>(p));
+    const int mine = 100 + me;
+    t.allgather(&mine, all.data(), sizeof(int));
+    for (int r = 0; r < p; ++r) CHECK(all[static_cast<size_t>(r)] == 100 + r);
+
+    double sums[2] = {1.0, double(me)};
+    t.allreduce_sum(sums, 2);
+    CHECK(sums[0] == p && sums[1] == p * (p - 1) / 2);
+
+    // 消息远大于通道容量，且双向同时发送
+    const size_t len = 20000;
+    std::vector<std::vector<double>> out(static_cast<size_t>(p)), in(static_cast<size_t>(p));
+    for (int r = 0; r < p; ++r) {
+        if (r == me) continue;
+        out[static_cast<size_t>(r)].resize(len);
+        in[static_cast<size_t>(r)].resize(len);
+        for (size_t i = 0; i < len; ++i) out[static_cast<size_t>(r)][i] = me * 1e6 + r * 1e5 + double(i);
+        t.post_recv(r, in[static_cast<size_t>(r)].data(), len * sizeof(double));
+        t.post_send(r, out[static_cast<size_t>(r)].data(), len * sizeof(double));
+    }
+    t.wait_all();
+    for (int r = 0; r < p; ++r) {
+        if (r == me) continue;
+        for (size_t i = 0; i < len; ++i) CHECK(in[static_cast<size_t>(r)][i] == r * 1e6 + me * 1e5 + double(i));
+    }
+    t.barrier();
+    t.barrier();
+    return 0;
+}
+
+void test_row_partition() {
+    RowPartition p = RowPartition::uniform(10, 3);
+    CHECK(p.num_ranks() == 3 && p.num_rows() == 10);
+    CHECK(p.begin(0) == 0 && p.end(0) == 3 && p.end(1) == 6 && p.end(2) == 10);
+    CHECK(p.owner(0) == 0 && p.owner(2) == 0 && p.owner(3) == 1 && p.owner(9) == 2);
+    std::cout << "Row partition test passed!" << std::endl;
+}
+
+#ifdef ACCESSOR_WITH_MPI
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int status = 0;
+    {
+        MpiTransport t;
+        if (t.rank() == 0) test_row_partition();
+        status |= check_collectives(t);
+        status |= check_poisson_halo(t);
+        status |= check_spmv(t, random_matrix(1000, 12));
+        if (t.rank() == 0 && status == 0) std::cout << "MPI distributed SpMV test passed!" << std::endl;
+    }
+    MPI_Finalize();
+    return status;
+}
+
+#else
+
+// 每个进程数都在共享内存通道上跑一遍；较小的通道容量让消息分段传输
+static void run_all(const char* name, const std::function<int(Transport&)>& fn, size_t capacity = size_t{1} << 20) {
+    for (int p = 1; p <= 4; ++p) {
+        if (!run_shm_processes(p, fn, capacity)) {
+            std::cerr << name << " failed with " << p << " processes" << std::endl;
+            CHECK(false);
+        }
+    }
+}
+
+void test_shm_collectives() {
+    run_all("collectives", check_collectives, 4096);
+    std::cout << "Shared-memory transport test passed!" << std::endl;
+}
+
+void test_distributed_spmv() {
+    run_all("poisson", check_poisson_halo);
+    run_all("poisson, small channels", check_poisson_halo, 64);
+    Matrix random = random_matrix(1000, 12);
+    run_all("random", [&random](Transport& t) { return check_spmv(t, random); });
+    std::cout << "Distributed SpMV test passed!" << std::endl;
+}
+
+int main() {
+    test_row_partition();
+    test_shm_collectives();
+    test_distributed_spmv();
+    return 0;
+}
+
+#endif
@@ -0,0 +1,171 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/dynamic_csr.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <accessor/traits/dynamic_csr_traits.hpp>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<double>;
+using Dynamic = DynamicCSRMatrix<double>;
+using Reference = std::map<std::pair<size_t, size_t>, double>;
+
+static Matrix random_matrix(size_t n, size_t per_row, unsigned seed, Reference& ref) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> col(0, n - 1);
+    std::uniform_real_distribution<double> val(-1.0, 1.0);
+    for (size_t r = 0; r < n; ++r)
+        for (size_t k = 0; k < per_row; ++k) ref[{r, col(rng)}] = val(rng);
+    Matrix a;
+    a.row_ptr.assign(n + 1, 0);
+    for (const auto& [key, v] : ref) {
+        ++a.row_ptr[key.first + 1];
+        a.col_indices.push_back(key.second);
+        a.values.push_back(v);
+    }
+    for (size_t r = 0; r < n; ++r) a.row_ptr[r + 1] += a.row_ptr[r];
+    return a;
+}
+
+// 随机批次：插入、覆盖与删除混合，同一批内同一位置可多次出现
+static std::vector<CSRUpdate<double>> random_batch(size_t n, size_t size, std::mt19937& rng, Reference& ref) {
+    std::uniform_int_distribution<size_t> row(0, n - 1), col(0, n - 1), hot(0, 9);
+    std::uniform_real_distribution<double> val(-1.0, 1.0);
+    std::vector<CSRUpdate<double>> batch;
+    for (size_t i = 0; i < size; ++i) {
+        const size_t r = hot(rng) < 3 ? hot(rng) : row(rng);   // 少数行被频繁更新
+        const size_t c = hot(rng) < 3 ? hot(rng) : col(rng);
+        if (val(rng) < 0.4) {
+            batch.push_back({r, c, 0.0, CSRUpdateKind::Erase});
+            ref.erase({r, c});
+        } else {
+            const double v = val(rng);
+            batch.push_back({r, c, v, CSRUpdateKind::Insert});
+            ref[{r, c}] = v;
+        }
+    }
+    return batch;
+}
+
+static void check_contents(const Dynamic& m, const Reference& ref) {
+    CHECK(m.num_nonzeros() == ref.size());
+    auto it = ref.begin();
+    for (size_t r = 0; r < m.num_rows(); ++r) {
+        auto view = m.row_view(r);
+        for (size_t k = 0; k < view.num_non_zeros; ++k, ++it) {
+            CHECK(it != ref.end() && it->first.first == r && it->first.second == view.col_indices_ptr[k]);
+            CHECK(view.value(k) == it->second);
+        }
+    }
+    CHECK(it == ref.end());
+    Matrix csr = m.to_csr();
+    CHECK(csr.num_nonzeros() == ref.size());
+}
+
+// 未修改的CSR行视图SpMV内核直接作用在动态矩阵上
+static void check_spmv(Dynamic& m, const Reference& ref) {
+    const size_t n = m.num_rows();
+    DenseArray1D<double> x(n), y(n);
+    for (size_t i = 0; i < n; ++i) x.data[i] = 1.0 + 0.5 * static_cast<double>(i % 3);
+    Accessor<Dynamic, AccessMode::Read> mat(m);
+    Accessor<DenseArray1D<double>, AccessMode::Read> x_in(x);
+    Accessor<DenseArray1D<double>, AccessMode::Write> y_out(y);
+    custom_parallel_for(IterateOver::CSRRows(m),
+        [](size_t row, const auto& a, const auto& xv, auto& yv) {
+            auto view = a.get_view(row, GetCSRRowViewTag{});
+            double sum = 0;
+            for (size_t k = 0; k < view.num_non_zeros; ++k) sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+            yv.set_value_by_id(row, sum);
+        },
+        mat, x_in, y_out);
+    std::vector<double> expected(n, 0.0);
+    for (const auto& [key, v] : ref) expected[key.first] += v * x.data[key.second];
+    for (size_t i = 0; i < n; ++i) CHECK(std::abs(y.data[i] - expected[i]) < 1e-12);
+}
+
+void test_batched_updates() {
+    const size_t n = 300;
+    Reference ref;
+    DynamicCSROptions opts;
+    opts.compaction_threshold = 0;   // 只检验覆盖层
+    Dynamic m(random_matrix(n, 4, 1, ref), opts);
+    check_contents(m, ref);
+    std::mt19937 rng(2);
+    for (int b = 0; b < 20; ++b) {
+        m.apply_updates(random_batch(n, 400, rng, ref));
+        check_contents(m, ref);
+    }
+    CHECK(m.overlay_rows() > 0 && m.compactions() == 0);
+    check_spmv(m, ref);
+
+    m.apply_updates({});
+    check_contents(m, ref);
+    bool threw = false;
+    try {
+        m.apply_updates({{n, 0, 1.0, CSRUpdateKind::Insert}});
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    m.compact();
+    CHECK(m.overlay_rows() == 0 && m.overlay_entries() == 0 && m.compactions() == 1);
+    check_contents(m, ref);
+    check_spmv(m, ref);
+    std::cout << "Batched update test passed!" << std::endl;
+}
+
+void test_automatic_compaction() {
+    const size_t n = 400;
+    for (bool background : {false, true}) {
+        Reference ref;
+        DynamicCSROptions opts;
+        opts.compaction_threshold = 0.1;
+        opts.background_compaction = background;
+        Dynamic m(random_matrix(n, 6, 3, ref), opts);
+        std::mt19937 rng(4);
+        for (int b = 0; b < 40; ++b) {
+            m.apply_updates(random_batch(n, 300, rng, ref));
+            // 后台合并进行中，查询同时看到冻结层与新覆盖层
+            check_contents(m, ref);
+            if (b % 10 == 0) check_spmv(m, ref);
+        }
+        m.wait_for_compaction();
+        CHECK(!m.compaction_in_progress());
+        CHECK(m.compactions() > 0);
+        check_contents(m, ref);
+        check_spmv(m, ref);
+    }
+
+    // 手动后台合并期间继续更新
+    Reference ref;
+    DynamicCSROptions opts;
+    opts.compaction_threshold = 0;
+    Dynamic m(random_matrix(n, 6, 5, ref), opts);
+    std::mt19937 rng(6);
+    m.apply_updates(random_batch(n, 500, rng, ref));
+    CHECK(m.start_background_compaction());
+    m.apply_updates(random_batch(n, 500, rng, ref));
+    check_contents(m, ref);
+    Dynamic copy(m);   // 复制不等待后台合并
+    check_contents(copy, ref);
+    m.wait_for_compaction();
+    CHECK(m.compactions() == 1);
+    check_contents(m, ref);
+    std::cout << "Automatic compaction test passed!" << std::endl;
+}
+
+int main() {
+    test_batched_updates();
+    test_automatic_compaction();
+    return 0;
+}
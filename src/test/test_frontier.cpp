@@ -0,0 +1,154 @@
+#include <accessor/core/frontier.hpp>
+#include <accessor/traits/frontier_traits.hpp>
+#include <accessor/iteration/frontier_vertices.hpp>
+#include <accessor/algorithms/bfs.hpp>
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <iostream>
+#include <queue>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+// 无向网格图 (rows x cols)，以对称CSR存储
+static CSRMatrix make_grid_graph(size_t rows, size_t cols) {
+    CSRMatrix g;
+    g.row_ptr.push_back(0);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            if (r > 0) g.col_indices.push_back((r - 1) * cols + c);
+            if (c > 0) g.col_indices.push_back(r * cols + c - 1);
+            if (c + 1 < cols) g.col_indices.push_back(r * cols + c + 1);
+            if (r + 1 < rows) g.col_indices.push_back((r + 1) * cols + c);
+            g.row_ptr.push_back(g.col_indices.size());
+        }
+    }
+    g.values.assign(g.col_indices.size(), 1.0f);
+    return g;
+}
+
+static std::vector<size_t> serial_bfs(const CSRMatrix& g, size_t source) {
+    std::vector<size_t> depth(g.num_rows(), BFSResult::unreached);
+    std::queue<size_t> q;
+    depth[source] = 0;
+    q.push(source);
+    while (!q.empty()) {
+        size_t v = q.front();
+        q.pop();
+        for (size_t i = g.row_ptr[v]; i < g.row_ptr[v + 1]; ++i) {
+            size_t u = g.col_indices[i];
+            if (depth[u] == BFSResult::unreached) {
+                depth[u] = depth[v] + 1;
+                q.push(u);
+            }
+        }
+    }
+    return depth;
+}
+
+void test_frontier_conversion() {
+    const size_t N = 200;
+    SparseFrontier list(N);
+    list.vertices = {3, 64, 65, 127, 128, 199};
+
+    DenseFrontier bits;
+    sparse_to_dense(list, bits);
+    CHECK(bits.count() == list.size());
+    for (size_t v : list.vertices) CHECK(bits.test(v));
+    CHECK(!bits.test(0) && !bits.test(66));
+
+    SparseFrontier back;
+    dense_to_sparse(bits, back);
+    CHECK(back.vertices == list.vertices);
+    CHECK(back.num_vertices == N);
+
+    Frontier f(N, 0.01);
+    f.assign(SparseFrontier(list));
+    CHECK(f.representation() == FrontierRepresentation::Dense);
+    CHECK(f.has_dense() && f.size() == list.size());
+
+    Frontier g(N);
+    g.assign(DenseFrontier(bits));
+    CHECK(g.representation() == FrontierRepresentation::Sparse);
+    CHECK(g.sparse().vertices == list.vertices);
+
+    std::cout << "Frontier conversion test passed!" << std::endl;
+}
+
+void test_frontier_iteration_space() {
+    const size_t N = 1000;
+    DenseFrontier bits(N);
+    std::vector<size_t> expected;
+    for (size_t v = 0; v < N; v += 7) {
+        bits.insert(v);
+        expected.push_back(v);
+    }
+
+    // 位图迭代空间与列表迭代空间应给出相同的顶点序列
+    IterateOver::FrontierVertices dense_space(bits);
+    CHECK(dense_space.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        CHECK(dense_space[i] == expected[i]);
+    }
+
+    std::vector<float> out(N, 0.0f);
+    Accessor<DenseFrontier, AccessMode::Read> bits_acc(bits);
+    Accessor<std::vector<float>, AccessMode::Write> out_acc(out);
+    accessor::custom_parallel_for(dense_space,
+        [](size_t v,
+           const Accessor<DenseFrontier, AccessMode::Read>& active,
+           Accessor<std::vector<float>, AccessMode::Write>& o) {
+            o.set_value_by_id(v, active.get_value_by_id(v) ? 1.0f : -1.0f);
+        },
+        bits_acc, out_acc);
+
+    bool valid = true;
+    for (size_t v = 0; v < N; ++v) {
+        float want = (v % 7 == 0) ? 1.0f : 0.0f;
+        if (out[v] != want) {
+            std::cerr << "Frontier iteration test failed at " << v << ": got " << out[v] << std::endl;
+            valid = false;
+        }
+    }
+    CHECK(valid);
+    std::cout << "Frontier iteration space test passed!" << std::endl;
+}
+
+void test_direction_optimizing_bfs() {
+    CSRMatrix g = make_grid_graph(40, 50);
+    std::vector<size_t> expected = serial_bfs(g, 0);
+
+    bool valid = true;
+    for (BFSDirection dir : {BFSDirection::Auto, BFSDirection::PushOnly, BFSDirection::PullOnly}) {
+        BFSOptions opts;
+        opts.direction = dir;
+        BFSResult res = direction_optimizing_bfs(g, 0, opts);
+        if (res.depth != expected) {
+            std::cerr << "BFS depth mismatch for direction " << static_cast<int>(dir) << std::endl;
+            valid = false;
+        }
+        CHECK(res.num_levels == 40 + 50 - 1);
+    }
+
+    // 低阈值强制在push/pull之间切换
+    BFSOptions eager;
+    eager.alpha = 1e6;
+    eager.beta = 1.0;
+    BFSResult res = direction_optimizing_bfs(g, 1234, eager);
+    if (res.depth != serial_bfs(g, 1234)) {
+        std::cerr << "BFS depth mismatch with eager switching" << std::endl;
+        valid = false;
+    }
+    CHECK(res.pull_steps > 0 && res.push_steps > 0);
+
+    CHECK(valid);
+    std::cout << "Direction-optimizing BFS test passed!" << std::endl;
+}
+
+int main() {
+    test_frontier_conversion();
+    test_frontier_iteration_space();
+    test_direction_optimizing_bfs();
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/concurrent_hash_map.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/custom_parallel_reduce.hpp>
+#include <accessor/iteration/masked.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <accessor/traits/hash_map_traits.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <omp.h>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+using CountMap = ConcurrentHashMap<uint64_t, long long>;
+
+// 取最大值的归约算子，通过策略特化强制使用线程局部缓冲
+struct MaxOp {
+    double operator()(double a, double b) const { return a > b ? a : b; }
+};
+
+namespace accessor {
+template<>
+struct ReduceSemanticsPolicy<ConcurrentHashMap<uint64_t, double>, double, MaxOp> {
+    static constexpr ReduceImplKind impl_kind = ReduceImplKind::LocalBufferAndFinalReduce;
+};
+} // namespace accessor
+
+void test_basic_operations() {
+    CountMap map(10);
+    CHECK(map.capacity() >= 20 && map.empty());
+    map.insert_or_assign(42, 1);
+    map.insert_or_assign(7, 2);
+    map.insert_or_assign(42, 5);
+    map.reduce(7, 10LL, std::plus<long long>{});
+    map.reduce(9, 3LL, std::plus<long long>{});
+    CHECK(map.size() == 3);
+    long long v = 0;
+    CHECK(map.find(42, v) && v == 5);
+    CHECK(map.value_or(7, -1) == 12 && map.value_or(9, -1) == 3);
+    CHECK(!map.contains(8) && map.value_or(8, -1) == -1);
+
+    std::vector<uint64_t> keys = map.keys();
+    std::sort(keys.begin(), keys.end());
+    CHECK((keys == std::vector<uint64_t>{7, 9, 42}));
+
+    map.rehash(1000);
+    CHECK(map.capacity() >= 2000 && map.size() == 3 && map.value_or(7, -1) == 12);
+    map.clear();
+    CHECK(map.empty() && !map.contains(42));
+
+    // 容量耗尽时抛出异常
+    CountMap tiny(0);
+    bool threw = false;
+    try {
+        for (uint64_t k = 0; k <= tiny.capacity(); ++k) tiny.insert_or_assign(k, 1);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    CHECK(threw && tiny.size() == tiny.capacity());
+    std::cout << "Hash map basic operations test passed!" << std::endl;
+}
+
+void test_parallel_write_and_read() {
+    const size_t n = 5000;
+    CountMap map(n);
+    Accessor<CountMap, AccessMode::Write> w(map);
+    custom_parallel_for(IterateOver::Range1D(n),
+        [](size_t i, Accessor<CountMap, AccessMode::Write>& m) {
+            m.set_value_by_id(i * 7919, static_cast<long long>(i));
+        },
+        w);
+    CHECK(map.size() == n);
+
+    // 按键列表遍历，读取并写入稠密数组
+    std::vector<uint64_t> keys = map.keys();
+    DenseArray1D<long long> out(n);
+    Accessor<CountMap, AccessMode::Read> r(map);
+    Accessor<DenseArray1D<long long>, AccessMode::Write> out_acc(out);
+    custom_parallel_for(IterateOver::IndexList<uint64_t>(keys),
+        [](uint64_t key, const Accessor<CountMap, AccessMode::Read>& m,
+           Accessor<DenseArray1D<long long>, AccessMode::Write>& o) {
+            o.set_value_by_id(key / 7919, m.get_value_by_id(key));
+        },
+        r, out_acc);
+    for (size_t i = 0; i < n; ++i) CHECK(out[i] == static_cast<long long>(i));
+    std::cout << "Hash map parallel write/read test passed!" << std::endl;
+}
+
+static std::vector<uint64_t> skewed_keys(size_t n) {
+    // 一半记录落在键0上，其余分布在少量键上
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; ++i) keys[i] = (i % 2 == 0) ? 0 : (i * 2654435761u) % 97 + 1;
+    return keys;
+}
+
+void test_reduce_strategies() {
+    const size_t n = 20000;
+    DenseArray1D<uint64_t> keys(skewed_keys(n));
+    std::unordered_map<uint64_t, long long> expected;
+    for (size_t i = 0; i < n; ++i) expected[keys[i]] += static_cast<long long>(i % 5);
+
+    for (ReduceImplKind kind : {ReduceImplKind::DeviceAtomic, ReduceImplKind::LocalBufferAndFinalReduce}) {
+        CountMap map(128);
+        map.set_reduce_strategy(kind);
+        Accessor<DenseArray1D<uint64_t>, AccessMode::Read> k_acc(keys);
+        Accessor<CountMap, AccessMode::Reduce> m_acc(map);
+        custom_parallel_for(IterateOver::Range1D(n),
+            [](size_t i, const Accessor<DenseArray1D<uint64_t>, AccessMode::Read>& k,
+               Accessor<CountMap, AccessMode::Reduce>& m) {
+                m.reduce_value_by_id(k.get_value_by_id(i), static_cast<long long>(i % 5));
+            },
+            k_acc, m_acc);
+        // 局部缓冲在循环结束时已合并
+        CHECK(map.size() == expected.size());
+        for (const auto& [key, sum] : expected) {
+            if (map.value_or(key, -1) != sum) {
+                std::cerr << "Reduce mismatch for key " << key << ": " << map.value_or(key, -1) << " vs " << sum << std::endl;
+                CHECK(false);
+            }
+        }
+    }
+
+    // 策略特化：MaxOp使用局部缓冲（map默认策略为原子更新）
+    ConcurrentHashMap<uint64_t, double> max_map(128);
+    Accessor<DenseArray1D<uint64_t>, AccessMode::Read> k_acc(keys);
+    Accessor<ConcurrentHashMap<uint64_t, double>, AccessMode::Reduce> max_acc(max_map);
+    custom_parallel_for(IterateOver::Range1D(n),
+        [](size_t i, const Accessor<DenseArray1D<uint64_t>, AccessMode::Read>& k,
+           Accessor<ConcurrentHashMap<uint64_t, double>, AccessMode::Reduce>& m) {
+            m.reduce_value_by_id(k.get_value_by_id(i), static_cast<double>(i), MaxOp{});
+        },
+        k_acc, max_acc);
+    CHECK(max_map.value_or(0, -1.0) == static_cast<double>(n - 2));
+    for (uint64_t key = 1; key <= 97; ++key) {
+        double expected_max = -1.0;
+        for (size_t i = 1; i < n; i += 2) {
+            if (keys[i] == key) expected_max = static_cast<double>(i);
+        }
+        CHECK(max_map.value_or(key, -1.0) == expected_max);
+    }
+    std::cout << "Hash map reduce strategies test passed!" << std::endl;
+}
+
+void test_reduce_loop_finalizes() {
+    const size_t n = 5000;
+    DenseArray1D<uint64_t> keys(skewed_keys(n));
+    std::unordered_map<uint64_t, long long> expected;
+    long long expected_total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        expected[keys[i]] += static_cast<long long>(i % 5);
+        expected_total += static_cast<long long>(i % 3);
+    }
+
+    // 归约循环同样在返回前合并局部缓冲
+    for (const ReduceOptions& options : {ReduceOptions{}, reproducible_reduce(256)}) {
+        CountMap map(128);
+        map.set_reduce_strategy(ReduceImplKind::LocalBufferAndFinalReduce);
+        Accessor<DenseArray1D<uint64_t>, AccessMode::Read> k_acc(keys);
+        Accessor<CountMap, AccessMode::Reduce> m_acc(map);
+        const long long total = custom_parallel_reduce(IterateOver::Range1D(n), options,
+            [](size_t i, const Accessor<DenseArray1D<uint64_t>, AccessMode::Read>& k,
+               Accessor<CountMap, AccessMode::Reduce>& m) {
+                m.reduce_value_by_id(k.get_value_by_id(i), static_cast<long long>(i % 5));
+                return static_cast<long long>(i % 3);
+            },
+            0LL, std::plus<>{}, k_acc, m_acc);
+        CHECK(total == expected_total);
+        CHECK(map.size() == expected.size());
+        for (const auto& [key, sum] : expected) CHECK(map.value_or(key, -1) == sum);
+    }
+    std::cout << "Reduce loop finalization test passed!" << std::endl;
+}
+
+// 外层循环的每个迭代再开一个对同一张表归约的内层循环：内层直接归约到共享表，
+// 内层结束时只合并本线程的局部表
+void test_nested_local_reduce() {
+    const size_t outer = 64, inner = 4000;
+    std::unordered_map<uint64_t, long long> expected;
+    for (size_t o = 0; o < outer; ++o) {
+        expected[o % 7] += 1;
+        for (size_t i = 0; i < inner; ++i) expected[(o * 31 + i) % 3000 + 100] += static_cast<long long>(i % 4);
+    }
+    using MapAcc = Accessor<CountMap, AccessMode::Reduce>;
+    const int saved_threads = omp_get_max_threads();
+    omp_set_num_threads(std::max(saved_threads, 4));
+    CountMap map(4096);
+    map.set_reduce_strategy(ReduceImplKind::LocalBufferAndFinalReduce);
+    MapAcc m_acc(map);
+    custom_parallel_for(IterateOver::Range1D(outer),
+        [inner](size_t o, MapAcc& m) {
+            m.reduce_value_by_id(o % 7, 1LL);
+            MapAcc nested = m;
+            custom_parallel_for(IterateOver::Range1D(inner),
+                [o](size_t i, MapAcc& n) { n.reduce_value_by_id((o * 31 + i) % 3000 + 100, static_cast<long long>(i % 4)); },
+                nested);
+        },
+        m_acc);
+    omp_set_num_threads(saved_threads);
+    CHECK(map.size() == expected.size());
+    for (const auto& [key, sum] : expected) CHECK(map.value_or(key, -1) == sum);
+    std::cout << "Nested local reduce test passed!" << std::endl;
+}
+
+int main() {
+    test_basic_operations();
+    test_parallel_write_and_read();
+    test_reduce_strategies();
+    test_reduce_loop_finalizes();
+    test_nested_local_reduce();
+    return 0;
+}
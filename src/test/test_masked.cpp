@@ -0,0 +1,129 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/parallel_compact.hpp>
+#include <accessor/iteration/masked.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+struct SimpleRange {
+    size_t count;
+    size_t size() const { return count; }
+    size_t operator[](size_t idx) const { return idx; }
+};
+
+void test_parallel_compact() {
+    const size_t N = 10007;
+    std::vector<size_t> ids = parallel_compact(SimpleRange{N}, [](size_t i) { return i % 3 == 1; });
+    CHECK(ids.size() == (N + 1) / 3);
+    for (size_t k = 0; k < ids.size(); ++k) {
+        CHECK(ids[k] == 3 * k + 1);
+    }
+    CHECK(parallel_compact(SimpleRange{0}, [](size_t) { return true; }).empty());
+    std::cout << "Parallel compaction test passed!" << std::endl;
+}
+
+void test_masked_nonempty_rows() {
+    // [1 0 0]
+    // [0 0 0]
+    // [2 3 0]
+    // [0 0 0]
+    CSRMatrix mat;
+    mat.values = {1, 2, 3};
+    mat.col_indices = {0, 0, 1};
+    mat.row_ptr = {0, 1, 1, 3, 3};
+
+    IterateOver::Masked rows(IterateOver::CSRRows(mat),
+        [&mat](size_t r) { return mat.row_ptr[r + 1] > mat.row_ptr[r]; });
+    CHECK(rows.base_size() == 4);
+    CHECK(rows.size() == 2 && rows[0] == 0 && rows[1] == 2);
+
+    std::vector<float> x = {1, 1, 1};
+    std::vector<float> y(4, -1.0f);
+    Accessor<CSRMatrix, AccessMode::Read> mat_acc(mat);
+    Accessor<std::vector<float>, AccessMode::Read> x_acc(x);
+    Accessor<std::vector<float>, AccessMode::Write> y_acc(y);
+
+    accessor::custom_parallel_for(rows,
+        [](size_t row_idx,
+           const Accessor<CSRMatrix, AccessMode::Read>& m,
+           const Accessor<std::vector<float>, AccessMode::Read>& xv,
+           Accessor<std::vector<float>, AccessMode::Write>& yv) {
+            auto row = m.get_view(row_idx, GetCSRRowViewTag{});
+            float sum = 0.0f;
+            for (size_t i = 0; i < row.num_non_zeros; ++i) {
+                sum += row.values_ptr[i] * xv.get_value_by_id(row.col_indices_ptr[i]);
+            }
+            yv.set_value_by_id(row_idx, sum);
+        },
+        mat_acc, x_acc, y_acc);
+
+    // 空行未被访问，保持初值
+    bool valid = y[0] == 1.0f && y[1] == -1.0f && y[2] == 5.0f && y[3] == -1.0f;
+    if (!valid) {
+        std::cerr << "Masked CSR rows test failed: " << y[0] << " " << y[1] << " " << y[2] << " " << y[3] << std::endl;
+        std::exit(1);
+    } else {
+        std::cout << "Masked CSR rows test passed!" << std::endl;
+    }
+}
+
+void test_masked_with_accessor_predicate() {
+    // 只更新未收敛的项: residual > tol
+    const size_t N = 1000;
+    const float tol = 1e-3f;
+    DenseArray1D<float> residual(N), x(N);
+    for (size_t i = 0; i < N; ++i) {
+        residual[i] = (i % 10 == 0) ? 1.0f : 0.0f;
+        x[i] = 0.0f;
+    }
+
+    Accessor<DenseArray1D<float>, AccessMode::Read> r_acc(residual);
+    IterateOver::Masked active(SimpleRange{N},
+        [tol](size_t i, const Accessor<DenseArray1D<float>, AccessMode::Read>& r) {
+            return std::fabs(r.get_value_by_id(i)) > tol;
+        },
+        r_acc);
+    CHECK(active.size() == N / 10);
+
+    Accessor<DenseArray1D<float>, AccessMode::ReadWrite> x_acc(x);
+    accessor::custom_parallel_for(active,
+        [](size_t i,
+           const Accessor<DenseArray1D<float>, AccessMode::Read>& r,
+           Accessor<DenseArray1D<float>, AccessMode::ReadWrite>& xv) {
+            xv.set_value_by_id(i, xv.get_value_by_id(i) + r.get_value_by_id(i));
+        },
+        r_acc, x_acc);
+
+    bool valid = true;
+    for (size_t i = 0; i < N; ++i) {
+        if (x[i] != residual[i]) {
+            std::cerr << "Masked accessor predicate test failed at " << i << ": got " << x[i] << std::endl;
+            valid = false;
+        }
+    }
+    CHECK(valid);
+    std::cout << "Masked accessor predicate test passed!" << std::endl;
+}
+
+void test_index_list() {
+    IterateOver::IndexList<size_t> list({5, 2, 9});
+    IterateOver::IndexList<size_t> copy = list;
+    CHECK(copy.size() == 3 && &copy.ids() == &list.ids());
+    CHECK(list[0] == 5 && list[1] == 2 && list[2] == 9);
+    CHECK(IterateOver::IndexList<size_t>().size() == 0);
+    std::cout << "Index list test passed!" << std::endl;
+}
+
+int main() {
+    test_parallel_compact();
+    test_masked_nonempty_rows();
+    test_masked_with_accessor_predicate();
+    test_index_list();
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/custom_parallel_reduce.hpp>
+#include <accessor/core/custom_parallel_scan.hpp>
+#include <accessor/core/custom_team_parallel_for.hpp>
+#include <accessor/core/dynamic_csr.hpp>
+#include <accessor/core/memory_resource.hpp>
+#include <accessor/core/permutation.hpp>
+#include <accessor/core/spgemm.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+using IterateOver::Range1D;
+
+void test_arena() {
+    ArenaResource arena(4096);
+    void* a = arena.allocate(100, 8);
+    const ArenaResource::Mark m = arena.mark();
+    void* b = arena.allocate(64, 64);
+    CHECK(reinterpret_cast<uintptr_t>(b) % 64 == 0);
+    // 超过块大小的请求单独占一个块
+    void* big = arena.allocate(10000, 16);
+    CHECK(big != nullptr && arena.stats().system_allocations == 2);
+    arena.rewind(m);
+    // 回退后复用同一地址，不再向系统申请
+    CHECK(arena.allocate(64, 64) == b);
+    CHECK(arena.allocate(10000, 16) == big);
+    CHECK(arena.stats().system_allocations == 2);
+    CHECK(arena.stats().allocations == 5 && arena.stats().bytes == 100 + 64 + 10000 + 64 + 10000);
+    arena.reset();
+    CHECK(arena.allocate(100, 8) == a);
+    arena.trim();
+    CHECK(arena.reserved_bytes() == 4096);
+    std::cout << "Arena test passed!" << std::endl;
+}
+
+void test_allocator_aware_structures() {
+    ArenaResource arena;
+    pmr::DenseArray1D<double> v(3, &arena);
+    CHECK(v.get_allocator().resource() == &arena && v.data.size() == 3);
+    CHECK(arena.stats().bytes == 3 * sizeof(double));
+
+    // 带分配器的拷贝把元素放进目标资源
+    pmr::DenseArray1D<double> heap_copy(v, std::pmr::new_delete_resource());
+    CHECK(heap_copy.get_allocator().resource() == std::pmr::new_delete_resource());
+
+    pmr::CSRMatrix a(&arena);
+    a.row_ptr = {0, 1, 3};
+    a.col_indices = {0, 0, 1};
+    a.values = {1.0f, 2.0f, 3.0f};
+    CHECK(a.get_allocator().resource() == &arena && a.row_ptr.get_allocator().resource() == &arena);
+    CountingResource counting;
+    pmr::CSRMatrix b(a, &counting);
+    CHECK(b.num_nonzeros() == 3 && b.values[2] == 3.0f);
+    CHECK(counting.stats().allocations == 3);
+
+    // 访问器与特性对带分配器的类型同样适用
+    Accessor<pmr::CSRMatrix, AccessMode::Read> acc(b);
+    CHECK(acc.get_view(1, GetCSRRowViewTag{}).num_non_zeros == 2);
+    std::cout << "Allocator-aware structure test passed!" << std::endl;
+}
+
+// x[i] = x[i] + x[n-1-i]：读写同一数组触发自动缓冲
+template<typename Vec>
+static void mirror_add(const ExecutionContext& ctx, Vec& x) {
+    const size_t n = x.data.size();
+    Accessor<Vec, AccessMode::Read> in(x);
+    Accessor<Vec, AccessMode::Write> out(x);
+    custom_parallel_for(ctx, Range1D(n),
+        [n](size_t i, const auto& r, auto& w) { w.set_value_by_id(i, r.get_value_by_id(i) + r.get_value_by_id(n - 1 - i)); },
+        in, out);
+}
+
+template<typename Vec>
+static void check_mirror(const Vec& x) {
+    const size_t n = x.data.size();
+    for (size_t i = 0; i < n; ++i) CHECK(x.data[i] == static_cast<double>(n - 1));
+}
+
+void test_parallel_for_context() {
+    const size_t n = 1000;
+    // 缓冲副本来自上下文给出的资源
+    CountingResource counting;
+    pmr::DenseArray1D<double> x(n, std::pmr::new_delete_resource());
+    for (size_t i = 0; i < n; ++i) x.data[i] = static_cast<double>(i);
+    mirror_add(ExecutionContext{&counting}, x);
+    check_mirror(x);
+    CHECK(counting.stats().bytes >= n * sizeof(double));
+
+    // 默认的线程区域在预热后不再向系统申请内存
+    DenseArray1D<double> y(n);
+    for (size_t i = 0; i < n; ++i) x.data[i] = y.data[i] = static_cast<double>(i);
+    mirror_add(ExecutionContext{}, x);
+    mirror_add(ExecutionContext{}, y);
+    const AllocationStats warm = thread_arena().stats();
+    for (int rep = 0; rep < 3; ++rep) {
+        for (size_t i = 0; i < n; ++i) x.data[i] = static_cast<double>(i);
+        mirror_add(ExecutionContext{}, x);
+        check_mirror(x);
+    }
+    CHECK(thread_arena().stats().system_allocations == warm.system_allocations);
+    CHECK(thread_arena().stats().allocations > warm.allocations);
+    check_mirror(y);
+
+    // 显式传入的区域在调用结束时回退
+    ArenaResource arena;
+    for (size_t i = 0; i < n; ++i) x.data[i] = static_cast<double>(i);
+    mirror_add(ExecutionContext{&arena}, x);
+    check_mirror(x);
+    CHECK(arena.stats().bytes >= n * sizeof(double));
+    const ArenaResource::Mark m = arena.mark();
+    CHECK(m.chunk == 0 && m.offset == 0);
+    std::cout << "Parallel for context test passed!" << std::endl;
+}
+
+void test_reduce_scan_team_context() {
+    const size_t n = 5000;
+    DenseArray1D<long long> v(n), out(n);
+    for (size_t i = 0; i < n; ++i) v.data[i] = static_cast<long long>(i % 11);
+    Accessor<DenseArray1D<long long>, AccessMode::Read> in(v);
+    Accessor<DenseArray1D<long long>, AccessMode::Write> res(out);
+    long long expected = 0;
+    for (long long x : v.data) expected += x;
+
+    CountingResource counting;
+    const ExecutionContext ctx{&counting};
+    auto identity = [](size_t i, const auto& a) { return a.get_value_by_id(i); };
+    CHECK(custom_parallel_reduce(ctx, Range1D(n), ReduceOptions{}, identity, 0LL, std::plus<>{}, in) == expected);
+    CHECK(counting.stats().allocations > 0);
+    CHECK(custom_parallel_reduce(ctx, Range1D(n), reproducible_reduce(128), identity, 0LL, std::plus<>{}, in) ==
+           expected);
+    CHECK(counting.stats().bytes >= (n + 127) / 128 * sizeof(long long));
+
+    counting.reset_stats();
+    CHECK(custom_parallel_scan(ctx, Range1D(n), ScanKind::Inclusive, 0LL, std::plus<>{}, in, res) == expected);
+    CHECK(out.data[n - 1] == expected && counting.stats().allocations == 1);
+
+    // 队伍状态与暂存同样来自上下文
+    counting.reset_stats();
+    std::vector<long long> sums(20, 0);
+    TeamPolicy policy{2, 4 * sizeof(long long), 0, {}};
+    custom_team_parallel_for(ctx, policy, Range1D(sums.size()), [&](TeamMember& team, size_t item) {
+        long long* shared = team.team_scratch<long long>(4);
+        team.single([&] { shared[0] = static_cast<long long>(item); });
+        team.team_barrier();
+        const long long s = team.parallel_reduce(item, [](size_t i) { return static_cast<long long>(i); }, shared[0]);
+        team.team_barrier();
+        team.single([&] { sums[item] = s; });
+    });
+    for (size_t item = 0; item < sums.size(); ++item) {
+        const long long k = static_cast<long long>(item);
+        CHECK(sums[item] == k + k * (k - 1) / 2);
+    }
+    CHECK(counting.stats().allocations == 2);
+    std::cout << "Reduce/scan/team context test passed!" << std::endl;
+}
+
+void test_allocator_aware_algorithms() {
+    ArenaResource arena;
+    pmr::CSRMatrix a(&arena);
+    a.row_ptr = {0, 2, 3};
+    a.col_indices = {0, 1, 1};
+    a.values = {1.0f, 2.0f, 3.0f};
+
+    // 结果沿用输入的资源，数值与默认分配器版本一致
+    const pmr::CSRMatrix t = transpose_csr(a);
+    CHECK(t.get_allocator().resource() == &arena && t.row_ptr == std::pmr::vector<size_t>({0, 1, 3}));
+    const pmr::CSRMatrix c = spgemm(a, a);
+    CHECK(c.get_allocator().resource() == &arena && c.values.get_allocator().resource() == &arena);
+    CSRMatrix plain;
+    plain.row_ptr = {0, 2, 3};
+    plain.col_indices = {0, 1, 1};
+    plain.values = {1.0f, 2.0f, 3.0f};
+    const CSRMatrix expected = spgemm(plain, plain);
+    CHECK(std::ranges::equal(c.row_ptr, expected.row_ptr) && std::ranges::equal(c.values, expected.values));
+
+    // 重排前后向量保持各自的资源
+    const Permutation p(std::vector<size_t>{1, 0});
+    pmr::DenseArray1D<double> x(2, &arena), y(2, &arena), back(2, std::pmr::new_delete_resource());
+    x.data = {1.0, 2.0};
+    permute_vector(p, x, y);
+    unpermute_vector(p, y, back);
+    CHECK(y.data[0] == 2.0 && y.get_allocator().resource() == &arena);
+    CHECK(back.data[0] == 1.0 && back.get_allocator().resource() == std::pmr::new_delete_resource());
+
+    // 动态矩阵合并后基底仍在原资源中
+    DynamicCSROptions options;
+    options.background_compaction = false;
+    pmr::DynamicCSRMatrix<float> m(a, options);
+    m.apply_updates({{1, 0, 4.0f, CSRUpdateKind::Insert}, {0, 1, 0.0f, CSRUpdateKind::Erase}});
+    m.compact();
+    const pmr::CSRMatrix merged = m.to_csr();
+    CHECK(merged.get_allocator().resource() == &arena);
+    CHECK(std::ranges::equal(merged.col_indices, std::vector<size_t>{0, 0, 1}));
+    CHECK(std::ranges::equal(merged.values, std::vector<float>{1.0f, 4.0f, 3.0f}));
+    std::cout << "Allocator-aware algorithm test passed!" << std::endl;
+}
+
+int main() {
+    test_arena();
+    test_allocator_aware_structures();
+    test_allocator_aware_algorithms();
+    test_parallel_for_context();
+    test_reduce_scan_team_context();
+    return 0;
+}
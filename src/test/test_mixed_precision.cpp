@@ -0,0 +1,154 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/low_precision.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+void test_bfloat16_rounding() {
+    CHECK(static_cast<float>(bfloat16(1.0f)) == 1.0f);
+    CHECK(static_cast<float>(bfloat16(-2.5f)) == -2.5f);
+    // ulp(1) = 2^-7，平局时舍入到偶数
+    CHECK(static_cast<float>(bfloat16(1.0f + 0x1p-8f)) == 1.0f);
+    CHECK(static_cast<float>(bfloat16(1.0f + 3 * 0x1p-8f)) == 1.0f + 0x1p-6f);
+    CHECK(static_cast<float>(bfloat16(1.0f + 0x1p-8f + 0x1p-20f)) == 1.0f + 0x1p-7f);
+    CHECK(std::isinf(static_cast<float>(bfloat16(std::numeric_limits<float>::infinity()))));
+    CHECK(std::isnan(static_cast<float>(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+    std::cout << "bfloat16 rounding test passed!" << std::endl;
+}
+
+void test_half_rounding() {
+    CHECK(static_cast<float>(half(1.0f + 0x1p-11f)) == 1.0f);
+    CHECK(static_cast<float>(half(1.0f + 3 * 0x1p-11f)) == 1.0f + 0x1p-9f);
+    CHECK(static_cast<float>(half(65504.0f)) == 65504.0f);
+    CHECK(std::isinf(static_cast<float>(half(65520.0f))));
+    CHECK(static_cast<float>(half(65519.0f)) == 65504.0f);
+    // 次正规数：最小值2^-24，平局舍入到偶数
+    CHECK(static_cast<float>(half(0x1p-24f)) == 0x1p-24f);
+    CHECK(static_cast<float>(half(0x1p-25f)) == 0.0f);
+    CHECK(static_cast<float>(half(3 * 0x1p-25f)) == 0x1p-23f);
+    CHECK(std::isnan(static_cast<float>(half(std::numeric_limits<float>::quiet_NaN()))));
+
+    // 所有非NaN的binary16编码 half -> float -> half 无损
+    for (uint32_t b = 0; b < 0x10000u; ++b) {
+        uint16_t bits = static_cast<uint16_t>(b);
+        if ((bits & 0x7c00u) == 0x7c00u && (bits & 0x3ffu) != 0) continue;
+        half h;
+        h.bits = bits;
+        CHECK(half(static_cast<float>(h)).bits == bits);
+    }
+
+    // 批量转换与逐个转换一致
+    std::vector<half> hs(37);
+    for (size_t i = 0; i < hs.size(); ++i) hs[i] = half(static_cast<float>(i) * 0.37f - 5.0f);
+    std::vector<float> out(hs.size());
+    convert_n(hs.data(), out.data(), hs.size());
+    for (size_t i = 0; i < hs.size(); ++i) CHECK(out[i] == static_cast<float>(hs[i]));
+    std::cout << "half rounding test passed!" << std::endl;
+}
+
+void test_dense_array_compute_type() {
+    static_assert(std::is_same_v<DataStructureTraits<DenseArray1D<half>>::ValueType, float>);
+    static_assert(std::is_same_v<DataStructureTraits<DenseArray1D<half>>::StorageType, half>);
+    static_assert(std::is_same_v<DataStructureTraits<DenseArray1D<float, double>>::ValueType, double>);
+    static_assert(sizeof(DenseArray1D<bfloat16>::data[0]) == 2);
+
+    DenseArray1D<bfloat16> a(20);
+    Accessor<DenseArray1D<bfloat16>, AccessMode::Write> w(a);
+    for (size_t i = 0; i < a.size(); ++i) w.set_value_by_id(i, 0.5f * static_cast<float>(i));
+    Accessor<DenseArray1D<bfloat16>, AccessMode::Read> r(a);
+    for (size_t i = 0; i < a.size(); ++i) CHECK(r.get_value_by_id(i) == 0.5f * static_cast<float>(i));
+
+    // 块视图：越界部分被截断
+    auto block = r.get_view(16, GetDenseArrayBlockViewTag{8});
+    CHECK(block.count == 4);
+    float buf[8];
+    block.load(buf);
+    for (size_t i = 0; i < block.count; ++i) CHECK(buf[i] == block.value(i) && buf[i] == 0.5f * (16 + i));
+    std::cout << "Dense array compute type test passed!" << std::endl;
+}
+
+template<typename Matrix, typename Compute>
+static std::vector<Compute> accessor_spmv(const Matrix& a, const DenseArray1D<Compute>& x) {
+    DenseArray1D<Compute> y(a.num_rows());
+    Accessor<Matrix, AccessMode::Read> a_acc(a);
+    Accessor<DenseArray1D<Compute>, AccessMode::Read> x_acc(x);
+    Accessor<DenseArray1D<Compute>, AccessMode::Write> y_acc(y);
+    custom_parallel_for(IterateOver::CSRRows(a),
+        [](size_t row_idx, const Accessor<Matrix, AccessMode::Read>& m,
+           const Accessor<DenseArray1D<Compute>, AccessMode::Read>& xa,
+           Accessor<DenseArray1D<Compute>, AccessMode::Write>& ya) {
+            auto row = m.get_view(row_idx, GetCSRRowViewTag{});
+            Compute sum = 0;
+            for (size_t i = 0; i < row.num_non_zeros; ++i) {
+                sum += row.value(i) * xa.get_value_by_id(row.col_indices_ptr[i]);
+            }
+            ya.set_value_by_id(row_idx, sum);
+        },
+        a_acc, x_acc, y_acc);
+    return y.data;
+}
+
+void test_low_precision_spmv() {
+    // 三对角矩阵，值可被bf16精确表示时结果与fp32一致
+    const size_t n = 200;
+    CSRMatrix a;
+    a.row_ptr.push_back(0);
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) { a.col_indices.push_back(i - 1); a.values.push_back(-1.0f); }
+        a.col_indices.push_back(i); a.values.push_back(2.5f);
+        if (i + 1 < n) { a.col_indices.push_back(i + 1); a.values.push_back(-1.0f); }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    DenseArray1D<float> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = static_cast<float>(i % 5);
+
+    auto a_bf16 = convert_precision<bfloat16>(a);
+    auto a_half = convert_precision<half>(a);
+    static_assert(std::is_same_v<decltype(a_bf16.values)::value_type, bfloat16>);
+    std::vector<float> y_ref = accessor_spmv<CSRMatrix, float>(a, x);
+    CHECK((accessor_spmv<CSRMatrixT<bfloat16>, float>(a_bf16, x) == y_ref));
+    CHECK((accessor_spmv<CSRMatrixT<half>, float>(a_half, x) == y_ref));
+
+    // 不可精确表示的值：误差在存储精度的相对误差界内
+    for (size_t k = 0; k < a.values.size(); ++k) a.values[k] = 1.0f / static_cast<float>(k % 7 + 3);
+    a_bf16 = convert_precision<bfloat16>(a);
+    auto a_f64 = convert_precision<float, double>(a);
+    DenseArray1D<double> xd(n);
+    for (size_t i = 0; i < n; ++i) xd[i] = x[i];
+    std::vector<double> y_exact = accessor_spmv<CSRMatrixT<float, double>, double>(a_f64, xd);
+    std::vector<float> y_bf16 = accessor_spmv<CSRMatrixT<bfloat16>, float>(a_bf16, x);
+    for (size_t i = 0; i < n; ++i) {
+        double bound = 0.0;
+        for (size_t k = a.row_ptr[i]; k < a.row_ptr[i + 1]; ++k) bound += std::abs(a.values[k] * x[a.col_indices[k]]);
+        if (std::abs(y_bf16[i] - y_exact[i]) > bound * 0x1p-8 * 1.01) {
+            std::cerr << "bf16 SpMV error too large at " << i << ": " << y_bf16[i] << " vs " << y_exact[i] << std::endl;
+            CHECK(false);
+        }
+    }
+
+    auto row = Accessor<CSRMatrixT<bfloat16>, AccessMode::Read>(a_bf16).get_view(5, GetCSRRowViewTag{});
+    std::vector<float> vals(row.num_non_zeros);
+    row.load_values(vals.data(), 0, row.num_non_zeros);
+    for (size_t i = 0; i < row.num_non_zeros; ++i) CHECK(vals[i] == row.value(i));
+    std::cout << "Low precision SpMV test passed!" << std::endl;
+}
+
+int main() {
+    test_bfloat16_rounding();
+    test_half_rounding();
+    test_dense_array_compute_type();
+    test_low_precision_spmv();
+    return 0;
+}
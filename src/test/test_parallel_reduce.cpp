@@ -0,0 +1,110 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_reduce.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+using IterateOver::Range1D;
+
+using Vec = DenseArray1D<double>;
+using ReadAcc = Accessor<Vec, AccessMode::Read>;
+
+static double dot_kernel(size_t i, const ReadAcc& x, const ReadAcc& y) {
+    return x.get_value_by_id(i) * y.get_value_by_id(i);
+}
+
+void test_basic_reductions() {
+    const size_t n = 10007;
+    DenseArray1D<long long> v(n);
+    for (size_t i = 0; i < n; ++i) v.data[i] = static_cast<long long>(i % 13) - 6;
+    Accessor<DenseArray1D<long long>, AccessMode::Read> acc(v);
+
+    long long expected = 5;
+    for (long long x : v.data) expected += x;
+    auto identity = [](size_t i, const auto& a) { return a.get_value_by_id(i); };
+    CHECK(custom_parallel_reduce(Range1D(n), identity, 5LL, std::plus<>{}, acc) == expected);
+    CHECK(custom_parallel_reduce(Range1D(n), reproducible_reduce(64), identity, 5LL, std::plus<>{}, acc) == expected);
+
+    // init 不必是单位元：max 从 100 开始
+    auto max_op = [](long long a, long long b) { return a > b ? a : b; };
+    CHECK(custom_parallel_reduce(Range1D(n), identity, 100LL, max_op, acc) == 100);
+    CHECK(custom_parallel_reduce(Range1D(n), identity, -100LL, max_op, acc) == 6);
+
+    // 空空间返回 init；小于通道数的空间
+    CHECK(custom_parallel_reduce(Range1D(0), identity, 42LL, std::plus<>{}, acc) == 42);
+    CHECK(custom_parallel_reduce(Range1D(3), identity, 0LL, std::plus<>{}, acc) == -6 - 5 - 4);
+    std::cout << "Basic reductions test passed!" << std::endl;
+}
+
+void test_dot_product() {
+    const size_t n = 100000;
+    Vec x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x.data[i] = std::sin(static_cast<double>(i));
+        y.data[i] = std::cos(static_cast<double>(i) * 0.5);
+    }
+    ReadAcc xa(x), ya(y);
+    long double ref = 0;
+    for (size_t i = 0; i < n; ++i) ref += static_cast<long double>(x.data[i]) * y.data[i];
+
+    double fast = custom_parallel_reduce(Range1D(n), dot_kernel, 0.0, std::plus<>{}, xa, ya);
+    double repro = custom_parallel_reduce(Range1D(n), reproducible_reduce(), dot_kernel, 0.0, std::plus<>{}, xa, ya);
+    CHECK(std::abs(fast - static_cast<double>(ref)) < 1e-9);
+    CHECK(std::abs(repro - static_cast<double>(ref)) < 1e-9);
+    std::cout << "Dot product test passed!" << std::endl;
+}
+
+void test_reproducible_across_threads() {
+    const size_t n = 123457;
+    Vec x(n);
+    for (size_t i = 0; i < n; ++i) x.data[i] = std::pow(-1.0, static_cast<double>(i)) * std::exp(static_cast<double>(i % 97) * 0.3) / 3.0;
+    ReadAcc xa(x);
+    auto value = [](size_t i, const ReadAcc& a) { return a.get_value_by_id(i); };
+
+    const int saved = omp_get_max_threads();
+    for (bool compensated : {false, true}) {
+        std::vector<double> results;
+        for (int threads : {1, 2, 3, 5, 8}) {
+            omp_set_num_threads(threads);
+            results.push_back(custom_parallel_reduce(Range1D(n), reproducible_reduce(1000, compensated), value, 0.0,
+                                                     std::plus<>{}, xa));
+        }
+        for (double r : results) {
+            if (std::memcmp(&r, &results[0], sizeof(double)) != 0) {
+                std::cerr << "Reproducible reduce differs across thread counts: " << r << " vs " << results[0] << std::endl;
+                CHECK(false);
+            }
+        }
+    }
+    omp_set_num_threads(saved);
+    std::cout << "Reproducible across thread counts test passed!" << std::endl;
+}
+
+void test_compensated_sum() {
+    // 1e16 + 1 + 1 + ... - 1e16：普通求和丢失所有的 1
+    const size_t n = 1002;
+    Vec x(std::vector<double>(n, 1.0));
+    x.data[0] = 1e16;
+    x.data[n - 1] = -1e16;
+    ReadAcc xa(x);
+    auto value = [](size_t i, const ReadAcc& a) { return a.get_value_by_id(i); };
+    double plain = custom_parallel_reduce(Range1D(n), reproducible_reduce(n, false), value, 0.0, std::plus<>{}, xa);
+    double comp = custom_parallel_reduce(Range1D(n), reproducible_reduce(n, true), value, 0.0, std::plus<>{}, xa);
+    CHECK(comp == 1000.0);
+    CHECK(plain != 1000.0);
+    std::cout << "Compensated sum test passed!" << std::endl;
+}
+
+int main() {
+    test_basic_reductions();
+    test_dot_product();
+    test_reproducible_across_threads();
+    test_compensated_sum();
+    return 0;
+}
@@ -0,0 +1,203 @@
+#include <accessor/algorithms/reordering.hpp>
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/permutation.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <accessor/traits/permuted_view_traits.hpp>
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+// 5点差分网格矩阵，编号经随机打乱，模拟非结构网格的列分散
+static CSRMatrix make_shuffled_grid(size_t nx, size_t ny, unsigned seed) {
+    const size_t n = nx * ny;
+    std::vector<size_t> label(n);
+    std::iota(label.begin(), label.end(), size_t{0});
+    std::shuffle(label.begin(), label.end(), std::mt19937(seed));
+    Permutation shuffle(label);
+
+    CSRMatrix grid;
+    grid.row_ptr.push_back(0);
+    for (size_t y = 0; y < ny; ++y) {
+        for (size_t x = 0; x < nx; ++x) {
+            size_t v = y * nx + x;
+            if (y > 0) { grid.col_indices.push_back(v - nx); grid.values.push_back(-1.0f); }
+            if (x > 0) { grid.col_indices.push_back(v - 1); grid.values.push_back(-1.0f); }
+            grid.col_indices.push_back(v); grid.values.push_back(4.0f);
+            if (x + 1 < nx) { grid.col_indices.push_back(v + 1); grid.values.push_back(-1.0f); }
+            if (y + 1 < ny) { grid.col_indices.push_back(v + nx); grid.values.push_back(-1.0f); }
+            grid.row_ptr.push_back(grid.col_indices.size());
+        }
+    }
+    return permute_matrix(grid, shuffle);
+}
+
+static bool is_permutation_of_n(const Permutation& p, size_t n) {
+    if (p.size() != n) return false;
+    std::vector<size_t> sorted = p.new_to_old;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < n; ++i) {
+        if (sorted[i] != i || p.old_to_new[p.new_to_old[i]] != i) return false;
+    }
+    return true;
+}
+
+static void spmv(const CSRMatrix& a, const std::vector<float>& x, std::vector<float>& y) {
+    for (size_t r = 0; r < a.num_rows(); ++r) {
+        float sum = 0.0f;
+        for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) sum += a.values[k] * x[a.col_indices[k]];
+        y[r] = sum;
+    }
+}
+
+void test_permutation_basics() {
+    Permutation p(std::vector<size_t>{2, 0, 3, 1});
+    CHECK((p.old_to_new == std::vector<size_t>{1, 3, 0, 2}));
+    Permutation inv = p.inverse();
+    CHECK(inv.new_to_old == p.old_to_new);
+
+    DenseArray1D<float> x(std::vector<float>{10, 11, 12, 13}), px, back;
+    permute_vector(x, p, px);
+    CHECK((px.data == std::vector<float>{12, 10, 13, 11}));
+    unpermute_vector(px, p, back);
+    CHECK(back.data == x.data);
+
+    // [1 2 0 0]      B = P A P^T
+    // [0 3 0 4]
+    // [5 0 6 0]
+    // [0 0 0 7]
+    CSRMatrix a;
+    a.values = {1, 2, 3, 4, 5, 6, 7};
+    a.col_indices = {0, 1, 1, 3, 0, 2, 3};
+    a.row_ptr = {0, 2, 4, 6, 7};
+    CSRMatrix b = permute_matrix(a, p);
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t k = b.row_ptr[i]; k < b.row_ptr[i + 1]; ++k) {
+            if (k > b.row_ptr[i]) CHECK(b.col_indices[k - 1] < b.col_indices[k]);
+            size_t r = p.new_to_old[i], c = p.new_to_old[b.col_indices[k]];
+            bool found = false;
+            for (size_t j = a.row_ptr[r]; j < a.row_ptr[r + 1]; ++j) {
+                if (a.col_indices[j] == c) { found = true; CHECK(a.values[j] == b.values[k]); }
+            }
+            CHECK(found);
+        }
+    }
+    std::cout << "Permutation basics test passed!" << std::endl;
+}
+
+void test_rcm_reduces_bandwidth() {
+    CSRMatrix a = make_shuffled_grid(30, 20, 3);
+    Permutation rcm = reverse_cuthill_mckee(a);
+    CHECK(is_permutation_of_n(rcm, a.num_rows()));
+
+    CSRMatrix b = permute_matrix(a, rcm);
+    size_t bw_before = matrix_bandwidth(a), bw_after = matrix_bandwidth(b);
+    size_t prof_before = matrix_profile(a), prof_after = matrix_profile(b);
+    CHECK(bw_after <= 2 * 20 && bw_after < bw_before);
+    CHECK(prof_after < prof_before / 4);
+
+    // 结果与线程数无关
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    Permutation serial = reverse_cuthill_mckee(a);
+    omp_set_num_threads(threads);
+    CHECK(serial.new_to_old == rcm.new_to_old);
+
+    // 路径图的RCM带宽为1
+    CSRMatrix path = make_shuffled_grid(50, 1, 9);
+    CHECK(matrix_bandwidth(permute_matrix(path, reverse_cuthill_mckee(path))) == 1);
+
+    std::cout << "RCM bandwidth " << bw_before << " -> " << bw_after
+              << ", profile " << prof_before << " -> " << prof_after << std::endl;
+    std::cout << "RCM test passed!" << std::endl;
+}
+
+void test_rcm_disconnected() {
+    // 两个不相连分量 + 孤立点
+    CSRMatrix a;
+    a.row_ptr = {0, 1, 2, 2, 3, 4};
+    a.col_indices = {1, 0, 4, 3};
+    a.values = {1, 1, 1, 1};
+    Permutation p = reverse_cuthill_mckee(a);
+    CHECK(is_permutation_of_n(p, 5));
+    CHECK(matrix_bandwidth(permute_matrix(a, p)) == 1);
+    std::cout << "RCM disconnected test passed!" << std::endl;
+}
+
+void test_degree_and_hub_sort() {
+    CSRMatrix a;  // 度数: 1, 3, 0, 2
+    a.row_ptr = {0, 1, 4, 4, 6};
+    a.col_indices = {1, 0, 1, 3, 1, 3};
+    a.values.assign(6, 1.0f);
+    CHECK((degree_sort(a).new_to_old == std::vector<size_t>{1, 3, 0, 2}));
+    CHECK((degree_sort(a, false).new_to_old == std::vector<size_t>{2, 0, 3, 1}));
+    // 平均度1.5: hubs = {1(3), 3(2)}，其余保持原顺序
+    CHECK((hub_sort(a).new_to_old == std::vector<size_t>{1, 3, 0, 2}));
+    std::cout << "Degree/hub sort test passed!" << std::endl;
+}
+
+void test_spmv_in_permuted_space() {
+    CSRMatrix a = make_shuffled_grid(16, 12, 5);
+    const size_t n = a.num_rows();
+    Permutation p = reverse_cuthill_mckee(a);
+    CSRMatrix b = permute_matrix(a, p);
+
+    DenseArray1D<float> x(n), y(n);
+    std::vector<float> xv(n), y_ref(n);
+    for (size_t i = 0; i < n; ++i) xv[i] = x[i] = static_cast<float>(i % 13) - 6.0f;
+    spmv(a, xv, y_ref);
+
+    // 内核按新编号遍历B，x/y仍为原编号存储，通过PermutedView透明映射
+    PermutedView<DenseArray1D<float>> x_view(x, p), y_view(y, p);
+    Accessor<CSRMatrix, AccessMode::Read> b_acc(b);
+    Accessor<PermutedView<DenseArray1D<float>>, AccessMode::Read> x_acc(x_view);
+    Accessor<PermutedView<DenseArray1D<float>>, AccessMode::Write> y_acc(y_view);
+    accessor::custom_parallel_for(IterateOver::CSRRows(b),
+        [](size_t row_idx,
+           const Accessor<CSRMatrix, AccessMode::Read>& m,
+           const Accessor<PermutedView<DenseArray1D<float>>, AccessMode::Read>& xa,
+           Accessor<PermutedView<DenseArray1D<float>>, AccessMode::Write>& ya) {
+            auto row = m.get_view(row_idx, GetCSRRowViewTag{});
+            float sum = 0.0f;
+            for (size_t i = 0; i < row.num_non_zeros; ++i) {
+                sum += row.values_ptr[i] * xa.get_value_by_id(row.col_indices_ptr[i]);
+            }
+            ya.set_value_by_id(row_idx, sum);
+        },
+        b_acc, x_acc, y_acc);
+
+    bool valid = true;
+    for (size_t i = 0; i < n; ++i) {
+        if (y[i] != y_ref[i]) {
+            std::cerr << "Permuted SpMV mismatch at " << i << ": " << y[i] << " vs " << y_ref[i] << std::endl;
+            valid = false;
+        }
+    }
+
+    // 反向视图：新编号存储的向量按原编号读取
+    DenseArray1D<float> px;
+    permute_vector(x, p, px);
+    InversePermutedView<DenseArray1D<float>> back(px, p);
+    Accessor<InversePermutedView<DenseArray1D<float>>, AccessMode::Read> back_acc(back);
+    for (size_t i = 0; i < n; ++i) {
+        valid = valid && back_acc.get_value_by_id(i) == x[i];
+    }
+    CHECK(valid);
+    std::cout << "SpMV in permuted space test passed!" << std::endl;
+}
+
+int main() {
+    test_permutation_basics();
+    test_rcm_reduces_bandwidth();
+    test_rcm_disconnected();
+    test_degree_and_hub_sort();
+    test_spmv_in_permuted_space();
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_scan.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+struct SimpleRange {
+    size_t count;
+    size_t size() const { return count; }
+    size_t operator[](size_t idx) const { return idx; }
+};
+
+void test_inclusive_exclusive_scan() {
+    const size_t N = 10001;
+    DenseArray1D<long> in(N), out(N);
+    for (size_t i = 0; i < N; ++i) in[i] = static_cast<long>(i % 17) - 5;
+
+    std::vector<long> expected(N);
+    std::inclusive_scan(in.data.begin(), in.data.end(), expected.begin());
+
+    Accessor<DenseArray1D<long>, AccessMode::Read> in_acc(in);
+    Accessor<DenseArray1D<long>, AccessMode::Write> out_acc(out);
+    long total = custom_parallel_scan(SimpleRange{N}, ScanKind::Inclusive, 0L, std::plus<>{}, in_acc, out_acc);
+    CHECK(out.data == expected);
+    CHECK(total == expected.back());
+
+    std::exclusive_scan(in.data.begin(), in.data.end(), expected.begin(), 100L);
+    total = custom_parallel_scan(SimpleRange{N}, ScanKind::Exclusive, 100L, std::plus<>{}, in_acc, out_acc);
+    CHECK(out.data == expected);
+    CHECK(total == expected.back() + in[N - 1]);
+
+    std::cout << "Inclusive/exclusive scan test passed!" << std::endl;
+}
+
+void test_in_place_scan() {
+    // 由每行非零元个数原地生成 row_ptr
+    std::vector<size_t> row_ptr = {3, 0, 2, 5, 1, 0};
+    Accessor<std::vector<size_t>, AccessMode::Read> r(row_ptr);
+    Accessor<std::vector<size_t>, AccessMode::Write> w(row_ptr);
+    size_t nnz = custom_parallel_scan(SimpleRange{row_ptr.size()}, ScanKind::Exclusive, size_t{0}, std::plus<>{}, r, w);
+    row_ptr.push_back(nnz);
+
+    std::vector<size_t> expected = {0, 3, 3, 5, 10, 11, 11};
+    bool valid = row_ptr == expected;
+    if (valid) {
+        std::cout << "In-place scan test passed!" << std::endl;
+    } else {
+        std::cerr << "In-place scan test failed" << std::endl;
+        std::exit(1);
+    }
+}
+
+void test_non_commutative_scan() {
+    // 仿射变换 x -> a*x + b 的复合满足结合律但不满足交换律
+    struct Affine {
+        long a = 1, b = 0;
+        bool operator==(const Affine&) const = default;
+    };
+    auto compose = [](const Affine& f, const Affine& g) {
+        return Affine{g.a * f.a, g.a * f.b + g.b};
+    };
+
+    const size_t N = 997;
+    std::vector<Affine> in(N), out(N), expected(N);
+    for (size_t i = 0; i < N; ++i) in[i] = Affine{(i % 3 == 0) ? -1L : 1L, static_cast<long>(i % 5)};
+    std::inclusive_scan(in.begin(), in.end(), expected.begin(), compose);
+
+    Accessor<std::vector<Affine>, AccessMode::Read> in_acc(in);
+    Accessor<std::vector<Affine>, AccessMode::Write> out_acc(out);
+    custom_parallel_scan(SimpleRange{N}, ScanKind::Inclusive, Affine{}, compose, in_acc, out_acc);
+
+    if (out == expected) {
+        std::cout << "Non-commutative scan test passed!" << std::endl;
+    } else {
+        std::cerr << "Non-commutative scan test failed" << std::endl;
+        std::exit(1);
+    }
+}
+
+void test_max_scan_over_permutation() {
+    // 迭代空间给出逆序ID，扫描顺序随之改变
+    struct Reversed {
+        size_t count;
+        size_t size() const { return count; }
+        size_t operator[](size_t idx) const { return count - 1 - idx; }
+    };
+    std::vector<int> in = {4, 1, 7, 3, 2, 9, 0, 5};
+    std::vector<int> out(in.size());
+    Accessor<std::vector<int>, AccessMode::Read> in_acc(in);
+    Accessor<std::vector<int>, AccessMode::Write> out_acc(out);
+    auto max_op = [](int a, int b) { return std::max(a, b); };
+    int m = custom_parallel_scan(Reversed{in.size()}, ScanKind::Inclusive, 0, max_op, in_acc, out_acc);
+
+    std::vector<int> expected = {9, 9, 9, 9, 9, 9, 5, 5};
+    CHECK(m == 9);
+    if (out == expected) {
+        std::cout << "Max scan over permutation test passed!" << std::endl;
+    } else {
+        std::cerr << "Max scan over permutation test failed" << std::endl;
+        std::exit(1);
+    }
+}
+
+int main() {
+    test_inclusive_exclusive_scan();
+    test_in_place_scan();
+    test_non_commutative_scan();
+    test_max_scan_over_permutation();
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include <accessor/core/spgemm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<double>;
+
+// 随机稀疏矩阵（含空行），列号有序且不重复
+static Matrix random_matrix(size_t rows, size_t cols, size_t max_per_row, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> col(0, cols - 1), len(0, max_per_row);
+    std::uniform_real_distribution<double> val(-1.0, 1.0);
+    Matrix a;
+    a.row_ptr.push_back(0);
+    for (size_t r = 0; r < rows; ++r) {
+        std::vector<size_t> cs;
+        const size_t k = len(rng);
+        for (size_t i = 0; i < k; ++i) cs.push_back(col(rng));
+        std::sort(cs.begin(), cs.end());
+        cs.erase(std::unique(cs.begin(), cs.end()), cs.end());
+        for (size_t c : cs) {
+            a.col_indices.push_back(c);
+            a.values.push_back(val(rng));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+static std::vector<double> to_dense(const Matrix& a, size_t cols) {
+    std::vector<double> d(a.num_rows() * cols, 0.0);
+    for (size_t r = 0; r < a.num_rows(); ++r)
+        for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) d[r * cols + a.col_indices[k]] += a.values[k];
+    return d;
+}
+
+// 与稠密乘积比较，并检查每行列号严格递增
+static void check_product(const Matrix& c, const Matrix& a, const Matrix& b, size_t inner, size_t cols) {
+    std::vector<double> da = to_dense(a, inner), db = to_dense(b, cols), dc = to_dense(c, cols);
+    CHECK(c.num_rows() == a.num_rows());
+    for (size_t r = 0; r < c.num_rows(); ++r) {
+        for (size_t k = c.row_ptr[r] + 1; k < c.row_ptr[r + 1]; ++k) CHECK(c.col_indices[k - 1] < c.col_indices[k]);
+        for (size_t j = 0; j < cols; ++j) {
+            double ref = 0;
+            for (size_t i = 0; i < inner; ++i) ref += da[r * inner + i] * db[i * cols + j];
+            CHECK(std::abs(dc[r * cols + j] - ref) < 1e-12);
+        }
+    }
+}
+
+void test_spgemm_accumulators() {
+    const size_t m = 60, inner = 45, n = 70;
+    Matrix a = random_matrix(m, inner, 9, 1), b = random_matrix(inner, n, 12, 2);
+    // 最后一列出现在B中，使自动推断的列数为n
+    b.col_indices.back() = n - 1;
+
+    std::vector<Matrix> results;
+    for (SpGEMMAccumulator kind : {SpGEMMAccumulator::Auto, SpGEMMAccumulator::Hash, SpGEMMAccumulator::Dense}) {
+        SpGEMMOptions opts;
+        opts.accumulator = kind;
+        SpGEMMPattern pattern;
+        Matrix c = spgemm(a, b, pattern, opts);
+        CHECK(pattern.num_cols == n && pattern.num_nonzeros() == c.num_nonzeros());
+        if (kind == SpGEMMAccumulator::Hash) CHECK(pattern.dense_rows == 0);
+        if (kind == SpGEMMAccumulator::Dense) CHECK(pattern.dense_rows == m);
+        check_product(c, a, b, inner, n);
+        results.push_back(c);
+    }
+    // 求和顺序与累加器无关：结果逐位相同
+    for (const Matrix& c : results) {
+        CHECK(c.col_indices == results[0].col_indices);
+        CHECK(std::memcmp(c.values.data(), results[0].values.data(), c.values.size() * sizeof(double)) == 0);
+    }
+
+    // 输出列数少时自动模式全用稠密累加器；否则按行的乘法次数选择
+    SpGEMMOptions opts;
+    CHECK(spgemm_symbolic(a, b, n, opts).dense_rows == m);
+    opts.dense_max_columns = 0;
+    opts.dense_row_fraction = 0.5;
+    SpGEMMPattern mixed = spgemm_symbolic(a, b, n, opts);
+    CHECK(mixed.dense_rows > 0 && mixed.dense_rows < m);
+    std::cout << "SpGEMM accumulators test passed!" << std::endl;
+}
+
+void test_spgemm_reuse() {
+    const size_t n = 80;
+    Matrix a = random_matrix(n, n, 8, 3), b = random_matrix(n, n, 8, 4);
+    SpGEMMPattern pattern;
+    Matrix c = spgemm(a, b, pattern);
+
+    // 结构不变、数值改变：只重做数值阶段
+    for (double& v : a.values) v = 2.0 * v + 1.0;
+    for (double& v : b.values) v = -v;
+    const size_t* structure_before = c.col_indices.data();
+    spgemm_numeric(pattern, a, b, c);
+    CHECK(c.col_indices.data() == structure_before);
+    Matrix fresh = spgemm(a, b);
+    CHECK(fresh.row_ptr == c.row_ptr && fresh.col_indices == c.col_indices && fresh.values == c.values);
+    check_product(c, a, b, n, n);
+
+    // 空输出矩阵从模式获得结构
+    Matrix empty;
+    spgemm_numeric(pattern, a, b, empty);
+    CHECK(empty.values == c.values);
+
+    bool threw = false;
+    try {
+        Matrix other = random_matrix(n + 1, n, 4, 5);
+        spgemm_numeric(pattern, other, b, c);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::cout << "SpGEMM reuse test passed!" << std::endl;
+}
+
+static Matrix permutation(size_t n, bool anti_diagonal) {
+    Matrix p;
+    p.row_ptr.push_back(0);
+    for (size_t r = 0; r < n; ++r) {
+        p.col_indices.push_back(anti_diagonal ? n - 1 - r : r);
+        p.values.push_back(static_cast<double>(r + 1));
+        p.row_ptr.push_back(r + 1);
+    }
+    return p;
+}
+
+void test_spgemm_structure_mismatch() {
+    const size_t n = 6;
+    const Matrix eye = permutation(n, false), anti = permutation(n, true);
+    // 尺寸相同但结构不同的输出：结构取自模式
+    Matrix c = spgemm(eye, eye);
+    SpGEMMPattern pattern = spgemm_symbolic(eye, anti);
+    spgemm_numeric(pattern, eye, anti, c);
+    CHECK(c.col_indices == anti.col_indices);
+    check_product(c, eye, anti, n, n);
+
+    // 非零元数改变，或非零元数相同而结构改变：报错而不是越界或死循环
+    for (SpGEMMAccumulator kind : {SpGEMMAccumulator::Hash, SpGEMMAccumulator::Dense}) {
+        SpGEMMOptions opts;
+        opts.accumulator = kind;
+        const SpGEMMPattern p = spgemm_symbolic(eye, eye, n, opts);
+        const Matrix wider = random_matrix(n, n, 4, 11);
+        for (const Matrix* b : {&anti, &wider}) {
+            bool threw = false;
+            try {
+                spgemm_numeric(p, eye, *b, c);
+            } catch (const std::invalid_argument&) {
+                threw = true;
+            }
+            CHECK(threw);
+        }
+    }
+    std::cout << "SpGEMM structure mismatch test passed!" << std::endl;
+}
+
+void test_transpose_and_galerkin() {
+    const size_t n = 50, coarse = 17;
+    Matrix a = random_matrix(n, n, 6, 6);
+    Matrix at = transpose_csr(a, n);
+    std::vector<double> da = to_dense(a, n), dt = to_dense(at, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) CHECK(da[i * n + j] == dt[j * n + i]);
+    Matrix att = transpose_csr(at, n);
+    CHECK(att.row_ptr == a.row_ptr && att.col_indices == a.col_indices && att.values == a.values);
+
+    // A^T A 对称
+    Matrix ata = spgemm(at, a);
+    std::vector<double> d = to_dense(ata, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) CHECK(std::abs(d[i * n + j] - d[j * n + i]) < 1e-12);
+
+    // Galerkin 三重积 P^T A P
+    Matrix p = random_matrix(n, coarse, 2, 7);
+    Matrix ap;
+    SpGEMMPattern ap_pattern = spgemm_symbolic(a, p, coarse);
+    spgemm_numeric(ap_pattern, a, p, ap);
+    Matrix rap = spgemm(transpose_csr(p, coarse), ap);
+    check_product(ap, a, p, n, coarse);
+    std::vector<double> dp = to_dense(p, coarse), dap = to_dense(ap, coarse), drap = to_dense(rap, coarse);
+    for (size_t i = 0; i < rap.num_rows(); ++i) {
+        for (size_t j = 0; j < coarse; ++j) {
+            double ref = 0;
+            for (size_t k = 0; k < n; ++k) ref += dp[k * coarse + i] * dap[k * coarse + j];
+            CHECK(std::abs(drap[i * coarse + j] - ref) < 1e-12);
+        }
+    }
+
+    // 空矩阵
+    Matrix zero;
+    zero.row_ptr.assign(4, 0);
+    Matrix z = spgemm(zero, a);
+    CHECK(z.num_rows() == 3 && z.num_nonzeros() == 0);
+    std::cout << "Transpose and Galerkin product test passed!" << std::endl;
+}
+
+int main() {
+    test_spgemm_accumulators();
+    test_spgemm_reuse();
+    test_spgemm_structure_mismatch();
+    test_transpose_and_galerkin();
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include <accessor/algorithms/spmv_autotune.hpp>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+// 行长度差异很大的随机方阵（少数长行 + 大量短行，含空行）
+static CSRMatrix irregular_matrix(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> col(0, n - 1), hub(0, 19);
+    std::uniform_real_distribution<float> val(-1.0f, 1.0f);
+    CSRMatrix a;
+    a.row_ptr.push_back(0);
+    std::vector<size_t> cs;
+    for (size_t r = 0; r < n; ++r) {
+        const size_t len = hub(rng) == 0 ? n / 4 : r % 5;
+        cs.clear();
+        for (size_t k = 0; k < len; ++k) cs.push_back(col(rng));
+        std::sort(cs.begin(), cs.end());
+        cs.erase(std::unique(cs.begin(), cs.end()), cs.end());
+        for (size_t c : cs) {
+            a.col_indices.push_back(c);
+            a.values.push_back(val(rng));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+static std::vector<double> reference_spmv(const CSRMatrix& a, const std::vector<float>& x) {
+    std::vector<double> y(a.num_rows(), 0.0);
+    for (size_t r = 0; r < a.num_rows(); ++r)
+        for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) y[r] += double(a.values[k]) * x[a.col_indices[k]];
+    return y;
+}
+
+static void check_plan(SpMVPlan& plan, const CSRMatrix& a) {
+    std::vector<float> xs(a.num_rows());
+    for (size_t i = 0; i < xs.size(); ++i) xs[i] = 0.25f * static_cast<float>(i % 7) - 0.5f;
+    DenseArray1D<float> x(xs), y(a.num_rows());
+    plan.apply(x, y);
+    std::vector<double> expected = reference_spmv(a, xs);
+    for (size_t i = 0; i < expected.size(); ++i) CHECK(std::abs(y.data[i] - expected[i]) < 1e-3);
+}
+
+void test_features_and_fingerprint() {
+    // [1 0 2]
+    // [0 0 0]
+    // [3 4 5]
+    CSRMatrix a;
+    a.values = {1, 2, 3, 4, 5};
+    a.col_indices = {0, 2, 0, 1, 2};
+    a.row_ptr = {0, 2, 2, 5};
+    MatrixFeatures f = compute_matrix_features(a);
+    CHECK(f.rows == 3 && f.cols == 3 && f.nonzeros == 5);
+    CHECK(f.max_row_length == 3 && f.empty_rows == 1 && f.bandwidth == 2);
+    CHECK(std::abs(f.mean_row_length - 5.0 / 3.0) < 1e-12);
+    CHECK(std::abs(f.row_length_variance - (13.0 / 3.0 - 25.0 / 9.0)) < 1e-12);
+
+    // 指纹只依赖结构：改数值不变，改结构改变
+    CSRMatrix b = a;
+    b.values[0] = 7;
+    CHECK(matrix_fingerprint(a) == matrix_fingerprint(b));
+    b.col_indices[1] = 1;
+    CHECK(matrix_fingerprint(a) != matrix_fingerprint(b));
+    CSRMatrix big = irregular_matrix(10000, 1);
+    const uint64_t h = matrix_fingerprint(big);
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads(3);
+    CHECK(matrix_fingerprint(big) == h);
+    omp_set_num_threads(threads);
+    std::cout << "Matrix features test passed!" << std::endl;
+}
+
+void test_all_plans_agree() {
+    CSRMatrix a = irregular_matrix(700, 2);
+    using K = ScheduleKind;
+    const SpMVPlanConfig configs[] = {
+        {SpMVLayout::Natural, SpMVKernel::Rows, {K::Static, 0}, 0},
+        {SpMVLayout::Natural, SpMVKernel::Rows, {K::Static, 7}, 0},
+        {SpMVLayout::Natural, SpMVKernel::Rows, {K::Dynamic, 16}, 0},
+        {SpMVLayout::Natural, SpMVKernel::Rows, {K::Guided, 4}, 0},
+        {SpMVLayout::Natural, SpMVKernel::NonzeroSplit, {K::Static, 0}, 0},
+        {SpMVLayout::Natural, SpMVKernel::NonzeroSplit, {K::Dynamic, 1}, 37},
+        {SpMVLayout::ReverseCuthillMcKee, SpMVKernel::Rows, {K::Dynamic, 8}, 0},
+        {SpMVLayout::ReverseCuthillMcKee, SpMVKernel::NonzeroSplit, {K::Static, 0}, 5},
+    };
+    for (const SpMVPlanConfig& c : configs) {
+        SpMVPlan plan(a, c);
+        check_plan(plan, a);
+        SpMVPlan copy = plan;   // 副本共享重排后的矩阵
+        check_plan(copy, a);
+    }
+    SpMVPlan defaulted(a, {SpMVLayout::Natural, SpMVKernel::NonzeroSplit, {}, 0});
+    CHECK(defaulted.config().parts == static_cast<size_t>(omp_get_max_threads()));
+
+    bool threw = false;
+    try {
+        DenseArray1D<float> x(a.num_rows()), y(a.num_rows() - 1);
+        defaulted.apply(x, y);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::cout << "SpMV plan variants test passed!" << std::endl;
+}
+
+void test_tuning_and_cache() {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / ("accessor_spmv_tune_" + std::to_string(::getpid()))).string();
+    CSRMatrix a = irregular_matrix(3000, 3), other = irregular_matrix(3000, 4);
+    SpMVAutotuneOptions opts;
+    opts.trial_runs = 2;
+    opts.cache_path = path;
+    opts.reorder_min_bandwidth = 0;   // 强制尝试重排
+
+    SpMVPlanConfig chosen;
+    {
+        SpMVAutotuner tuner(opts);
+        SpMVPlan plan = tuner.tune(a);
+        CHECK(!tuner.last_from_cache());
+        // 行长度不规则：全部候选 + 重排
+        CHECK(tuner.last_features().row_length_cv() > opts.irregular_row_cv);
+        CHECK(tuner.last_trials().size() == tuner.candidates(tuner.last_features()).size() + 1);
+        CHECK(tuner.last_trials().back().config.layout == SpMVLayout::ReverseCuthillMcKee);
+        double best = tuner.last_trials()[0].seconds;
+        for (const SpMVTrial& t : tuner.last_trials()) best = std::min(best, t.seconds);
+        bool found = false;
+        for (const SpMVTrial& t : tuner.last_trials()) found = found || (t.config == plan.config() && t.seconds == best);
+        CHECK(found);
+        chosen = plan.config();
+        check_plan(plan, a);
+
+        SpMVPlan again = tuner.tune(a);
+        CHECK(tuner.last_from_cache() && tuner.last_trials().empty() && again.config() == chosen);
+    }
+    {
+        // 新进程：从磁盘读取决策，不再试跑
+        SpMVAutotuner tuner(opts);
+        CHECK(tuner.cache_size() == 1);
+        SpMVPlan plan = tuner.tune(a);
+        CHECK(tuner.last_from_cache() && tuner.last_trials().empty() && plan.config() == chosen);
+        check_plan(plan, a);
+        tuner.tune(other);
+        CHECK(!tuner.last_from_cache() && tuner.cache_size() == 2);
+    }
+    {
+        // 坏行被跳过；线程数不同则重新调优
+        std::ofstream out(path, std::ios::app);
+        out << "not a cache line\n0123 4 natural sparkly static 0 0\n";
+        out.close();
+        SpMVAutotuner tuner(opts);
+        CHECK(tuner.cache_size() == 2);
+        const int threads = omp_get_max_threads();
+        omp_set_num_threads(threads + 1);
+        tuner.tune(a);
+        CHECK(!tuner.last_from_cache() && tuner.cache_size() == 3);
+        omp_set_num_threads(threads);
+    }
+
+    // 规则矩阵（三对角）只比较两种调度，带宽小时不重排
+    const size_t n = 2000;
+    CSRMatrix tri;
+    tri.row_ptr.push_back(0);
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t c = r > 0 ? r - 1 : 0; c <= std::min(n - 1, r + 1); ++c) {
+            tri.col_indices.push_back(c);
+            tri.values.push_back(c == r ? 2.0f : -1.0f);
+        }
+        tri.row_ptr.push_back(tri.col_indices.size());
+    }
+    SpMVAutotuner plain;
+    SpMVPlan plan = plain.tune(tri);
+    CHECK(plain.last_trials().size() == 2 && plan.config().layout == SpMVLayout::Natural);
+    check_plan(plan, tri);
+    std::filesystem::remove(path);
+    std::cout << "Autotuner cache test passed!" << std::endl;
+}
+
+int main() {
+    test_features_and_fingerprint();
+    test_all_plans_agree();
+    test_tuning_and_cache();
+    return 0;
+}
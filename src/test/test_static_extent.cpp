@@ -0,0 +1,175 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/static_extent.hpp>
+#include <accessor/iteration/csr_rows.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_fixed_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+using Vec = DenseArray1D<float>;
+using Vec3 = DenseArrayFixed<float, 3>;
+
+static_assert(static_extent_v<IterateOver::StaticRange<5>> == 5);
+static_assert(static_extent_v<const Vec3&> == 3);
+static_assert(!has_static_extent_v<IterateOver::Range1D> && !has_static_extent_v<Vec>);
+static_assert(IterateOver::StaticRange<7>::size() == 7);
+static_assert(DataStructureTraits<Vec3>::get_size_for_iteration(Vec3{}, IterateOverAll_Tag{}) == 3);
+static_assert(sizeof(DenseArrayFixed<double, 4>) == 4 * sizeof(double));
+
+void test_static_range_loop() {
+    // 静态范围在调用线程上展开执行，读写冲突仍然缓冲
+    DenseArrayFixed<int, 8> a;
+    for (size_t i = 0; i < 8; ++i) a[i] = static_cast<int>(i);
+    Accessor<DenseArrayFixed<int, 8>, AccessMode::Read> in(a);
+    Accessor<DenseArrayFixed<int, 8>, AccessMode::Write> out(a);
+    custom_parallel_for(IterateOver::StaticRange<8>{},
+        [](size_t i, const auto& r, auto& w) { w.set_value_by_id(i, r.get_value_by_id((i + 1) % 8) * 10); },
+        in, out);
+    for (size_t i = 0; i < 8; ++i) CHECK(a[i] == static_cast<int>((i + 1) % 8) * 10);
+
+    // 大于展开上限时走普通并行路径
+    constexpr size_t big = ACCESSOR_STATIC_UNROLL_LIMIT + 1;
+    DenseArrayFixed<double, big> b;
+    Accessor<DenseArrayFixed<double, big>, AccessMode::Write> bw(b);
+    custom_parallel_for(IterateOver::StaticRange<big>{}, [](size_t i, auto& w) { w.set_value_by_id(i, 0.5 * i); }, bw);
+    for (size_t i = 0; i < big; ++i) CHECK(b[i] == 0.5 * i);
+
+    size_t sum = 0;
+    static_for<5>([&](auto i) {
+        static_assert(decltype(i)::value < 5);
+        sum += i;
+    });
+    CHECK(sum == 10);
+    std::cout << "Static range loop test passed!" << std::endl;
+}
+
+void test_nested_fixed_kernels() {
+    // 每个元素的3-向量叉积：内层循环为StaticRange<3>，嵌套在外层并行循环中
+    const size_t n = 1000;
+    Vec u(3 * n), v(3 * n), w(3 * n);
+    for (size_t i = 0; i < 3 * n; ++i) {
+        u.data[i] = static_cast<float>(i % 7) - 3;
+        v.data[i] = static_cast<float>(i % 5) + 1;
+    }
+    Accessor<Vec, AccessMode::Read> u_in(u), v_in(v);
+    Accessor<Vec, AccessMode::Write> w_out(w);
+    custom_parallel_for(IterateOver::Range1D(n),
+        [](size_t item, const auto& ua, const auto& va, auto& wa) {
+            auto a = ua.get_view(3 * item, GetDenseArrayStaticBlockViewTag<3>{});
+            auto b = va.get_view(3 * item, GetDenseArrayStaticBlockViewTag<3>{});
+            Vec3 c;
+            Accessor<Vec3, AccessMode::Write> c_out(c);
+            custom_parallel_for(IterateOver::StaticRange<3>{},
+                [&a, &b](size_t k, auto& co) {
+                    const size_t k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+                    co.set_value_by_id(k, a.value(k1) * b.value(k2) - a.value(k2) * b.value(k1));
+                },
+                c_out);
+            static_for<3>([&](auto k) { wa.set_value_by_id(3 * item + k, c[k]); });
+        },
+        u_in, v_in, w_out);
+    for (size_t i = 0; i < n; ++i) {
+        const float* a = &u.data[3 * i];
+        const float* b = &v.data[3 * i];
+        CHECK(w.data[3 * i] == a[1] * b[2] - a[2] * b[1]);
+        CHECK(w.data[3 * i + 1] == a[2] * b[0] - a[0] * b[2]);
+        CHECK(w.data[3 * i + 2] == a[0] * b[1] - a[1] * b[0]);
+    }
+
+    // 定长数组的块视图
+    DenseArrayFixed<float, 6> f;
+    for (size_t i = 0; i < 6; ++i) f[i] = static_cast<float>(i);
+    Accessor<DenseArrayFixed<float, 6>, AccessMode::Read> f_in(f);
+    float tmp[4];
+    f_in.get_view(2, GetDenseArrayStaticBlockViewTag<4>{}).load(tmp);
+    CHECK(tmp[0] == 2 && tmp[3] == 5);
+    CHECK(f_in.get_view(4, GetDenseArrayBlockViewTag{8}).count == 2);
+    std::cout << "Nested fixed-size kernel test passed!" << std::endl;
+}
+
+// Y = A X，X与Y按行存储，每行K列
+template<size_t K>
+static void spmm_fixed(const CSRMatrix& a, const Vec& x, Vec& y) {
+    Accessor<CSRMatrix, AccessMode::Read> mat(a);
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_parallel_for(IterateOver::CSRRows(a),
+        [](size_t row, const auto& m, const auto& xv, auto& yv) {
+            auto view = m.get_view(row, GetCSRRowViewTag{});
+            DenseArrayFixed<float, K> acc;
+            for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                const float value = view.value(k);
+                auto x_row = xv.get_view(view.col_indices_ptr[k] * K, GetDenseArrayStaticBlockViewTag<K>{});
+                static_for<K>([&](auto j) { acc[j] += value * x_row.value(j); });
+            }
+            static_for<K>([&](auto j) { yv.set_value_by_id(row * K + j, acc[j]); });
+        },
+        mat, x_in, y_out);
+}
+
+static void spmm_dynamic(const CSRMatrix& a, const Vec& x, Vec& y, size_t width) {
+    Accessor<CSRMatrix, AccessMode::Read> mat(a);
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_parallel_for(IterateOver::CSRRows(a),
+        [width](size_t row, const auto& m, const auto& xv, auto& yv) {
+            auto view = m.get_view(row, GetCSRRowViewTag{});
+            for (size_t j = 0; j < width; ++j) {
+                float sum = 0;
+                for (size_t k = 0; k < view.num_non_zeros; ++k) {
+                    sum += view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k] * width + j);
+                }
+                yv.set_value_by_id(row * width + j, sum);
+            }
+        },
+        mat, x_in, y_out);
+}
+
+void test_static_dispatch() {
+    const size_t n = 200;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> col(0, n - 1), len(0, 6);
+    CSRMatrix a;
+    a.row_ptr.push_back(0);
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t k = len(rng); k > 0; --k) {
+            a.col_indices.push_back(col(rng));
+            a.values.push_back(static_cast<float>(k));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+
+    for (size_t width : {1, 2, 3, 4, 5, 8, 16}) {
+        Vec x(n * width), y(n * width), expected(n * width);
+        for (size_t i = 0; i < n * width; ++i) x.data[i] = static_cast<float>(i % 11) * 0.25f;
+        spmm_dynamic(a, x, expected, width);
+        const bool fixed = dispatch_common_extent(width,
+            [&](auto k) { spmm_fixed<decltype(k)::value>(a, x, y); return true; },
+            [&](size_t w) { spmm_dynamic(a, x, y, w); return false; });
+        CHECK(fixed == (width != 5));
+        for (size_t i = 0; i < n * width; ++i) CHECK(std::abs(y.data[i] - expected.data[i]) < 1e-4f);
+    }
+
+    size_t seen = 0;
+    dispatch_static_extent<2, 7>(7, [&](auto k) { seen = k; }, [&](size_t) { seen = 0; });
+    CHECK(seen == 7);
+    dispatch_static_extent<2, 7>(3, [&](auto k) { seen = k; }, [&](size_t m) { seen = 100 + m; });
+    CHECK(seen == 103);
+    std::cout << "Static dispatch test passed!" << std::endl;
+}
+
+int main() {
+    test_static_range_loop();
+    test_nested_fixed_kernels();
+    test_static_dispatch();
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/custom_parallel_for.hpp>
+#include <accessor/core/ping_pong.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/iteration/tiled.hpp>
+#include <accessor/traits/dense_array_nd_traits.hpp>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+using IterateOver::TileOrder;
+
+using Grid2D = DenseArray2D<double>;
+using Grid3D = DenseArray3D<double>;
+
+template<typename Space>
+static std::vector<size_t> collect(const Space& space) {
+    std::vector<size_t> ids(space.size());
+    for (size_t i = 0; i < space.size(); ++i) ids[i] = space[i];
+    return ids;
+}
+
+void test_dense_array_nd() {
+    Grid3D g({3, 4, 5}, 1.5);
+    CHECK(g.size() == 60 && g.strides[0] == 20 && g.strides[1] == 5 && g.strides[2] == 1);
+    g(2, 1, 3) = 7.0;
+    CHECK(g[2 * 20 + 1 * 5 + 3] == 7.0);
+    for (size_t i = 0; i < g.size(); ++i) CHECK(g.linear_index(g.coords(i)) == i);
+
+    Accessor<Grid3D, AccessMode::Read> acc(g);
+    CHECK(acc.get_value_by_id(g.linear_index({2, 1, 3})) == 7.0);
+    std::cout << "DenseArrayND test passed!" << std::endl;
+}
+
+void test_tiled_orders() {
+    const std::array<size_t, 2> ext{10, 13}, lo{1, 1}, hi{9, 12}, tile{3, 4};
+    std::vector<size_t> box;
+    for (size_t i = 1; i < 9; ++i)
+        for (size_t j = 1; j < 12; ++j) box.push_back(i * 13 + j);
+
+    for (TileOrder order : {TileOrder::RowMajor, TileOrder::Morton, TileOrder::Wavefront}) {
+        IterateOver::Tiled2D space(ext, lo, hi, tile, order);
+        CHECK(space.size() == box.size() && space.num_tiles() == 9);
+        std::vector<size_t> ids = collect(space);
+        std::sort(ids.begin(), ids.end());
+        CHECK(ids == box);
+    }
+
+    // 行主序：第一个块为 [1,4) x [1,5)，块内按行遍历
+    IterateOver::Tiled2D row_major(ext, lo, hi, tile);
+    CHECK(row_major[0] == 14 && row_major[1] == 15 && row_major[4] == 27 && row_major[12] == 18);
+
+    // Morton：4x4个1x1块的Z序
+    IterateOver::Tiled2D morton({4, 4}, {1, 1}, TileOrder::Morton);
+    CHECK((collect(morton) == std::vector<size_t>{0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15}));
+
+    // 波前：3x4个块共6条反对角线，子空间拼接后等于整个空间
+    IterateOver::Tiled2D wave(ext, lo, hi, tile, TileOrder::Wavefront);
+    CHECK(wave.num_wavefronts() == 5);
+    std::vector<size_t> joined;
+    for (size_t w = 0; w < wave.num_wavefronts(); ++w) {
+        auto part = collect(wave.wavefront(w));
+        joined.insert(joined.end(), part.begin(), part.end());
+    }
+    CHECK(joined == collect(wave));
+    CHECK(wave.wavefront(0).num_tiles() == 1 && wave.wavefront(2).num_tiles() == 3);
+    // 按块迭代：每项是一个块的全部单元，顺序与逐单元迭代一致
+    std::vector<size_t> by_tile;
+    const auto tiles = wave.wavefront(2).tiles();
+    CHECK(tiles.size() == 3);
+    for (size_t t = 0; t < tiles.size(); ++t) {
+        const auto cells = tiles[t];
+        for (size_t k = 0; k < cells.size(); ++k) by_tile.push_back(cells[k]);
+    }
+    CHECK(by_tile == collect(wave.wavefront(2)));
+    std::cout << "Tiled iteration orders test passed!" << std::endl;
+}
+
+void test_stencil_view() {
+    Grid2D g({4, 5});
+    for (size_t i = 0; i < g.size(); ++i) g[i] = static_cast<double>(i);
+    const Stencil<2, 5> star = star_stencil<2>();
+    Accessor<Grid2D, AccessMode::Read> acc(g);
+
+    auto inner = acc.get_view(g.linear_index({1, 2}), GetStencilNeighborhoodTag<2, 5>{&star});
+    CHECK(inner.inside_mask == 0x1f);
+    CHECK(inner.value(0) == 7 && inner.value(1) == 2 && inner.value(2) == 12 && inner.value(3) == 6 && inner.value(4) == 8);
+    CHECK(inner.offset(2)[0] == 1 && inner.offset(2)[1] == 0);
+
+    auto corner = acc.get_view(g.linear_index({0, 4}), GetStencilNeighborhoodTag<2, 5>{&star});
+    CHECK(!corner.in_bounds(1) && corner.in_bounds(2) && corner.in_bounds(3) && !corner.in_bounds(4));
+    CHECK(corner.value(0) == 4 && corner.value(1) == 0.0 && corner.value(2) == 9 && corner.value(3) == 3);
+    std::cout << "Stencil view test passed!" << std::endl;
+}
+
+// 参考实现：逐点Jacobi，边界保持不变
+static Grid2D jacobi_reference(Grid2D g, size_t steps) {
+    Grid2D next = g;
+    const size_t nx = g.extents[0], ny = g.extents[1];
+    for (size_t s = 0; s < steps; ++s) {
+        for (size_t i = 1; i + 1 < nx; ++i)
+            for (size_t j = 1; j + 1 < ny; ++j)
+                next(i, j) = 0.25 * (g(i - 1, j) + g(i + 1, j) + g(i, j - 1) + g(i, j + 1));
+        std::swap(g, next);
+    }
+    return g;
+}
+
+void test_ping_pong_jacobi() {
+    const size_t nx = 37, ny = 29, steps = 6;
+    Grid2D g({nx, ny});
+    for (size_t i = 0; i < g.size(); ++i) g[i] = static_cast<double>((i * 37) % 11);
+    Grid2D expected = jacobi_reference(g, steps);
+
+    const Stencil<2, 5> star = star_stencil<2>();
+    auto kernel = [&star](size_t id, const Accessor<Grid2D, AccessMode::Read>& in,
+                          Accessor<Grid2D, AccessMode::Write>& out) {
+        auto nb = in.get_view(id, GetStencilNeighborhoodTag<2, 5>{&star});
+        out.set_value_by_id(id, 0.25 * (nb.value(1) + nb.value(2) + nb.value(3) + nb.value(4)));
+    };
+    for (TileOrder order : {TileOrder::RowMajor, TileOrder::Morton}) {
+        PingPong<Grid2D> grids(g);
+        IterateOver::Tiled2D interior({nx, ny}, {1, 1}, {nx - 1, ny - 1}, {8, 8}, order);
+        ping_pong_sweeps(interior, grids, steps, kernel);
+        CHECK(grids.current().data == expected.data);
+    }
+
+    // 同一网格的Read/Write accessor触发自动缓冲，结果一致
+    Grid2D single = g;
+    Accessor<Grid2D, AccessMode::Read> in(single);
+    Accessor<Grid2D, AccessMode::Write> out(single);
+    IterateOver::Tiled2D interior({nx, ny}, {1, 1}, {nx - 1, ny - 1}, {8, 8});
+    for (size_t s = 0; s < steps; ++s) custom_parallel_for(interior, kernel, in, out);
+    CHECK(single.data == expected.data);
+    std::cout << "Ping-pong Jacobi test passed!" << std::endl;
+}
+
+void test_tiled_3d_sweep() {
+    const size_t n = 12;
+    Grid3D g({n, n, n});
+    for (size_t i = 0; i < g.size(); ++i) g[i] = static_cast<double>(i % 7);
+    const Stencil<3, 7> star = star_stencil<3>();
+
+    Grid3D expected = g;
+    for (size_t i = 1; i + 1 < n; ++i)
+        for (size_t j = 1; j + 1 < n; ++j)
+            for (size_t k = 1; k + 1 < n; ++k)
+                expected(i, j, k) = g(i - 1, j, k) + g(i + 1, j, k) + g(i, j - 1, k) + g(i, j + 1, k)
+                                  + g(i, j, k - 1) + g(i, j, k + 1) - 6.0 * g(i, j, k);
+
+    PingPong<Grid3D> grids(g);
+    IterateOver::Tiled3D interior({n, n, n}, {1, 1, 1}, {n - 1, n - 1, n - 1}, {4, 3, 5}, TileOrder::Morton);
+    ping_pong_sweeps(interior, grids, 1,
+        [&star](size_t id, const Accessor<Grid3D, AccessMode::Read>& in, Accessor<Grid3D, AccessMode::Write>& out) {
+            auto nb = in.get_view(id, GetStencilNeighborhoodTag<3, 7>{&star});
+            double sum = -6.0 * nb.value(0);
+            for (size_t k = 1; k < nb.size(); ++k) sum += nb.value(k);
+            out.set_value_by_id(id, sum);
+        });
+    CHECK(grids.current().data == expected.data);
+    std::cout << "Tiled 3D sweep test passed!" << std::endl;
+}
+
+void test_wavefront_gauss_seidel() {
+    const size_t nx = 24, ny = 31;
+    Grid2D g({nx, ny});
+    for (size_t i = 0; i < g.size(); ++i) g[i] = static_cast<double>(i % 5);
+    IterateOver::Tiled2D space({nx, ny}, {1, 1}, {nx - 1, ny - 1}, {5, 6}, TileOrder::Wavefront);
+
+    // 串行按同一块顺序原地更新作为参考
+    Grid2D expected = g;
+    for (size_t idx = 0; idx < space.size(); ++idx) {
+        size_t id = space[idx];
+        expected[id] = 0.25 * (expected[id - ny] + expected[id + ny] + expected[id - 1] + expected[id + 1]);
+    }
+
+    // 同一反对角线上的块互不相邻，可按块并行原地更新；块内由一个线程顺序处理
+    Accessor<Grid2D, AccessMode::ReadWrite> acc(g);
+    for (size_t w = 0; w < space.num_wavefronts(); ++w) {
+        custom_parallel_for(space.wavefront(w).tiles(),
+            [ny](const IterateOver::Tiled2D::TileCells& cells, Accessor<Grid2D, AccessMode::ReadWrite>& a) {
+                for (size_t k = 0; k < cells.size(); ++k) {
+                    const size_t id = cells[k];
+                    a.set_value_by_id(id, 0.25 * (a.get_value_by_id(id - ny) + a.get_value_by_id(id + ny)
+                                                + a.get_value_by_id(id - 1) + a.get_value_by_id(id + 1)));
+                }
+            },
+            acc);
+    }
+    CHECK(g.data == expected.data);
+    std::cout << "Wavefront Gauss-Seidel test passed!" << std::endl;
+}
+
+int main() {
+    test_dense_array_nd();
+    test_tiled_orders();
+    test_stencil_view();
+    test_ping_pong_jacobi();
+    test_tiled_3d_sweep();
+    test_wavefront_gauss_seidel();
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include <accessor/core/streaming_csr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+
+using Matrix = CSRMatrixT<double>;
+using Vec = DenseArray1D<double>;
+
+// 随机矩阵，行长度差别很大（含空行），便于检验按非零元分块
+static Matrix random_matrix(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> col(0, n - 1), len(0, 40);
+    std::uniform_real_distribution<double> val(-1.0, 1.0);
+    Matrix a;
+    a.row_ptr.push_back(0);
+    for (size_t r = 0; r < n; ++r) {
+        std::vector<size_t> cols;
+        const size_t k = r % 17 == 0 ? 0 : len(rng);
+        for (size_t i = 0; i < k; ++i) cols.push_back(col(rng));
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        for (size_t c : cols) {
+            a.col_indices.push_back(c);
+            a.values.push_back(val(rng));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+static Vec multiply(const Matrix& a, const Vec& x) {
+    Vec y(a.num_rows());
+    for (size_t r = 0; r < a.num_rows(); ++r)
+        for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) y.data[r] += a.values[k] * x.data[a.col_indices[k]];
+    return y;
+}
+
+static std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / (std::string(name) + "_" + std::to_string(::getpid()))).string();
+}
+
+void test_file_roundtrip() {
+    const std::string path = temp_path("accessor_csr_roundtrip");
+    Matrix a = random_matrix(500, 1);
+    write_csr_file(path, a);
+    Matrix b = read_csr_file<double>(path);
+    CHECK(b.row_ptr == a.row_ptr && b.col_indices == a.col_indices && b.values == a.values);
+
+    // 存储类型不符、文件损坏
+    bool threw = false;
+    try {
+        read_csr_file<float>(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::FILE* f = std::fopen(path.c_str(), "r+b");
+    std::fputc('X', f);
+    std::fclose(f);
+    threw = false;
+    try {
+        StreamingCSRReader<double> reader(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::filesystem::remove(path);
+    std::cout << "CSR file roundtrip test passed!" << std::endl;
+}
+
+void test_streaming_spmv() {
+    const std::string path = temp_path("accessor_csr_stream");
+    const size_t n = 3000;
+    Matrix a = random_matrix(n, 2);
+    write_csr_file(path, a);
+    Vec x(n);
+    for (size_t i = 0; i < n; ++i) x.data[i] = std::cos(static_cast<double>(i));
+    const Vec ref = multiply(a, x);
+
+    for (size_t block_nonzeros : {size_t{1}, size_t{700}, size_t{5000}, size_t{1} << 30}) {
+        for (size_t depth : {1, 2, 3}) {
+            for (bool direct : {false, true}) {
+                StreamingOptions opts;
+                opts.block_nonzeros = block_nonzeros;
+                opts.pipeline_depth = depth;
+                opts.direct_io = direct;
+                StreamingCSRReader<double> reader(path, opts);
+                CHECK(reader.num_rows() == n && reader.num_nonzeros() == a.num_nonzeros());
+                const auto& rows = reader.block_rows();
+                CHECK(rows.front() == 0 && rows.back() == n);
+                for (size_t b = 0; b + 1 < rows.size(); ++b) {
+                    CHECK(rows[b] < rows[b + 1]);
+                    // 多行的块不超过目标非零元数
+                    CHECK(rows[b + 1] - rows[b] == 1 || a.row_ptr[rows[b + 1]] - a.row_ptr[rows[b]] <= block_nonzeros);
+                }
+                // 同一读取器多次遍历，块缓冲复用
+                for (int pass = 0; pass < 2; ++pass) {
+                    Vec y(n);
+                    StreamingStats stats = streaming_spmv(reader, x, y);
+                    CHECK(stats.blocks == reader.num_blocks());
+                    CHECK(stats.bytes_read == a.num_nonzeros() * (sizeof(size_t) + sizeof(double)));
+                    for (size_t i = 0; i < n; ++i) {
+                        if (std::abs(y.data[i] - ref.data[i]) > 1e-12) {
+                            std::cerr << "row " << i << ": " << y.data[i] << " vs " << ref.data[i] << std::endl;
+                            CHECK(false);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::filesystem::remove(path);
+    std::cout << "Streaming SpMV test passed!" << std::endl;
+}
+
+void test_block_order_and_errors() {
+    const std::string path = temp_path("accessor_csr_blocks");
+    Matrix a = random_matrix(1000, 3);
+    write_csr_file(path, a);
+    StreamingOptions opts;
+    opts.block_nonzeros = 1000;
+    opts.pipeline_depth = 3;
+    StreamingCSRReader<double> reader(path, opts);
+
+    // 块按行顺序交付，内容与原矩阵对应行一致
+    size_t expected_row = 0, visited = 0;
+    reader.for_each_block([&](const CSRBlock<double, double>& block) {
+        CHECK(block.index == visited++ && block.first_row == expected_row);
+        for (size_t r = 0; r < block.matrix.num_rows(); ++r) {
+            const size_t g = block.first_row + r;
+            CHECK(block.matrix.row_ptr[r + 1] - block.matrix.row_ptr[r] == a.row_ptr[g + 1] - a.row_ptr[g]);
+            for (size_t k = block.matrix.row_ptr[r]; k < block.matrix.row_ptr[r + 1]; ++k) {
+                const size_t gk = a.row_ptr[g] + k - block.matrix.row_ptr[r];
+                CHECK(block.matrix.col_indices[k] == a.col_indices[gk] && block.matrix.values[k] == a.values[gk]);
+            }
+        }
+        expected_row += block.matrix.num_rows();
+    });
+    CHECK(expected_row == a.num_rows() && visited == reader.num_blocks());
+
+    // 回调抛出异常时加载线程停止，异常传出，读取器仍可继续使用
+    bool threw = false;
+    try {
+        reader.for_each_block([](const CSRBlock<double, double>& block) {
+            if (block.index == 2) throw std::runtime_error("stop");
+        });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    size_t blocks = 0;
+    reader.for_each_block([&](const CSRBlock<double, double>&) { ++blocks; });
+    CHECK(blocks == reader.num_blocks());
+
+    // 文件被截断时读取错误传给调用方
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    threw = false;
+    try {
+        reader.for_each_block([](const CSRBlock<double, double>&) {});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::filesystem::remove(path);
+    std::cout << "Block order and error test passed!" << std::endl;
+}
+
+int main() {
+    test_file_roundtrip();
+    test_streaming_spmv();
+    test_block_order_and_errors();
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include <accessor/core/accessor.hpp>
+#include <accessor/core/csr_matrix.hpp>
+#include <accessor/core/custom_team_parallel_for.hpp>
+#include <accessor/iteration/csr_row_blocks.hpp>
+#include <accessor/iteration/range.hpp>
+#include <accessor/traits/csr_matrix_traits.hpp>
+#include <accessor/traits/dense_array_traits.hpp>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <omp.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "check.hpp"
+
+using namespace accessor;
+using IterateOver::CSRRowBlock;
+
+using Vec = DenseArray1D<double>;
+using Matrix = CSRMatrixT<double>;
+
+static_assert(DeviceIterationSpace<IterateOver::CSRRowBlocks>);
+
+// 幂律分布的行长度：少数行极长，其余很短
+static Matrix skewed_matrix(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> col(0, n - 1);
+    std::uniform_real_distribution<double> val(-1.0, 1.0);
+    Matrix a;
+    a.row_ptr.push_back(0);
+    for (size_t r = 0; r < n; ++r) {
+        const size_t len = r % 97 == 0 ? n / 2 : r % 5;
+        for (size_t k = 0; k < len; ++k) {
+            a.col_indices.push_back(col(rng));
+            a.values.push_back(val(rng));
+        }
+        a.row_ptr.push_back(a.col_indices.size());
+    }
+    return a;
+}
+
+// 长行由整个队伍分摊，短行在队伍成员间分配
+static void team_spmv(const Matrix& a, const Vec& x, Vec& y, const TeamPolicy& policy, size_t target_nnz) {
+    Accessor<Matrix, AccessMode::Read> mat(a);
+    Accessor<Vec, AccessMode::Read> x_in(x);
+    Accessor<Vec, AccessMode::Write> y_out(y);
+    custom_team_parallel_for(policy, IterateOver::CSRRowBlocks(a, target_nnz),
+        [](TeamMember& team, CSRRowBlock block, const auto& m, const auto& xv, auto& yv) {
+            if (block.num_rows() == 1) {
+                auto view = m.get_view(block.begin, GetCSRRowViewTag{});
+                const double sum = team.parallel_reduce(view.num_non_zeros, [&](size_t k) {
+                    return view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+                }, 0.0);
+                team.single([&] { yv.set_value_by_id(block.begin, sum); });
+            } else {
+                team.parallel_for(block.num_rows(), [&](size_t i) {
+                    auto view = m.get_view(block.begin + i, GetCSRRowViewTag{});
+                    yv.set_value_by_id(block.begin + i, team.vector_sum(view.num_non_zeros, [&](size_t k) {
+                        return view.value(k) * xv.get_value_by_id(view.col_indices_ptr[k]);
+                    }, 0.0));
+                });
+            }
+        },
+        mat, x_in, y_out);
+}
+
+void test_row_blocks() {
+    const Matrix a = skewed_matrix(500, 1);
+    const size_t target = 64;
+    IterateOver::CSRRowBlocks blocks(a, target);
+    size_t next = 0;
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        const CSRRowBlock block = blocks[b];
+        CHECK(block.begin == next && block.end > block.begin);
+        const size_t nnz = a.row_ptr[block.end] - a.row_ptr[block.begin];
+        if (block.num_rows() > 1) CHECK(nnz <= target);
+        for (size_t r = block.begin; r < block.end; ++r) {
+            // 长行总是单独成块
+            if (a.row_ptr[r + 1] - a.row_ptr[r] >= target) CHECK(block.num_rows() == 1);
+        }
+        next = block.end;
+    }
+    CHECK(next == a.num_rows());
+    CHECK(IterateOver::CSRRowBlocks(Matrix{}, target).size() == 0);
+    std::cout << "Row block test passed!" << std::endl;
+}
+
+void test_team_spmv() {
+    const int saved_threads = omp_get_max_threads();
+    omp_set_num_threads(6);
+    const size_t n = 2000;
+    const Matrix a = skewed_matrix(n, 2);
+    Vec x(n);
+    for (size_t i = 0; i < n; ++i) x.data[i] = 1.0 + 0.25 * static_cast<double>(i % 7);
+    std::vector<double> expected(n, 0.0);
+    for (size_t r = 0; r < n; ++r)
+        for (size_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) expected[r] += a.values[k] * x.data[a.col_indices[k]];
+
+    for (size_t team_size : {0, 1, 2, 3, 6, 16}) {
+        for (ScheduleKind kind : {ScheduleKind::Static, ScheduleKind::Dynamic}) {
+            Vec y(n);
+            team_spmv(a, x, y, TeamPolicy{team_size, 0, 0, {kind, 2}}, 256);
+            for (size_t i = 0; i < n; ++i) CHECK(std::abs(y.data[i] - expected[i]) < 1e-9);
+        }
+    }
+    omp_set_num_threads(saved_threads);
+    std::cout << "Team SpMV test passed!" << std::endl;
+}
+
+void test_team_reduce_and_barrier() {
+    const int saved_threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    const size_t items = 50;
+    std::vector<long long> sums(items, -1), maxima(items, -1);
+    std::vector<size_t> sizes(items, 0);
+    std::atomic<size_t> calls{0};
+    custom_team_parallel_for(TeamPolicy{4, 0, 0, {ScheduleKind::Dynamic, 3}}, IterateOver::Range1D(items),
+        [&](TeamMember& team, size_t item) {
+            calls.fetch_add(1);
+            CHECK(team.league_rank() == item && team.league_size() == items);
+            // 连续多次归约复用交替的槽位
+            const size_t len = item * 7;
+            const long long s = team.parallel_reduce(len, [](size_t i) { return static_cast<long long>(i); }, 10LL);
+            const long long m = team.parallel_reduce(len, [](size_t i) { return static_cast<long long>(i % 13); },
+                                                     -1LL, [](long long p, long long q) { return std::max(p, q); });
+            const long long again = team.parallel_reduce(len, [](size_t i) { return static_cast<long long>(i); }, 10LL);
+            CHECK(s == again);
+            team.single([&] {
+                sums[item] = s;
+                maxima[item] = m;
+                sizes[item] = team.team_size();
+            });
+        });
+    for (size_t item = 0; item < items; ++item) {
+        const long long len = static_cast<long long>(item * 7);
+        CHECK(sums[item] == 10 + len * (len - 1) / 2);
+        CHECK(maxima[item] == (len == 0 ? -1 : std::min<long long>(12, len - 1)));
+        CHECK(sizes[item] == 4);
+    }
+    // 每个条目被一个队伍的全部成员调用
+    size_t expected_calls = 0;
+    for (size_t s : sizes) expected_calls += s;
+    CHECK(calls.load() == expected_calls);
+    omp_set_num_threads(saved_threads);
+    std::cout << "Team reduce test passed!" << std::endl;
+}
+
+void test_scratch() {
+    const int saved_threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    const size_t items = 40, width = 33;
+    std::vector<double> result(items, 0.0);
+    std::atomic<bool> overflow_missed{false};
+    TeamPolicy policy;
+    policy.team_size = 2;
+    policy.team_scratch_bytes = (width + 1) * sizeof(double);   // int 之后按 double 对齐
+    policy.thread_scratch_bytes = 8 * sizeof(float);
+    custom_team_parallel_for(policy, IterateOver::Range1D(items),
+        [&](TeamMember& team, size_t item) {
+            int* tag = team.team_scratch<int>(1);
+            double* shared = team.team_scratch<double>(width);
+            CHECK(reinterpret_cast<uintptr_t>(shared) % alignof(double) == 0);
+            team.single([&] { *tag = static_cast<int>(item); });
+            team.parallel_for(width, [&](size_t i) { shared[i] = static_cast<double>(item * i); });
+            float* mine = team.thread_scratch<float>(8);
+            for (size_t i = 0; i < 8; ++i) mine[i] = static_cast<float>(team.team_rank());
+            team.team_barrier();
+            // 屏障之后看到其他成员写入的共享暂存
+            CHECK(*tag == static_cast<int>(item));
+            for (size_t i = 0; i < 8; ++i) CHECK(mine[i] == static_cast<float>(team.team_rank()));
+            double total = 0;
+            team.vector_for(width, [&](size_t i) { CHECK(shared[i] == static_cast<double>(item * i)); });
+            for (size_t i = 0; i < width; ++i) total += shared[i];
+            team.team_barrier();   // 下一条目复用暂存前等待所有成员读完
+            team.single([&] { result[item] = total; });
+            // 超出策略大小的请求在任何构建下都会报错
+            try {
+                team.thread_scratch<float>(detail::team_cache_line / sizeof(float));
+                overflow_missed.store(true);
+            } catch (const std::length_error&) {
+            }
+        });
+    for (size_t item = 0; item < items; ++item) CHECK(result[item] == static_cast<double>(item * width * (width - 1) / 2));
+    CHECK(!overflow_missed.load());
+    omp_set_num_threads(saved_threads);
+    std::cout << "Team scratch test passed!" << std::endl;
+}
+
+void test_nested_and_empty() {
+    // 已在并行区内时队伍退化为单线程
+    std::vector<size_t> seen(8, 0);
+    #pragma omp parallel num_threads(2)
+    {
+        #pragma omp single
+        custom_team_parallel_for(TeamPolicy{4}, IterateOver::Range1D(8), [&](TeamMember& team, size_t item) {
+            CHECK(team.team_size() == 1 && team.team_rank() == 0);
+            seen[item] = team.parallel_reduce(3, [](size_t i) { return i + 1; }, size_t{0});
+        });
+    }
+    for (size_t v : seen) CHECK(v == 6);
+    bool called = false;
+    custom_team_parallel_for(TeamPolicy{}, IterateOver::Range1D(0), [&](TeamMember&, size_t) { called = true; });
+    CHECK(!called);
+    std::cout << "Nested team test passed!" << std::endl;
+}
+
+int main() {
+    test_row_blocks();
+    test_team_spmv();
+    test_team_reduce_and_barrier();
+    test_scratch();
+    test_nested_and_empty();
+    return 0;
+}